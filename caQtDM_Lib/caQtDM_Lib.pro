@@ -70,6 +70,11 @@ SOURCES += caqtdm_lib.cpp \
     limitsDialog.cpp \
     sliderDialog.cpp \
     splashscreen.cpp \
+    visibilitytracker.cpp \
+    displaypreloader.cpp \
+    channelmetadata.cpp \
+    widgetbinding.cpp \
+    writepipeline.cpp \
     loadPlugins.cpp
     
 HEADERS += caqtdm_lib.h\
@@ -89,6 +94,11 @@ HEADERS += caqtdm_lib.h\
     limitsCartesianplotDialog.h \
     sliderDialog.h \
     splashscreen.h \
+    visibilitytracker.h \
+    displaypreloader.h \
+    channelmetadata.h \
+    widgetbinding.h \
+    writepipeline.h \
     epicsExternals.h \
     inlines.h \
     loadPlugins.h \
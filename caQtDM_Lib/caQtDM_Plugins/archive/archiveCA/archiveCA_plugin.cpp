@@ -100,7 +100,8 @@ void ArchiveCA_Plugin::Callback_UpdateInterface( QMap<QString, indexes> listOfIn
         } else {
 
             // Get Index name if specified for this widget
-            if(caCartesianPlot* w = qobject_cast<caCartesianPlot *>((QWidget*) indexNew.w)) {
+            QWidget *w = (QWidget *) indexNew.w;
+            if(qobject_cast<caCartesianPlot *>(w) || qobject_cast<caStripPlot *>(w)) {
                 QVariant var = w->property("archiverIndex");
                 if(!var.isNull()) {
                     QString indexName = var.toString();
@@ -36,6 +36,9 @@ HEADERS         = ../../controlsinterface.h \
     archivehttp_plugin.h \
 	httpretrieval.h \
 	../archiverGeneral.h \
+	../archiverIndexes.h \
+	../archiverStripPlot.h \
+	../archiverCache.h \
 	httpperformancedata.h \
     urlhandlerhttp.h \
     workerHttp.h \
@@ -43,6 +46,8 @@ HEADERS         = ../../controlsinterface.h \
 SOURCES         =  archivehttp_plugin.cpp \
     httpretrieval.cpp \
 	../archiverGeneral.cpp \
+	../archiverStripPlot.cpp \
+	../archiverCache.cpp \
     httpperformancedata.cpp \
     urlhandlerhttp.cpp \
     workerHttp.cpp \
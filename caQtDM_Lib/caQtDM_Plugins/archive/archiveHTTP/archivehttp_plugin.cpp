@@ -408,7 +408,14 @@ void ArchiveHTTP_Plugin::handleResults(
             keyStored.replace(".minY", "");
             keyStored.replace(".maxY", "");
             if (keyStored == indexInCheck.key) {
-                if (isActive) {
+                if (tempI.key().startsWith("backfill_")) {
+                    // strip plots take the range of every bin
+                    if (indexNew.nrOfBins > 0) {
+                        m_archiverGeneral->updateStripPlot(valueCount, tempI.value(), XVals, YMinVals, YMaxVals);
+                    } else {
+                        m_archiverGeneral->updateStripPlot(valueCount, tempI.value(), XVals, YVals, YVals);
+                    }
+                } else if (isActive) {
                     // If we have binned data and the channel contains min/max then use the according values.
                     if (tempI.key().contains(".minY") && indexNew.nrOfBins > 0) {
                         updateCartesianAppended(valueCount, tempI.value(), XVals, YMinVals, backend);
@@ -512,7 +519,8 @@ void ArchiveHTTP_Plugin::Callback_UpdateInterface(QMap<QString, indexes> listOfI
         // Get Index name if specified for this widget
         indexNew.nrOfBins = -1;
         indexNew.backend = "";
-        if (caCartesianPlot *w = qobject_cast<caCartesianPlot *>((QWidget *) indexNew.w)) {
+        QWidget *w = (QWidget *) indexNew.w;
+        if (qobject_cast<caCartesianPlot *>(w) || qobject_cast<caStripPlot *>(w)) {
             QVariant var = w->property("nrOfBins");
             if (!var.isNull()) {
                 bool ok;
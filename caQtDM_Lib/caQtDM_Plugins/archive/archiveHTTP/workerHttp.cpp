@@ -32,6 +32,7 @@
 #include <QThread>
 #include <QTimer>
 
+#include "archiverCache.h"
 #include "archiverGeneral.h"
 #include "httpretrieval.h"
 #include "urlhandlerhttp.h"
@@ -97,8 +98,33 @@ void WorkerHTTP::getFromArchive(indexes indexNew,
 
     // Figure out if mutexKnobData already holds data we are about to request.
     // If it does, make sure to update the startSeconds to when our saved data stops.
+    double requestedStartSeconds = startSeconds;
     startSeconds = updateStartSecondsFromMutexKnobData(indexNew.indexX, startSeconds);
 
+    // The cache holds absolute times, so it is only used for time axis data (which is always the case for this plugin).
+    ArchiverCache *cache = ArchiverCache::instance();
+    double binSeconds = (indexNew.nrOfBins > 0) ? (double) indexNew.secondsPast / (double) indexNew.nrOfBins : 0.0;
+    QString cacheKey = ArchiverCache::cacheKey(indexNew.backend, key, binSeconds);
+    bool useCache = cache->isEnabled() && indexNew.timeAxis;
+
+    // If mutexKnobData is still empty (e.g. the display was just opened), serve what the cache holds
+    // and only request the rest, as long as the cache covers the start of the requested range.
+    if (useCache && startSeconds <= requestedStartSeconds) {
+        QList<QPair<double, double> > missing = cache->missingRanges(cacheKey, requestedStartSeconds, endSeconds);
+        if (missing.count() == 1 && missing.first().first > requestedStartSeconds) {
+            QVector<double> cachedT;
+            nbVal = cache->lookup(cacheKey, requestedStartSeconds, missing.first().first, cachedT, m_vecY, m_vecMinY, m_vecMaxY);
+            if (nbVal > 0) {
+                m_vecX.resize(nbVal);
+                for (int i = 0; i < nbVal; i++) {
+                    m_vecX[i] = cachedT.at(i) * 1000;
+                }
+                emit resultReady(indexNew, nbVal, m_vecX, m_vecY, m_vecMinY, m_vecMaxY, indexNew.backend, false);
+                startSeconds = missing.first().first;
+            }
+        }
+    }
+
     do {
         // Clear data
         m_vecX.clear();
@@ -147,6 +173,7 @@ void WorkerHTTP::getFromArchive(indexes indexNew,
             m_httpRetrieval = new HttpRetrieval();
         }
 
+        double requestStartSeconds = startSeconds;
         bool readdata_ok;
         // If the previous retrieval aborted, don't even request.
         // If the bin Count is less than one and we have binned data, don't even request.
@@ -205,6 +232,22 @@ void WorkerHTTP::getFromArchive(indexes indexNew,
                     m_httpRetrieval->getDataAppended(m_vecX, m_vecY);
                 }
             }
+            // Remember what we got, the next open of this channel will only request what comes after it
+            if (useCache && m_isActive) {
+                QVector<double> vecT(m_vecX.count());
+                for (int i = 0; i < m_vecX.count(); i++) {
+                    vecT[i] = m_vecX.at(i) / 1000;
+                }
+                double requestEndSeconds = endSeconds;
+                if (m_httpRetrieval->hasContinueAt()) {
+                    requestEndSeconds = m_httpRetrieval->continueAt().toSecsSinceEpoch();
+                }
+                if (isBinned) {
+                    cache->insert(cacheKey, requestStartSeconds, requestEndSeconds, vecT, m_vecY, m_vecMinY, m_vecMaxY);
+                } else {
+                    cache->insert(cacheKey, requestStartSeconds, requestEndSeconds, vecT, m_vecY);
+                }
+            }
             if (m_httpRetrieval->hasContinueAt()) {
                 // We don't care if it's only a couple of seconds, might as well be transmission delay
                 if (endSeconds - m_httpRetrieval->continueAt().toSecsSinceEpoch() > 30) {
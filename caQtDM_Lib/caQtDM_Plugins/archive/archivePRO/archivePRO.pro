@@ -21,9 +21,9 @@ INCLUDEPATH    += ../../
 INCLUDEPATH    += ../../../src
 INCLUDEPATH    += ../../../../caQtDM_QtControls/src/
 INCLUDEPATH    += $(QWTINCLUDE)
-HEADERS         = ../../controlsinterface.h archivePRO_plugin.h ../archiverCommon.h \
+HEADERS         = ../../controlsinterface.h archivePRO_plugin.h ../archiverCommon.h ../archiverIndexes.h ../archiverStripPlot.h \
     proRetrieval.h
-SOURCES         =  archivePRO_plugin.cpp ../archiverCommon.cpp \
+SOURCES         =  archivePRO_plugin.cpp ../archiverCommon.cpp ../archiverStripPlot.cpp \
     proRetrieval.c
 TARGET          = archivePRO_plugin
 
@@ -32,8 +32,8 @@ android {
    INCLUDEPATH += $(ANDROIDFUNCTIONSINCLUDE)
 }
 
-HEADERS         = ../../controlsinterface.h archiveSF_plugin.h sfRetrieval.h ../archiverCommon.h
-SOURCES         =  archiveSF_plugin.cpp sfRetrieval.cpp ../archiverCommon.cpp
+HEADERS         = ../../controlsinterface.h archiveSF_plugin.h sfRetrieval.h ../archiverCommon.h ../archiverIndexes.h ../archiverStripPlot.h ../archiverCache.h
+SOURCES         =  archiveSF_plugin.cpp sfRetrieval.cpp ../archiverCommon.cpp ../archiverStripPlot.cpp ../archiverCache.cpp
 TARGET          = archiveSF_plugin
 
 
@@ -130,7 +130,8 @@ void ArchiveSF_Plugin::Callback_UpdateInterface( QMap<QString, indexes> listOfIn
             // Get Index name if specified for this widget
             indexNew.nrOfBins = -1;
             indexNew.backend = "";
-            if(caCartesianPlot* w = qobject_cast<caCartesianPlot *>((QWidget*) indexNew.w)) {
+            QWidget *w = (QWidget *) indexNew.w;
+            if(qobject_cast<caCartesianPlot *>(w) || qobject_cast<caStripPlot *>(w)) {
                 QVariant var = w->property("nrOfBins");
                 if(!var.isNull()) {
                     bool ok;
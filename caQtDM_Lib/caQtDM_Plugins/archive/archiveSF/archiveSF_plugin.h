@@ -36,6 +36,7 @@
 #include "controlsinterface.h"
 #include "archiveSF_plugin.h"
 #include "archiverCommon.h"
+#include "archiverCache.h"
 #include "sfRetrieval.h"
 
 
@@ -49,6 +50,7 @@ public:
         qRegisterMetaType<indexes>("indexes");
         qRegisterMetaType<QVector<double> >("QVector<double>");
         fromArchive =  (sfRetrieval *)0;
+        binSeconds = 1;
     }
 
     ~WorkerSF() {
@@ -77,8 +79,6 @@ public slots:
 
         struct timeb now;
         QUrl url = QUrl(index_name);
-        QString fields, agg;
-        bool isBinned;
 
         QString key = indexNew.pv;
         int nbVal = 0;
@@ -86,6 +86,79 @@ public slots:
         ftime(&now);
         double endSeconds = (double) now.time + (double) now.millitm / (double)1000;
         double startSeconds = endSeconds - indexNew.secondsPast;
+
+        // only the parts of the time range not yet in the cache are requested; with the cache every request
+        // asks for bins of the same duration, so that the bins of partial requests have the width of the others
+        ArchiverCache *cache = ArchiverCache::instance();
+        binSeconds = 1;
+        if(indexNew.nrOfBins > 0) binSeconds = qMax(1, qRound((double) indexNew.secondsPast / (double) indexNew.nrOfBins));
+        QString cacheKey = ArchiverCache::cacheKey(indexNew.backend, key, (double) binSeconds);
+        QList<QPair<double, double> > ranges = cache->missingRanges(cacheKey, startSeconds, endSeconds);
+
+        bool readdata_ok = true;
+        backend = indexNew.backend;
+        for(int i = 0; i < ranges.count() && readdata_ok; i++) {
+            readdata_ok = requestRange(url, indexNew, key, ranges.at(i).first, ranges.at(i).second, messageWindow);
+            if(readdata_ok && cache->isEnabled()) {
+                cache->insert(cacheKey, ranges.at(i).first, ranges.at(i).second, TimeN, YValsN, YMinN, YMaxN);
+            }
+        }
+
+        if(readdata_ok) {
+            if(cache->isEnabled()) {
+                nbVal = cache->lookup(cacheKey, startSeconds, endSeconds, TimeN, YValsN, YMinN, YMaxN);
+                TimerN.resize(nbVal);
+                for(int i = 0; i < nbVal; i++) {
+                    if(!indexNew.timeAxis) TimerN[i] = -(endSeconds - TimeN.at(i)) / 3600.0;
+                    else TimerN[i] = TimeN.at(i) * 1000;
+                }
+            } else {
+                nbVal = TimerN.size();
+            }
+        } else {
+            if(messageWindow != (MessageWindow *) Q_NULLPTR) {
+                QString mess("ArchiveSF plugin -- lastError: ");
+                mess.append(fromArchive->lastError());
+                mess.append(" for pv: ");
+                mess.append(key);
+#if QT_VERSION > 0x050000
+                mess=QString(mess.toHtmlEscaped());
+#else
+                mess = (Qt::escape(mess));
+#endif
+                messageWindow->postMsgEvent(QtFatalMsg, (char*) qasc(mess));
+            }
+        }
+
+        //qDebug() << QTime::currentTime().toString() << "number of values received" << nbVal << fromArchive << "for" << key;
+
+        emit resultReady(indexNew, nbVal, TimerN, YValsN, backend);
+
+        mutex->unlock();
+        fromArchive->deleteLater();
+        fromArchive = (sfRetrieval *) Q_NULLPTR;
+    }
+
+signals:
+    void resultReady(indexes indexNew, int nbVal, QVector<double> TimerN, QVector<double> YValsN, QString backend);
+
+public:
+
+private:
+
+    /**
+     * requests the range startSeconds - endSeconds; with the cache the bins are given by their duration
+     */
+    bool requestRange(QUrl &url, indexes &indexNew, const QString &key, double startSeconds, double endSeconds, MessageWindow * messageWindow) {
+        QString fields, agg;
+        bool isBinned;
+
+        TimerN.clear();
+        YValsN.clear();
+        TimeN.clear();
+        YMinN.clear();
+        YMaxN.clear();
+
 #ifdef CSV
         QString response ="'response':{'format':'csv'}";
 #else
@@ -101,7 +174,10 @@ public slots:
         QString range = "'range': { 'startSeconds' : '" + QString::number(startSeconds, 'g', 10) + "', 'endSeconds' : '" + QString::number(endSeconds, 'g', 10) + "'}";
         fields = "'fields':['channel','globalSeconds','value']";
 
-        if(indexNew.nrOfBins != -1) {
+        if(indexNew.nrOfBins != -1 && ArchiverCache::instance()->isEnabled()) {
+            isBinned = true;
+            agg = tr(", 'aggregation': {'aggregationType':'value', 'aggregations':['min','mean','max'], 'durationPerBin' : 'PT%1S'}").arg(binSeconds);
+        } else if(indexNew.nrOfBins != -1) {
             isBinned = true;
             agg = tr(", 'aggregation': {'aggregationType':'value', 'aggregations':['min','mean','max'], 'nrOfBins' : %1}").arg(indexNew.nrOfBins);
         } else {
@@ -113,6 +189,7 @@ public slots:
         total = total.replace("'", "\"");
         QByteArray json_str = total.toUtf8();
 
+        if(fromArchive != (sfRetrieval *) Q_NULLPTR) fromArchive->deleteLater();
         fromArchive = new sfRetrieval();
 
         //qDebug() << "fromArchive pointer=" << fromArchive << indexNew.timeAxis;
@@ -136,43 +213,27 @@ public slots:
         }
 
         if(readdata_ok) {
-            if((nbVal = fromArchive->getCount()) > 0) {
-                //qDebug() << nbVal << total;
+            if(fromArchive->getCount() > 0) {
+                //qDebug() << fromArchive->getCount() << total;
+                fromArchive->getData(TimerN, YValsN);
+                fromArchive->getTimeData(TimeN);
+                fromArchive->getMinMaxData(YMinN, YMaxN);
                 TimerN.resize(fromArchive->getCount());
                 YValsN.resize(fromArchive->getCount());
-                fromArchive->getData(TimerN, YValsN);
-            }
-
-        } else {
-            if(messageWindow != (MessageWindow *) Q_NULLPTR) {
-                QString mess("ArchiveSF plugin -- lastError: ");
-                mess.append(fromArchive->lastError());
-                mess.append(" for pv: ");
-                mess.append(key);
-#if QT_VERSION > 0x050000
-                mess=QString(mess.toHtmlEscaped());
-#else
-                mess = (Qt::escape(mess));
-#endif
-                messageWindow->postMsgEvent(QtFatalMsg, (char*) qasc(mess));
+                TimeN.resize(fromArchive->getCount());
+                YMinN.resize(fromArchive->getCount());
+                YMaxN.resize(fromArchive->getCount());
             }
+            if(fromArchive->getBackend().length() > 0) backend = fromArchive->getBackend();
         }
-
-        //qDebug() << QTime::currentTime().toString() << "number of values received" << nbVal << fromArchive << "for" << key;
-
-        emit resultReady(indexNew, nbVal, TimerN, YValsN, fromArchive->getBackend());
-
-        mutex->unlock();
-        fromArchive->deleteLater();
+        return readdata_ok;
     }
 
-signals:
-    void resultReady(indexes indexNew, int nbVal, QVector<double> TimerN, QVector<double> YValsN, QString backend);
-
-public:
-
-private:
     sfRetrieval *fromArchive;
+    QVector<double> TimeN;
+    QVector<double> YMinN, YMaxN;
+    QString backend;
+    int binSeconds;
 
 };
 
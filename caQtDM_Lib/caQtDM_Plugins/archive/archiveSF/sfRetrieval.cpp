@@ -231,6 +231,9 @@ void sfRetrieval::finishReply(QNetworkReply *reply)
 
     X.resize(result.count()-1);
     Y.resize(result.count()-1);
+    T.resize(result.count()-1);
+    YMin.resize(result.count()-1);
+    YMax.resize(result.count()-1);
 
     bool ok1, ok2;
     for(int i=1; i< result.count(); ++i) {
@@ -245,7 +248,9 @@ void sfRetrieval::finishReply(QNetworkReply *reply)
             if(ok1) {
                 if((seconds - archiveTime) < secndsPast) {
                     X[count] = -(seconds - archiveTime) / 3600.0;
+                    T[count] = archiveTime;
                     Y[count] = line[valueIndex].toDouble(&ok2);
+                    YMin[count] = YMax[count] = Y[count];
                     if(ok2) count++;
                     else {
                         errorString = tr("could not decode value %1 at position %2").arg(line[valueIndex].arg(valueIndex));
@@ -341,6 +346,9 @@ void sfRetrieval::finishReply(QNetworkReply *reply)
                         // set array size
                         X.resize(array.size());
                         Y.resize(array.size());
+                        T.resize(array.size());
+                        YMin.resize(array.size());
+                        YMax.resize(array.size());
 
                         // binned data
                         if(isBinned) {
@@ -348,7 +356,8 @@ void sfRetrieval::finishReply(QNetworkReply *reply)
                             for (unsigned int i = 0; i < array.size(); i++) {
                                 bool valueFound = false;
                                 bool timeFound = false;
-                                double mean;
+                                double mean, minimum = 0.0, maximum = 0.0;
+                                bool minFound = false, maxFound = false;
                                 double archiveTime;
 
                                 // find value part now
@@ -364,6 +373,14 @@ void sfRetrieval::finishReply(QNetworkReply *reply)
                                         mean=root2[L"mean"]->AsNumber();
                                         valueFound = true;
                                     }
+                                    if (root2.find(L"min") != root2.end() && root2[L"min"]->IsNumber()) {
+                                        minimum = root2[L"min"]->AsNumber();
+                                        minFound = true;
+                                    }
+                                    if (root2.find(L"max") != root2.end() && root2[L"max"]->IsNumber()) {
+                                        maximum = root2[L"max"]->AsNumber();
+                                        maxFound = true;
+                                    }
                                     delete value2;
                                 }
 
@@ -382,7 +399,10 @@ void sfRetrieval::finishReply(QNetworkReply *reply)
                                 if(timeFound && valueFound && (seconds - archiveTime) < secndsPast) {
                                     if(!timAxis) X[count] = -(seconds - archiveTime) / 3600.0;
                                     else X[count] = archiveTime * 1000;
+                                    T[count] = archiveTime;
                                     Y[count] = mean;
+                                    YMin[count] = minFound ? minimum : mean;
+                                    YMax[count] = maxFound ? maximum : mean;
                                     //qDebug() << "binned" << X[count] << Y[count];
                                     count++;
                                 }
@@ -432,7 +452,9 @@ void sfRetrieval::finishReply(QNetworkReply *reply)
                                 if(timeFound && valueFound && (seconds - archiveTime) < secndsPast) {
                                     if(!timAxis) X[count] = -(seconds - archiveTime) / 3600.0;
                                     else X[count] = archiveTime *1000;
+                                    T[count] = archiveTime;
                                     Y[count] = mean;
+                                    YMin[count] = YMax[count] = mean;
                                     //qDebug() << "not binned" << X[count] << Y[count];
                                     count++;
                                 }
@@ -491,6 +513,17 @@ void sfRetrieval::getData(QVector<double> &x, QVector<double> &y)
     y = Y;
 }
 
+void sfRetrieval::getTimeData(QVector<double> &t)
+{
+    t = T;
+}
+
+void sfRetrieval::getMinMaxData(QVector<double> &yMin, QVector<double> &yMax)
+{
+    yMin = YMin;
+    yMax = YMax;
+}
+
 const QString sfRetrieval::lastError()
 {
     return errorString;
@@ -50,12 +50,17 @@ public:
     ~sfRetrieval() {
         X.clear();
         Y.clear();
+        T.clear();
+        YMin.clear();
+        YMax.clear();
         //qDebug() << this << "destructor" << PV;
     }
     bool requestUrl(const QUrl url, const QByteArray &json, int secondsPast, bool binned, bool timeAxis, QString key);
     const QString lastError();
     int getCount();
     void getData(QVector<double> &x, QVector<double> &y);
+    void getTimeData(QVector<double> &t);
+    void getMinMaxData(QVector<double> &yMin, QVector<double> &yMax);
     const QString getBackend();
     void cancelDownload();
     void close();
@@ -84,6 +89,8 @@ private:
     QUrl downloadUrl;
     QString errorString;
     QVector<double> X,Y;
+    QVector<double> T;  // absolute archive time in seconds of every point
+    QVector<double> YMin, YMax;  // minimum and maximum of every bin
     int totalCount;
     int secndsPast;
     QEventLoop *eventLoop;
@@ -0,0 +1,531 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+#include <QStandardPaths>
+#else
+#include <QDesktopServices>
+#endif
+#include <algorithm>
+#include <time.h>
+
+#ifndef MOBILE_ANDROID
+#include <sys/timeb.h>
+#else
+#include <androidtimeb.h>
+#endif
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+#include "archiverCache.h"
+
+#define qasc(x) x.toLatin1().constData()
+
+// points are grouped per hour, old buckets are dropped as a whole
+#define CACHE_BUCKET_SECONDS 3600
+// a new range closer than this to the covered range still counts as contiguous
+#define CACHE_SLACK_SECONDS 2.0
+#define CACHE_FILE_MAGIC 0xCA0A2C01
+#define CACHE_FILE_VERSION 1
+// changed entries are written at most this often (ms)
+#define CACHE_WRITE_INTERVAL 5000
+// points kept in memory for all channels together, the least recently used channels are dropped first
+#define CACHE_MAX_POINTS 2000000
+
+// sorts the indexes of received points by their time
+struct timeOrder {
+    const QVector<double> *t;
+    bool operator()(int a, int b) const { return t->at(a) < t->at(b); }
+};
+
+/**
+ * writes the changed entries behind, away from the request path
+ */
+class ArchiverCacheWriter : public QThread
+{
+public:
+    ArchiverCacheWriter(ArchiverCache *cache) : cacheP(cache), stop(false) {}
+
+    void finish() {
+        QMutexLocker locker(&waitMutex);
+        stop = true;
+        condition.wakeOne();
+    }
+
+protected:
+    void run() {
+        bool done = false;
+        while(!done) {
+            waitMutex.lock();
+            if(!stop) condition.wait(&waitMutex, CACHE_WRITE_INTERVAL);
+            done = stop;
+            waitMutex.unlock();
+            cacheP->writePending();
+        }
+    }
+
+private:
+    ArchiverCache *cacheP;
+    QMutex waitMutex;
+    QWaitCondition condition;
+    bool stop;
+};
+
+ArchiverCache *ArchiverCache::instance()
+{
+    static ArchiverCache cache;
+    return &cache;
+}
+
+ArchiverCache::ArchiverCache()
+{
+    writer = (ArchiverCacheWriter *) Q_NULLPTR;
+    useCounter = 0;
+
+    QString enable = (QString) qgetenv("CAQTDM_ARCHIVE_CACHE");
+    enabled = !(enable.toLower() == "false" || enable == "0");
+
+    bool ok;
+    maxAge = ((QString) qgetenv("CAQTDM_ARCHIVE_CACHE_HOURS")).toDouble(&ok) * 3600.0;
+    if(!ok || maxAge <= 0.0) maxAge = 48.0 * 3600.0;
+    maxPoints = ((QString) qgetenv("CAQTDM_ARCHIVE_CACHE_POINTS")).toInt(&ok);
+    if(!ok || maxPoints <= 0) maxPoints = CACHE_MAX_POINTS;
+
+    // by default a directory of the user, so that users do not share (and can not spoil) each other's files
+    cachePath = (QString) qgetenv("CAQTDM_ARCHIVE_CACHE_PATH");
+    if(cachePath.length() == 0) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+        QString location = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+#else
+        QString location = QDesktopServices::storageLocation(QDesktopServices::CacheLocation);
+#endif
+        if(location.length() == 0) location = QDir::homePath() + "/.cache";
+        cachePath = location + "/caQtDM_archive_cache";
+    }
+    if(!enabled) return;
+
+    if(!QDir().mkpath(cachePath)) {
+        printf("caQtDM -- archive cache directory %s could not be created, cache will be kept in memory only\n", qasc(cachePath));
+        cachePath = "";
+        return;
+    }
+    QFile::setPermissions(cachePath, QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner);
+#ifdef Q_OS_UNIX
+    if(QFileInfo(cachePath).ownerId() != (uint) getuid()) {
+        printf("caQtDM -- archive cache directory %s belongs to another user, cache will be kept in memory only\n", qasc(cachePath));
+        cachePath = "";
+    }
+#endif
+}
+
+/**
+ * the entries not yet written are written before we go
+ */
+ArchiverCache::~ArchiverCache()
+{
+    if(writer != (ArchiverCacheWriter *) Q_NULLPTR) {
+        writer->finish();
+        writer->wait();
+        delete writer;
+    }
+}
+
+/**
+ * the binning is part of the key, points with a different bin width must not be mixed
+ */
+QString ArchiverCache::cacheKey(const QString &backend, const QString &channel, double binSeconds)
+{
+    QString binning;
+    if(binSeconds > 0.0) binning = QString::number(binSeconds, 'g', 6);
+    else binning = "raw";
+    return backend + "|" + channel + "|" + binning;
+}
+
+/**
+ * the covered range of an entry is contiguous, so a request may miss a head and a tail part
+ */
+QList<QPair<double, double> > ArchiverCache::missingRanges(const QString &key, double startSeconds, double endSeconds)
+{
+    QList<QPair<double, double> > ranges;
+    if(!enabled) {
+        ranges.append(qMakePair(startSeconds, endSeconds));
+        return ranges;
+    }
+
+    QMutexLocker locker(&mutex);
+    cacheEntry *entry = getEntry(key);
+    if(entry->buckets.isEmpty() || entry->coveredTo < startSeconds || entry->coveredFrom > endSeconds) {
+        ranges.append(qMakePair(startSeconds, endSeconds));
+        return ranges;
+    }
+    if(startSeconds < entry->coveredFrom - CACHE_SLACK_SECONDS) ranges.append(qMakePair(startSeconds, entry->coveredFrom));
+    if(endSeconds > entry->coveredTo) ranges.append(qMakePair(entry->coveredTo, endSeconds));
+    return ranges;
+}
+
+/**
+ * copies the cached points inside the given range, returns their number
+ */
+int ArchiverCache::lookup(const QString &key, double startSeconds, double endSeconds,
+                          QVector<double> &t, QVector<double> &y, QVector<double> &yMin, QVector<double> &yMax)
+{
+    t.clear(); y.clear(); yMin.clear(); yMax.clear();
+    if(!enabled) return 0;
+
+    QMutexLocker locker(&mutex);
+    cacheEntry *entry = getEntry(key);
+    qint64 firstBucket = (qint64) startSeconds / CACHE_BUCKET_SECONDS;
+    QMap<qint64, cacheBucket>::const_iterator it = entry->buckets.lowerBound(firstBucket);
+    for(; it != entry->buckets.constEnd(); ++it) {
+        const cacheBucket &bucket = it.value();
+        for(int i = 0; i < bucket.t.size(); i++) {
+            if(bucket.t.at(i) < startSeconds) continue;
+            if(bucket.t.at(i) > endSeconds) return t.size();
+            t.append(bucket.t.at(i));
+            y.append(bucket.y.at(i));
+            yMin.append(bucket.yMin.at(i));
+            yMax.append(bucket.yMax.at(i));
+        }
+    }
+    return t.size();
+}
+
+/**
+ * stores the result of a request for the range fromSeconds - toSeconds; points already cached inside
+ * this range are replaced. a range not touching the covered range starts a new coverage.
+ * the received points are sorted into buckets and every touched bucket is merged in one pass
+ */
+void ArchiverCache::insert(const QString &key, double fromSeconds, double toSeconds,
+                           const QVector<double> &t, const QVector<double> &y,
+                           const QVector<double> &yMin, const QVector<double> &yMax)
+{
+    if(!enabled) return;
+
+    // the points normally arrive in order, otherwise they are sorted first
+    int count = qMin(t.size(), y.size());
+    QVector<int> order(count);
+    bool sorted = true;
+    for(int i = 0; i < count; i++) {
+        order[i] = i;
+        if(i > 0 && t.at(i) < t.at(i - 1)) sorted = false;
+    }
+    if(!sorted) {
+        timeOrder byTime;
+        byTime.t = &t;
+        std::stable_sort(order.begin(), order.end(), byTime);
+    }
+
+    QMap<qint64, cacheBucket> received;
+    cacheBucket *bucket = (cacheBucket *) Q_NULLPTR;
+    qint64 bucketKey = 0;
+    for(int n = 0; n < count; n++) {
+        int i = order.at(n);
+        qint64 k = (qint64) t.at(i) / CACHE_BUCKET_SECONDS;
+        if(bucket == (cacheBucket *) Q_NULLPTR || k != bucketKey) {
+            bucket = &received[k];
+            bucketKey = k;
+        }
+        bucket->t.append(t.at(i));
+        bucket->y.append(y.at(i));
+        bucket->yMin.append(i < yMin.size() ? yMin.at(i) : y.at(i));
+        bucket->yMax.append(i < yMax.size() ? yMax.at(i) : y.at(i));
+    }
+
+    QMutexLocker locker(&mutex);
+    cacheEntry *entry = getEntry(key);
+
+    if(entry->buckets.isEmpty() || fromSeconds > entry->coveredTo + CACHE_SLACK_SECONDS ||
+       toSeconds < entry->coveredFrom - CACHE_SLACK_SECONDS) {
+        clearEntry(entry);
+        entry->coveredFrom = fromSeconds;
+        entry->coveredTo = toSeconds;
+    } else {
+        if(fromSeconds < entry->coveredFrom) entry->coveredFrom = fromSeconds;
+        if(toSeconds > entry->coveredTo) entry->coveredTo = toSeconds;
+    }
+
+    // the buckets overlapping the range lose the points we get again, the received ones are merged in
+    QList<qint64> keys = received.keys();
+    qint64 firstBucket = (qint64) fromSeconds / CACHE_BUCKET_SECONDS;
+    qint64 lastBucket = (qint64) toSeconds / CACHE_BUCKET_SECONDS;
+    QMap<qint64, cacheBucket>::iterator it = entry->buckets.lowerBound(firstBucket);
+    for(; it != entry->buckets.end() && it.key() <= lastBucket; ++it) {
+        if(!received.contains(it.key())) keys.append(it.key());
+    }
+
+    cacheBucket empty;
+    foreach(qint64 k, keys) {
+        QMap<qint64, cacheBucket>::iterator bt = entry->buckets.find(k);
+        if(bt == entry->buckets.end()) {
+            entry->buckets.insert(k, received.value(k));
+            entry->points += received.value(k).t.size();
+            continue;
+        }
+        int before = bt.value().t.size();
+        QMap<qint64, cacheBucket>::const_iterator rt = received.constFind(k);
+        mergeBucket(bt.value(), fromSeconds, toSeconds, rt != received.constEnd() ? rt.value() : empty);
+        entry->points += bt.value().t.size() - before;
+        if(bt.value().t.isEmpty()) entry->buckets.erase(bt);
+    }
+
+    // the last bin of a binned request is usually incomplete, request it again next time
+    if(count > 0 && t.at(order.last()) > fromSeconds && t.at(order.last()) < entry->coveredTo) entry->coveredTo = t.at(order.last());
+
+    struct timeb now;
+    ftime(&now);
+    trimEntry(entry, (double) now.time);
+
+    // the file is written later by the writer thread
+    if(cachePath.length() > 0) {
+        pendingWrites.insert(key, *entry);
+        if(writer == (ArchiverCacheWriter *) Q_NULLPTR) {
+            writer = new ArchiverCacheWriter(this);
+            writer->start(QThread::LowPriority);
+        }
+    }
+
+    evictEntries(key);
+}
+
+void ArchiverCache::remove(const QString &key)
+{
+    QMutexLocker locker(&mutex);
+    entries.remove(key);
+    pendingWrites.remove(key);
+    if(cachePath.length() > 0) QFile::remove(fileName(key));
+}
+
+/**
+ * returns the entry of a key, loading it the first time it is used from a write still pending or from disk
+ */
+ArchiverCache::cacheEntry *ArchiverCache::getEntry(const QString &key)
+{
+    QMap<QString, cacheEntry>::iterator it = entries.find(key);
+    if(it != entries.end()) {
+        it.value().lastUsed = ++useCounter;
+        return &it.value();
+    }
+
+    cacheEntry entry;
+    if(pendingWrites.contains(key)) {
+        entry = pendingWrites.value(key);
+    } else if(inWrite.contains(key)) {
+        entry = inWrite.value(key);
+    } else {
+        entry.coveredFrom = entry.coveredTo = 0.0;
+        entry.points = 0;
+        if(!loadEntry(key, &entry)) clearEntry(&entry);
+    }
+    entry.lastUsed = ++useCounter;
+    it = entries.insert(key, entry);
+
+    struct timeb now;
+    ftime(&now);
+    trimEntry(&it.value(), (double) now.time);
+    return &it.value();
+}
+
+void ArchiverCache::clearEntry(cacheEntry *entry)
+{
+    entry->buckets.clear();
+    entry->coveredFrom = entry->coveredTo = 0.0;
+    entry->points = 0;
+}
+
+void ArchiverCache::trimEntry(cacheEntry *entry, double now)
+{
+    double oldest = now - maxAge;
+    qint64 oldestBucket = (qint64) oldest / CACHE_BUCKET_SECONDS;
+    while(!entry->buckets.isEmpty() && entry->buckets.begin().key() < oldestBucket) {
+        entry->points -= entry->buckets.begin().value().t.size();
+        entry->buckets.erase(entry->buckets.begin());
+    }
+    if(entry->buckets.isEmpty()) {
+        clearEntry(entry);
+    } else if(entry->coveredFrom < oldestBucket * CACHE_BUCKET_SECONDS) {
+        entry->coveredFrom = oldestBucket * CACHE_BUCKET_SECONDS;
+    }
+}
+
+/**
+ * used when loading, the points of a file are sorted and are therefore appended
+ */
+void ArchiverCache::appendPoint(cacheEntry *entry, double t, double y, double yMin, double yMax)
+{
+    cacheBucket &bucket = entry->buckets[(qint64) t / CACHE_BUCKET_SECONDS];
+
+    int pos = bucket.t.size();
+    while(pos > 0 && bucket.t.at(pos - 1) > t) pos--;
+    bucket.t.insert(pos, t);
+    bucket.y.insert(pos, y);
+    bucket.yMin.insert(pos, yMin);
+    bucket.yMax.insert(pos, yMax);
+    entry->points++;
+}
+
+/**
+ * merges the sorted points of add into the sorted bucket, dropping the points of the bucket inside the range
+ */
+void ArchiverCache::mergeBucket(cacheBucket &bucket, double fromSeconds, double toSeconds, const cacheBucket &add)
+{
+    cacheBucket merged;
+    int size = bucket.t.size() + add.t.size();
+    merged.t.reserve(size);
+    merged.y.reserve(size);
+    merged.yMin.reserve(size);
+    merged.yMax.reserve(size);
+
+    int i = 0, j = 0;
+    while(i < bucket.t.size() || j < add.t.size()) {
+        if(i < bucket.t.size() && bucket.t.at(i) >= fromSeconds && bucket.t.at(i) <= toSeconds) {
+            i++;
+        } else if(j >= add.t.size() || (i < bucket.t.size() && bucket.t.at(i) <= add.t.at(j))) {
+            merged.t.append(bucket.t.at(i));
+            merged.y.append(bucket.y.at(i));
+            merged.yMin.append(bucket.yMin.at(i));
+            merged.yMax.append(bucket.yMax.at(i));
+            i++;
+        } else {
+            merged.t.append(add.t.at(j));
+            merged.y.append(add.y.at(j));
+            merged.yMin.append(add.yMin.at(j));
+            merged.yMax.append(add.yMax.at(j));
+            j++;
+        }
+    }
+    bucket = merged;
+}
+
+/**
+ * drops the least recently used entries while more points than allowed are kept, their pending writes stay
+ */
+void ArchiverCache::evictEntries(const QString &keep)
+{
+    qint64 total = 0;
+    for(QMap<QString, cacheEntry>::const_iterator it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        total += it.value().points;
+    }
+    while(total > maxPoints && entries.size() > 1) {
+        QMap<QString, cacheEntry>::iterator oldest = entries.end();
+        for(QMap<QString, cacheEntry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+            if(it.key() == keep) continue;
+            if(oldest == entries.end() || it.value().lastUsed < oldest.value().lastUsed) oldest = it;
+        }
+        if(oldest == entries.end()) break;
+        total -= oldest.value().points;
+        entries.erase(oldest);
+    }
+}
+
+QString ArchiverCache::fileName(const QString &key)
+{
+    QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Md5).toHex();
+    return cachePath + "/" + QString(hash) + ".cache";
+}
+
+bool ArchiverCache::loadEntry(const QString &key, cacheEntry *entry)
+{
+    if(cachePath.length() == 0) return false;
+
+    QFile file(fileName(key));
+    if(!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    quint32 magic;
+    qint32 version;
+    QString storedKey;
+    QVector<double> t, y, yMin, yMax;
+    in >> magic >> version;
+    if(magic != CACHE_FILE_MAGIC || version != CACHE_FILE_VERSION) return false;
+    in >> storedKey >> entry->coveredFrom >> entry->coveredTo >> t >> y >> yMin >> yMax;
+    if(in.status() != QDataStream::Ok || storedKey != key ||
+       t.size() != y.size() || t.size() != yMin.size() || t.size() != yMax.size()) return false;
+
+    for(int i = 0; i < t.size(); i++) appendPoint(entry, t.at(i), y.at(i), yMin.at(i), yMax.at(i));
+    return true;
+}
+
+/**
+ * called by the writer thread, the files are written without holding the lock of the cache
+ */
+void ArchiverCache::writePending()
+{
+    mutex.lock();
+    inWrite = pendingWrites;
+    pendingWrites.clear();
+    QMap<QString, cacheEntry> writes = inWrite;
+    mutex.unlock();
+
+    for(QMap<QString, cacheEntry>::const_iterator it = writes.constBegin(); it != writes.constEnd(); ++it) {
+        saveEntry(it.key(), it.value());
+    }
+
+    mutex.lock();
+    inWrite.clear();
+    mutex.unlock();
+}
+
+/**
+ * written to a temporary file of this process first, so that a concurrent caQtDM never reads or overwrites a partial file
+ */
+void ArchiverCache::saveEntry(const QString &key, const cacheEntry &entry)
+{
+    QVector<double> t, y, yMin, yMax;
+    t.reserve(entry.points);
+    y.reserve(entry.points);
+    yMin.reserve(entry.points);
+    yMax.reserve(entry.points);
+    for(QMap<qint64, cacheBucket>::const_iterator it = entry.buckets.constBegin(); it != entry.buckets.constEnd(); ++it) {
+        t += it.value().t;
+        y += it.value().y;
+        yMin += it.value().yMin;
+        yMax += it.value().yMax;
+    }
+
+    QString name = fileName(key);
+    QString tmpName = name + "." + QString::number(QCoreApplication::applicationPid()) + ".tmp";
+    QFile file(tmpName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return;
+    QDataStream out(&file);
+    out << (quint32) CACHE_FILE_MAGIC << (qint32) CACHE_FILE_VERSION;
+    out << key << entry.coveredFrom << entry.coveredTo << t << y << yMin << yMax;
+    file.close();
+
+    QFile::remove(name);
+    if(!QFile::rename(tmpName, name)) {
+        QFile::remove(tmpName);
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef ARCHIVERCACHE_H
+#define ARCHIVERCACHE_H
+
+#include <QMap>
+#include <QMutex>
+#include <QPair>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+class ArchiverCacheWriter;
+
+/**
+ * cache of archive results shared by the workers of one archive plugin;
+ * the points of a channel are kept in absolute epoch seconds in time buckets, the covered time range
+ * tells which part of a request can be served locally, so that only the missing head or tail has to be fetched.
+ * changed entries are written behind by a thread to a file in $CAQTDM_ARCHIVE_CACHE_PATH (default a directory
+ * of the user's cache location) so that reopening a display does not refetch the history;
+ * CAQTDM_ARCHIVE_CACHE=false disables the cache, CAQTDM_ARCHIVE_CACHE_HOURS (default 48) gives the age after which
+ * points are dropped, CAQTDM_ARCHIVE_CACHE_POINTS (default 2000000) the number of points kept in memory
+ */
+class ArchiverCache
+{
+public:
+    static ArchiverCache *instance();
+    static QString cacheKey(const QString &backend, const QString &channel, double binSeconds);
+
+    bool isEnabled() const { return enabled; }
+    QList<QPair<double, double> > missingRanges(const QString &key, double startSeconds, double endSeconds);
+    int lookup(const QString &key, double startSeconds, double endSeconds,
+               QVector<double> &t, QVector<double> &y, QVector<double> &yMin, QVector<double> &yMax);
+    void insert(const QString &key, double fromSeconds, double toSeconds,
+                const QVector<double> &t, const QVector<double> &y,
+                const QVector<double> &yMin = QVector<double>(), const QVector<double> &yMax = QVector<double>());
+    void remove(const QString &key);
+
+private:
+    friend class ArchiverCacheWriter;
+
+    ArchiverCache();
+    ~ArchiverCache();
+
+    typedef struct _cacheBucket {
+        QVector<double> t, y, yMin, yMax;
+    } cacheBucket;
+
+    typedef struct _cacheEntry {
+        double coveredFrom;
+        double coveredTo;
+        int points;
+        qint64 lastUsed;
+        QMap<qint64, cacheBucket> buckets;
+    } cacheEntry;
+
+    cacheEntry *getEntry(const QString &key);
+    void clearEntry(cacheEntry *entry);
+    void trimEntry(cacheEntry *entry, double now);
+    void appendPoint(cacheEntry *entry, double t, double y, double yMin, double yMax);
+    void mergeBucket(cacheBucket &bucket, double fromSeconds, double toSeconds, const cacheBucket &add);
+    void evictEntries(const QString &keep);
+    QString fileName(const QString &key);
+    bool loadEntry(const QString &key, cacheEntry *entry);
+    void saveEntry(const QString &key, const cacheEntry &entry);
+    void writePending();
+
+    QMutex mutex;
+    QMap<QString, cacheEntry> entries;
+    QMap<QString, cacheEntry> pendingWrites;   // changed entries not yet written
+    QMap<QString, cacheEntry> inWrite;         // entries the writer is writing now
+    ArchiverCacheWriter *writer;
+    QString cachePath;
+    double maxAge;
+    int maxPoints;
+    qint64 useCounter;
+    bool enabled;
+};
+
+#endif
@@ -23,6 +23,7 @@
  *    anton.mezger@psi.ch
  */
 #include "archiverCommon.h"
+#include "archiverStripPlot.h"
 #include <QApplication>
 #include <QDebug>
 #include <QThread>
@@ -253,6 +254,8 @@ int ArchiverCommon::pvAddMonitor(int index, knobData *kData, int rate, int skip)
             }
         }
 
+    } else if (qobject_cast<caStripPlot *>((QWidget *) kData->dispW)) {
+        ArchiverStripPlot::addMonitor(listOfIndexes, kData, mutexP, false);
     } else {
         QString mess("archivedata can only be used in a cartesianplot");
         if (messagewindowP != (MessageWindow *) Q_NULLPTR) {
@@ -288,6 +291,10 @@ void ArchiverCommon::updateSecondsPast(indexes indexNew, bool original)
 void ArchiverCommon::updateCartesian(
     int nbVal, indexes indexNew, QVector<double> XValsN, QVector<double> YValsN, QString backend)
 {
+    if (indexNew.key.startsWith("backfill_")) {
+        updateStripPlot(nbVal, indexNew, XValsN, YValsN, YValsN);
+        return;
+    }
     QMutexLocker locker(&m_globalMutex);
     //qDebug() << (__FILE__) << ":" << (__LINE__) << "|" << "ArchiverCommon::updateCartesian";
     if (nbVal > 0) {
@@ -338,6 +345,14 @@ void ArchiverCommon::updateCartesian(
     }
 }
 
+// archive data for a strip plot go directly to the widget
+void ArchiverCommon::updateStripPlot(
+    int nbVal, indexes indexNew, QVector<double> XValsN, QVector<double> YMinValsN, QVector<double> YMaxValsN)
+{
+    QMutexLocker locker(&m_globalMutex);
+    ArchiverStripPlot::update(listOfIndexes, mutexknobdataP, nbVal, indexNew, XValsN, YMinValsN, YMaxValsN);
+}
+
 // caQtDM_Lib will call this routine for getting rid of a monitor
 int ArchiverCommon::pvClearMonitor(knobData *kData)
 {
@@ -380,6 +395,11 @@ int ArchiverCommon::pvClearMonitor(knobData *kData)
             }
             emit Signal_AbortOutstandingRequests(key);
         }
+    } else if (qobject_cast<caStripPlot *>((QWidget *) kData->dispW)) {
+        QString backfillKey;
+        if (ArchiverStripPlot::clearMonitor(listOfIndexes, kData, backfillKey)) {
+            emit Signal_AbortOutstandingRequests(backfillKey);
+        }
     }
 
     pvFreeAllocatedData(kData);
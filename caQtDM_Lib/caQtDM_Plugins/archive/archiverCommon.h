@@ -33,26 +33,11 @@
 #include <QTimer>
 #include "MessageWindow.h"
 #include "cacartesianplot.h"
+#include "castripplot.h"
 #include "mutexKnobData.h"
+#include "archiverIndexes.h"
 #include <qwt.h>
 
-struct indexes
-{
-    QString key;
-    int indexX;
-    int indexY;
-    int secondsPast;
-    QString pv;
-    float updateSeconds;
-    struct timeb lastUpdateTime;
-    QWidget *w;
-    int nrOfBins;
-    QMutex *mutexP;
-    bool init;
-    QString backend;
-    int updateSecondsOrig;
-    bool timeAxis;
-};
 #define CHAR_ARRAY_LENGTH 200
 
 class Q_DECL_EXPORT ArchiverCommon : public QObject
@@ -77,6 +62,11 @@ public:
                          QVector<double> XValsN,
                          QVector<double> YValsN,
                          QString backend);
+    void updateStripPlot(int nbVal,
+                         indexes indexNew,
+                         QVector<double> XValsN,
+                         QVector<double> YMinValsN,
+                         QVector<double> YMaxValsN);
     void updateSecondsPast(indexes indexNew, bool original);
     QTimer *timer;
 
@@ -92,6 +82,7 @@ private slots:
     void stopUpdateInterface();
 
 private:
+
     typedef struct
     {
         char Dev[40];
@@ -29,6 +29,7 @@
  */
 
 #include "archiverGeneral.h"
+#include "archiverStripPlot.h"
 #include "QtWidgets/qapplication.h"
 #include <QApplication>
 #include <QDebug>
@@ -261,6 +262,8 @@ int ArchiverGeneral::pvAddMonitor(int index, knobData *kData, int rate, int skip
             }
         }
 
+    } else if (qobject_cast<caStripPlot *>((QWidget *) kData->dispW)) {
+        ArchiverStripPlot::addMonitor(listOfIndexes, kData, mutexP, true);
     } else {
         QString mess("archivedata can only be used in a cartesianplot");
         if (messagewindowP != (MessageWindow *) Q_NULLPTR) {
@@ -296,6 +299,10 @@ void ArchiverGeneral::updateSecondsPast(indexes indexNew, bool original)
 void ArchiverGeneral::updateCartesian(
     int nbVal, indexes indexNew, QVector<double> XValsN, QVector<double> YValsN, QString backend)
 {
+    if (indexNew.key.startsWith("backfill_")) {
+        updateStripPlot(nbVal, indexNew, XValsN, YValsN, YValsN);
+        return;
+    }
     QMutexLocker locker(&m_globalMutex);
     if (nbVal > 0) {
         knobData kData = mutexknobdataP->GetMutexKnobData(indexNew.indexX);
@@ -345,6 +352,14 @@ void ArchiverGeneral::updateCartesian(
     }
 }
 
+// archive data for a strip plot go directly to the widget
+void ArchiverGeneral::updateStripPlot(
+    int nbVal, indexes indexNew, QVector<double> XValsN, QVector<double> YMinValsN, QVector<double> YMaxValsN)
+{
+    QMutexLocker locker(&m_globalMutex);
+    ArchiverStripPlot::update(listOfIndexes, mutexknobdataP, nbVal, indexNew, XValsN, YMinValsN, YMaxValsN);
+}
+
 // caQtDM_Lib will call this routine for getting rid of a monitor
 int ArchiverGeneral::pvClearMonitor(knobData *kData)
 {
@@ -387,6 +402,11 @@ int ArchiverGeneral::pvClearMonitor(knobData *kData)
             }
             emit Signal_AbortOutstandingRequests(key);
         }
+    } else if (qobject_cast<caStripPlot *>((QWidget *) kData->dispW)) {
+        QString backfillKey;
+        if (ArchiverStripPlot::clearMonitor(listOfIndexes, kData, backfillKey)) {
+            emit Signal_AbortOutstandingRequests(backfillKey);
+        }
     }
 
     pvFreeAllocatedData(kData);
@@ -39,26 +39,11 @@
 #include <QTimer>
 #include "MessageWindow.h"
 #include "cacartesianplot.h"
+#include "castripplot.h"
 #include "mutexKnobData.h"
+#include "archiverIndexes.h"
 
 
-struct indexes
-{
-    QString key;
-    int indexX;
-    int indexY;
-    int secondsPast;
-    QString pv;
-    float updateSeconds;
-    struct timeb lastUpdateTime;
-    QWidget *w;
-    int nrOfBins;
-    QMutex *mutexP;
-    bool init;
-    QString backend;
-    int updateSecondsOrig;
-    bool timeAxis;
-};
 #define CHAR_ARRAY_LENGTH 200
 
 class Q_DECL_EXPORT ArchiverGeneral : public QObject
@@ -83,6 +68,11 @@ public:
                          QVector<double> XValsN,
                          QVector<double> YValsN,
                          QString backend);
+    void updateStripPlot(int nbVal,
+                         indexes indexNew,
+                         QVector<double> XValsN,
+                         QVector<double> YMinValsN,
+                         QVector<double> YMaxValsN);
     void updateSecondsPast(indexes indexNew, bool original);
     QTimer *timer;
 
@@ -98,6 +88,7 @@ private slots:
     void stopUpdateInterface();
 
 private:
+
     typedef struct
     {
         char Dev[40];
@@ -0,0 +1,55 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef ARCHIVERINDEXES_H
+#define ARCHIVERINDEXES_H
+
+#include <QString>
+#include <QMutex>
+#include <QWidget>
+#include <sys/timeb.h>
+
+/**
+ * one request of an archive plugin, shared by ArchiverCommon and ArchiverGeneral
+ */
+struct indexes
+{
+    QString key;
+    int indexX;
+    int indexY;
+    int secondsPast;
+    QString pv;
+    float updateSeconds;
+    struct timeb lastUpdateTime;
+    QWidget *w;
+    int nrOfBins;
+    QMutex *mutexP;
+    bool init;
+    QString backend;
+    int updateSecondsOrig;
+    bool timeAxis;
+};
+
+#endif
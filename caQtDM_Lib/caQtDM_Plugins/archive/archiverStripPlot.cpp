@@ -0,0 +1,106 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+#include <QWidget>
+#include <QVariant>
+#include "archiverStripPlot.h"
+
+#define BACKFILL_RETRY 3600 // 1 hour
+
+QString ArchiverStripPlot::backfillKey(knobData *kData)
+{
+    return QString("backfill_%1_%2_%3").arg(kData->specData[1]).arg(kData->pv).arg(reinterpret_cast<quintptr>(kData->dispW), sizeof(void*) * 2, 16, QChar('0'));
+}
+
+/**
+ * request the history of a strip plot curve, retried every hour when nothing came back;
+ * timeAxis tells whether the plugin answers with epoch milliseconds or with hours back from now
+ */
+void ArchiverStripPlot::addMonitor(QMap<QString, indexes> &listOfIndexes, knobData *kData, QMutex *mutexP, bool timeAxis)
+{
+    indexes index;
+    QWidget *w = (QWidget *) kData->dispW;
+
+    bool ok = false;
+    index.secondsPast = w->property("secondsPast").toInt(&ok);
+    if (!ok || index.secondsPast <= 0) {
+        index.secondsPast = 3600;
+    }
+    index.nrOfBins = -1;
+    index.updateSeconds = index.updateSecondsOrig = BACKFILL_RETRY;
+    index.init = true;
+    index.key = backfillKey(kData);
+    index.mutexP = mutexP;
+    index.pv = QString(kData->pv);
+    index.w = w;
+    index.indexX = index.indexY = kData->index;
+    index.timeAxis = timeAxis;
+    index.lastUpdateTime.time = 0;
+    index.lastUpdateTime.millitm = 0;
+    listOfIndexes.insert(index.key, index);
+}
+
+/**
+ * forget the request of a strip plot curve, true with its key when there was one (outstanding requests are to be aborted)
+ */
+bool ArchiverStripPlot::clearMonitor(QMap<QString, indexes> &listOfIndexes, knobData *kData, QString &key)
+{
+    key = backfillKey(kData);
+    return (listOfIndexes.remove(key) > 0);
+}
+
+/**
+ * archive data for a strip plot go directly to the widget in epoch milliseconds, to be called with the mutex of the list held
+ */
+void ArchiverStripPlot::update(QMap<QString, indexes> &listOfIndexes, MutexKnobData *mutexknobdataP, int nbVal, const indexes &indexNew,
+                               QVector<double> XValsN, QVector<double> YMinValsN, QVector<double> YMaxValsN)
+{
+    if (nbVal <= 0 || !listOfIndexes.contains(indexNew.key)) {
+        return;
+    }
+    knobData kData = mutexknobdataP->GetMutexKnobData(indexNew.indexX);
+    if (kData.index == -1 || kData.dispW == (void *) Q_NULLPTR) {
+        return;
+    }
+
+    XValsN.resize(nbVal);
+    YMinValsN.resize(nbVal);
+    YMaxValsN.resize(nbVal);
+    if (!indexNew.timeAxis) {
+        struct timeb now;
+        ftime(&now);
+        double endSeconds = (double) now.time + (double) now.millitm / (double) 1000;
+        for (int i = 0; i < nbVal; i++) {
+            XValsN[i] = (endSeconds + XValsN[i] * 3600.0) * 1000.0;
+        }
+    }
+    QMetaObject::invokeMethod((QObject *) kData.dispW, "archiveData", Qt::QueuedConnection,
+                              Q_ARG(int, kData.specData[1]),
+                              Q_ARG(QVector<double>, XValsN),
+                              Q_ARG(QVector<double>, YMinValsN),
+                              Q_ARG(QVector<double>, YMaxValsN));
+
+    // done, no periodic update for this one
+    listOfIndexes.remove(indexNew.key);
+}
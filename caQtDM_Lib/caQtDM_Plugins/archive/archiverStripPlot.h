@@ -0,0 +1,50 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef ARCHIVERSTRIPPLOT_H
+#define ARCHIVERSTRIPPLOT_H
+
+#include <QMap>
+#include <QVector>
+#include "archiverIndexes.h"
+#include "mutexKnobData.h"
+
+/**
+ * backfill of a caStripPlot from an archive, the same for ArchiverCommon and ArchiverGeneral: a strip plot asks once
+ * for the part of its history it did not see itself, the answer goes directly to the widget
+ */
+class ArchiverStripPlot
+{
+public:
+    static void addMonitor(QMap<QString, indexes> &listOfIndexes, knobData *kData, QMutex *mutexP, bool timeAxis);
+    static bool clearMonitor(QMap<QString, indexes> &listOfIndexes, knobData *kData, QString &key);
+    static void update(QMap<QString, indexes> &listOfIndexes, MutexKnobData *mutexknobdataP, int nbVal, const indexes &indexNew,
+                       QVector<double> XValsN, QVector<double> YMinValsN, QVector<double> YMaxValsN);
+
+private:
+    static QString backfillKey(knobData *kData);
+};
+
+#endif
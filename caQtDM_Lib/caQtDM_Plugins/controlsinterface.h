@@ -73,6 +73,17 @@ public:
     virtual int pvDisconnect(knobData *kData) = 0;
     virtual int FlushIO() = 0;
     virtual int TerminateIO() = 0;
+
+    // while deferred, puts are only queued until FlushIO
+    virtual void pvDeferFlush(bool defer) {
+        Q_UNUSED(defer);
+    }
+
+    // put confirmed later through MutexKnobData::PutCompleted with its token, false when not supported by the plugin
+    virtual bool pvSetValueAsync(knobData *kData, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType, int token) {
+        Q_UNUSED(kData); Q_UNUSED(rdata); Q_UNUSED(idata); Q_UNUSED(sdata); Q_UNUSED(object);  Q_UNUSED(errmess); Q_UNUSED(forceType); Q_UNUSED(token);
+        return false;
+    }
 };
 
 QT_BEGIN_NAMESPACE
@@ -129,6 +129,16 @@ int Epics3Plugin::pvSetValue(char *pv, double rdata, int32_t idata, char *sdata,
     return EpicsSetValue(pv, rdata, idata, sdata, object, errmess, forceType);
 }
 
+bool Epics3Plugin::pvSetValueAsync(knobData *kData, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType, int token) {
+
+    // only a connected channel of a display confirms its puts
+    if (!kData->edata.connected || kData->edata.info == (void *) Q_NULLPTR) return false;
+    chid ch = ((connectInfo *) kData->edata.info)->ch;
+    if (!ch) return false;
+    EpicsSetValueAsync_Connected(ch, kData->pv, rdata, idata, sdata, object, errmess, forceType, token);
+    return true;
+}
+
 int Epics3Plugin::pvSetWave(char *pv, float *fdata, double *ddata, int16_t *data16, int32_t *data32, char *sdata, int nelm, char *object, char *errmess) {
     //qDebug() << "Epics3Plugin:pvSetWave";
 
@@ -215,6 +225,10 @@ int Epics3Plugin::FlushIO() {
     return true;
 }
 
+void Epics3Plugin::pvDeferFlush(bool defer) {
+    EpicsDeferFlush(defer);
+}
+
 int Epics3Plugin::TerminateIO() {
     //qDebug() << "Epics3Plugin:TerminateIO";
     TerminateDeviceIO();
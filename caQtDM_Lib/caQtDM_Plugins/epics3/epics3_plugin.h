@@ -48,6 +48,7 @@ public:
     int pvClearMonitor(knobData *kData);
     int pvFreeAllocatedData(knobData *kData);
     int pvSetValue(char *pv, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType);
+    bool pvSetValueAsync(knobData *kData, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType, int token);
     int pvSetWave(char *pv, float *fdata, double *ddata, int16_t *data16, int32_t *data32, char *sdata, int nelm, char *object, char *errmess);
     int pvGetTimeStamp(char *pv, char *timestamp);
     int pvGetDescription(char *pv, char *description);
@@ -57,6 +58,7 @@ public:
     int pvDisconnect(knobData *kData);
     int FlushIO();
     int TerminateIO();
+    void pvDeferFlush(bool defer);
 
 
   private:
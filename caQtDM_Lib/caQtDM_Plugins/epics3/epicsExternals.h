@@ -39,6 +39,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 int EpicsSetValue_Connected(chid ch,char *pv, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType);
+int EpicsSetValueAsync_Connected(chid ch, char *pv, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType, int token);
 int EpicsSetValue(char *pv, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType);
 int EpicsSetWave_Connected(chid ch,char *pv, float *fdata, double *ddata, int16_t *data16, int32_t *data32, char *sdata, int nelm, char *object, char *errmess);
 int EpicsSetWave(char *pv, float *fdata, double *ddata, int16_t *data16, int32_t *data32, char *sdata, int nelm, char *object, char *errmess);
@@ -50,6 +51,7 @@ void addEvent(void * ptr);
 void EpicsReconnect(knobData *kData);
 void EpicsDisconnect(knobData *kData);
 void EpicsFlushIO();
+void EpicsDeferFlush(int defer);
 void DestroyContext();
 void PrepareDeviceIO();
 void TerminateDeviceIO();
@@ -71,6 +71,8 @@ extern MutexKnobData* mutexKnobdataPtr;
 extern MessageWindow *messageWindowPtr;
 
 static int firstTime = true;
+static int deferFlush = false;
+static int putToken = 0;
 
 typedef struct _connectInfo {
     int connected;
@@ -111,17 +113,19 @@ char* myLimitedString (char * strng) {
     kData.edata.lower_warning_limit = (double) stsF->lower_warning_limit; \
     kData.edata.upper_warning_limit = (double) stsF->upper_warning_limit; }
 
-#define AssignEpicsValue(valx, vali, countx) { \
-    kData.edata.actTime = now; \
-    kData.edata.rvalue = valx; \
-    kData.edata.ivalue = vali; \
-    kData.edata.severity = stsF->severity; \
-    kData.edata.status = stsF->status; \
-    kData.edata.accessW = ca_write_access(args.chid); \
-    kData.edata.accessR = ca_read_access(args.chid); \
-    kData.edata.valueCount = countx; \
-    strcpy(kData.edata.fec, myLimitedString((char*) ca_host_name(args.chid))); \
-    kData.edata.monitorCount = info->event; }
+#define AssignValueFields(target, valx, vali, countx) { \
+    target.actTime = now; \
+    target.rvalue = valx; \
+    target.ivalue = vali; \
+    target.severity = stsF->severity; \
+    target.status = stsF->status; \
+    target.accessW = ca_write_access(args.chid); \
+    target.accessR = ca_read_access(args.chid); \
+    target.valueCount = countx; \
+    strcpy(target.fec, myLimitedString((char*) ca_host_name(args.chid))); \
+    target.monitorCount = info->event; }
+
+#define AssignEpicsValue(valx, vali, countx) AssignValueFields(kData.edata, valx, vali, countx)
 
 #define EpicsPut_ErrorMessage_ClearChannel_Return  \
     C_postMsgEvent(messageWindowPtr, 1, vaPrintf("put pv (%s) %s\n", pv, ca_message (status))); \
@@ -238,17 +242,19 @@ void PrepareDeviceIO(void)
 
 static void access_rights_handler(struct access_rights_handler_args args)
 {
-    knobData kData;
+    knobValue kValue;
     connectInfo *info;
     PrepareDeviceIO();
 
     info = (connectInfo *) ca_puser(args.chid);
-    C_GetMutexKnobData(mutexKnobdataPtr, info->index, &kData);
-    kData.edata.accessW = ca_write_access(args.chid);
-    kData.edata.accessR = ca_read_access(args.chid);
-    kData.edata.monitorCount = info->event;
-    C_SetMutexKnobDataReceived(mutexKnobdataPtr, &kData);
-    //printf("access rights callback %d %d %d\n",  kData.edata.accessW, kData.edata.accessR, kData.edata.monitorCount);
+    C_GetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
+    if(kValue.index == -1) return;
+    kValue.accessW = ca_write_access(args.chid);
+    kValue.accessR = ca_read_access(args.chid);
+    kValue.monitorCount = info->event;
+    C_SetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
+    C_ReleaseMutexKnobDataValue(mutexKnobdataPtr, info->index);
+    //printf("access rights callback %d %d %d\n",  kValue.accessW, kValue.accessR, kValue.monitorCount);
     return;
 }
 
@@ -258,24 +264,24 @@ static void access_rights_handler(struct access_rights_handler_args args)
 
 static void dataCallback(struct event_handler_args args)
 {
-    knobData kData;
+    knobValue kValue;
     struct timeb now;
 
     connectInfo *info = (connectInfo *) ca_puser(args.chid);
     if(info == (connectInfo *) 0) return;
 
-    C_GetMutexKnobData(mutexKnobdataPtr, info->index, &kData);
-    if(kData.index == -1) return;
+    C_GetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
+    if(kValue.index == -1) return;
 
     if (args.status != ECA_NORMAL) {
         PRINT(printf("dataCallback:  get: %s for %s\n", ca_name(args.chid), ca_message_text[CA_EXTRACT_MSG_NO(args.status)]));
     } else {
-        kData.edata.monitorCount = info->event;
-        kData.edata.connected = info->connected;
-        kData.edata.fieldtype = ca_field_type(args.chid);
+        kValue.monitorCount = info->event;
+        kValue.connected = info->connected;
+        kValue.fieldtype = ca_field_type(args.chid);
         ftime(&now);
 
-        C_DataLock(mutexKnobdataPtr, &kData);
+        C_DataLockValue(mutexKnobdataPtr, &kValue);
 
         switch (ca_field_type(args.chid)) {
 
@@ -291,19 +297,19 @@ static void dataCallback(struct event_handler_args args)
                          stsF->status, (int) args.count, dbr_size_n(args.type, args.count)));
 
             dataSize = dbr_size_n(args.type, args.count) + sizeof(char);
-            if(dataSize != kData.edata.dataSize) {
-               if(kData.edata.dataB != (void*) Q_NULLPTR) free(kData.edata.dataB);
-                kData.edata.dataB = (void*) malloc((size_t) dataSize);
-                kData.edata.dataSize = dataSize;
+            if(dataSize != kValue.dataSize) {
+               if(kValue.dataB != (void*) Q_NULLPTR) free(kValue.dataB);
+                kValue.dataB = (void*) malloc((size_t) dataSize);
+                kValue.dataSize = dataSize;
             }
 
-            ptr = (char*) kData.edata.dataB;
+            ptr = (char*) kValue.dataB;
             memcpy(ptr, val_ptr, args.count *sizeof(char));
             ptr[args.count] = '\0';
 
-            AssignEpicsValue((double) stsF->value, (long) stsF->value, args.count);
+            AssignValueFields(kValue, (double) stsF->value, (long) stsF->value, args.count);
 
-            C_SetMutexKnobDataReceived(mutexKnobdataPtr, &kData);
+            C_SetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
         }
         break;
 
@@ -321,13 +327,13 @@ static void dataCallback(struct event_handler_args args)
 
             // concatenate strings separated with ';'
             dataSize = dbr_size_n(args.type, args.count) + (args.count+1) * sizeof(char);
-            if(dataSize != kData.edata.dataSize) {
-                if(kData.edata.dataB != (void*) Q_NULLPTR) free(kData.edata.dataB);
-                kData.edata.dataB = (void*) malloc((size_t) dataSize);
-                kData.edata.dataSize = dataSize;
+            if(dataSize != kValue.dataSize) {
+                if(kValue.dataB != (void*) Q_NULLPTR) free(kValue.dataB);
+                kValue.dataB = (void*) malloc((size_t) dataSize);
+                kValue.dataSize = dataSize;
             }
 
-            ptr = (char*) kData.edata.dataB;
+            ptr = (char*) kValue.dataB;
             ptr[0] = '\0';
             len = 0;
             strcpy(ptr, myLimitedString(val_ptr[0]));
@@ -337,9 +343,9 @@ static void dataCallback(struct event_handler_args args)
                 strcat(&ptr[len], myLimitedString(val_ptr[i]));
             }
 
-            AssignEpicsValue((double) 0, (long) stsF->value, args.count);
+            AssignValueFields(kValue, (double) 0, (long) stsF->value, args.count);
 
-            C_SetMutexKnobDataReceived(mutexKnobdataPtr, &kData);
+            C_SetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
         }
         break;
 
@@ -351,9 +357,9 @@ static void dataCallback(struct event_handler_args args)
                          stsF->value, info->index, ca_host_name(args.chid),
                          stsF->status, (int) args.count, dbr_size_n(args.type, args.count)));
 
-            AssignEpicsValue((double) stsF->value, (long) stsF->value, args.count);
+            AssignValueFields(kValue, (double) stsF->value, (long) stsF->value, args.count);
 
-            C_SetMutexKnobDataReceived(mutexKnobdataPtr, &kData);
+            C_SetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
         }
         break;
 
@@ -365,18 +371,18 @@ static void dataCallback(struct event_handler_args args)
                          stsF->value, info->index, ca_host_name(args.chid),
                          stsF->status, (int) args.count, dbr_size_n(args.type, args.count)));
 
-            AssignEpicsValue((double) stsF->value, (long) stsF->value, args.count);
+            AssignValueFields(kValue, (double) stsF->value, (long) stsF->value, args.count);
 
             if(args.count > 1) {
-                if((int) (args.count * sizeof(int16_t)) != kData.edata.dataSize) {
-                    if(kData.edata.dataB != (void*) Q_NULLPTR) free(kData.edata.dataB);
-                    kData.edata.dataB = (void*) malloc(args.count * sizeof(int16_t));
-                    kData.edata.dataSize = args.count * (int) sizeof(int16_t);
+                if((int) (args.count * sizeof(int16_t)) != kValue.dataSize) {
+                    if(kValue.dataB != (void*) Q_NULLPTR) free(kValue.dataB);
+                    kValue.dataB = (void*) malloc(args.count * sizeof(int16_t));
+                    kValue.dataSize = args.count * (int) sizeof(int16_t);
                 }
-                memcpy(kData.edata.dataB, &stsF->value, args.count * sizeof(int16_t));
+                memcpy(kValue.dataB, &stsF->value, args.count * sizeof(int16_t));
             }
 
-            C_SetMutexKnobDataReceived(mutexKnobdataPtr, &kData);
+            C_SetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
         }
         break;
 
@@ -388,18 +394,18 @@ static void dataCallback(struct event_handler_args args)
                          stsF->value, info->index, ca_host_name(args.chid),
                          stsF->status, (int) args.count, dbr_size_n(args.type, args.count)));
 
-            AssignEpicsValue((double) stsF->value, (long) stsF->value, args.count);
+            AssignValueFields(kValue, (double) stsF->value, (long) stsF->value, args.count);
 
             if(args.count > 1) {
-                if((int) (args.count * sizeof(int32_t)) != kData.edata.dataSize) {
-                    if(kData.edata.dataB != (void*) Q_NULLPTR) free(kData.edata.dataB);
-                    kData.edata.dataB = (void*) malloc(args.count * sizeof(int32_t));
-                    kData.edata.dataSize = args.count * (int) sizeof(int32_t);
+                if((int) (args.count * sizeof(int32_t)) != kValue.dataSize) {
+                    if(kValue.dataB != (void*) Q_NULLPTR) free(kValue.dataB);
+                    kValue.dataB = (void*) malloc(args.count * sizeof(int32_t));
+                    kValue.dataSize = args.count * (int) sizeof(int32_t);
                 }
-                memcpy(kData.edata.dataB, &stsF->value, args.count * sizeof(int32_t));
+                memcpy(kValue.dataB, &stsF->value, args.count * sizeof(int32_t));
             }
 
-            C_SetMutexKnobDataReceived(mutexKnobdataPtr, &kData);
+            C_SetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
         }
         break;
 
@@ -411,17 +417,17 @@ static void dataCallback(struct event_handler_args args)
                          stsF->value, info->index, ca_host_name(args.chid),
                          stsF->status, (int) args.count, dbr_size_n(args.type, args.count)));
 
-            AssignEpicsValue((double) stsF->value, (long) stsF->value, args.count);
+            AssignValueFields(kValue, (double) stsF->value, (long) stsF->value, args.count);
 
             if(args.count > 1) {
-                if((int) (args.count * sizeof(float)) != kData.edata.dataSize) {
-                    if(kData.edata.dataB != (void*) Q_NULLPTR) free(kData.edata.dataB);
-                    kData.edata.dataB = (void*) malloc(args.count * sizeof(float));
-                    kData.edata.dataSize = args.count * (int) sizeof(float);
+                if((int) (args.count * sizeof(float)) != kValue.dataSize) {
+                    if(kValue.dataB != (void*) Q_NULLPTR) free(kValue.dataB);
+                    kValue.dataB = (void*) malloc(args.count * sizeof(float));
+                    kValue.dataSize = args.count * (int) sizeof(float);
                 }
-                memcpy(kData.edata.dataB, &stsF->value, args.count * sizeof(float));
+                memcpy(kValue.dataB, &stsF->value, args.count * sizeof(float));
             }
-            C_SetMutexKnobDataReceived(mutexKnobdataPtr, &kData);
+            C_SetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
         }
         break;
 
@@ -433,18 +439,18 @@ static void dataCallback(struct event_handler_args args)
                          stsF->value, info->index, ca_host_name(args.chid),
                          stsF->status, (int) args.count, dbr_size_n(args.type, args.count)));
 
-            AssignEpicsValue((double) stsF->value, (long) stsF->value, args.count);
+            AssignValueFields(kValue, (double) stsF->value, (long) stsF->value, args.count);
 
             if(args.count > 1) {
-                if((int) (args.count * sizeof(double)) != kData.edata.dataSize) {
-                    if(kData.edata.dataB != (void*) Q_NULLPTR) free(kData.edata.dataB);
-                    kData.edata.dataB = (void*) malloc(args.count * sizeof(double));
-                    memcpy(kData.edata.dataB, &stsF->value, args.count * sizeof(double));
-                    kData.edata.dataSize = args.count * (int) sizeof(double);
+                if((int) (args.count * sizeof(double)) != kValue.dataSize) {
+                    if(kValue.dataB != (void*) Q_NULLPTR) free(kValue.dataB);
+                    kValue.dataB = (void*) malloc(args.count * sizeof(double));
+                    memcpy(kValue.dataB, &stsF->value, args.count * sizeof(double));
+                    kValue.dataSize = args.count * (int) sizeof(double);
                 }
-                memcpy(kData.edata.dataB, &stsF->value, args.count * sizeof(double));
+                memcpy(kValue.dataB, &stsF->value, args.count * sizeof(double));
             }
-            C_SetMutexKnobDataReceived(mutexKnobdataPtr, &kData);
+            C_SetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
 
         }
         break;
@@ -454,9 +460,12 @@ static void dataCallback(struct event_handler_args args)
 
         } // end switch
 
-        C_DataUnlock(mutexKnobdataPtr, &kData);
+        C_DataUnlockValue(mutexKnobdataPtr, &kValue);
         info->event++;
     }
+
+    // from now on the slot may be reclaimed
+    C_ReleaseMutexKnobDataValue(mutexKnobdataPtr, info->index);
 }
 
 static void displayCallback(struct event_handler_args args) {
@@ -726,15 +735,15 @@ void addEvent(void * ptr)
         if(info->event < 2) return;  // a first normal addevent must be done
         if(!info->evAdded) {
 
-            knobData kData;
+            knobValue kValue;
             int status;
 
             PrepareDeviceIO();
 
-            C_GetMutexKnobData(mutexKnobdataPtr, info->index, &kData);
-            if(kData.index == -1) return;
+            C_GetMutexKnobDataValue(mutexKnobdataPtr, info->index, &kValue);
+            if(kValue.index == -1) return;
 
-            C_DataLock(mutexKnobdataPtr, &kData);
+            C_DataLockValue(mutexKnobdataPtr, &kValue);
             PRINT(printf("addEvent -- %s %d %d %d %d\n", info->pv, info->evID, info->index, info->connected, info->evAdded));
             status = ca_add_array_event(dbf_type_to_DBR_STS(ca_field_type(info->ch)), 0,
                                         info->ch, dataCallback, info, 0.0,0.0,0.0, &info->evID);
@@ -743,9 +752,9 @@ void addEvent(void * ptr)
             if (status != ECA_NORMAL) {
                 PRINT(printf("ca_add_array_event:\n"" %s\n", ca_message_text[CA_EXTRACT_MSG_NO(status)]));
             }
-            C_SetMutexKnobData(mutexKnobdataPtr, kData.index, kData);
 
-            C_DataUnlock(mutexKnobdataPtr, &kData);
+            C_DataUnlockValue(mutexKnobdataPtr, &kValue);
+            C_ReleaseMutexKnobDataValue(mutexKnobdataPtr, info->index);
         }
     }
 }
@@ -1012,6 +1021,20 @@ void DestroyContext()
     ca_context_destroy();
 }
 
+/**
+ * a put confirmed by the server, the write pipeline of the display gets the token back
+ */
+static void putCallback(struct event_handler_args args)
+{
+    C_PutCompleted(mutexKnobdataPtr, (int) (intptr_t) args.usr, args.status == ECA_NORMAL);
+}
+
+static int EpicsArrayPut(chtype type, unsigned long count, chid ch, const void *data)
+{
+    if(putToken != 0) return ca_array_put_callback(type, count, ch, data, putCallback, (void *) (intptr_t) putToken);
+    return ca_array_put(type, count, ch, data);
+}
+
 int EpicsSetValue_Connected(chid ch,char *pv, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType)
 {
     chtype   chType;
@@ -1037,7 +1060,7 @@ int EpicsSetValue_Connected(chid ch,char *pv, double rdata, int32_t idata, char
     case DBF_STRING:
     case DBF_ENUM:
         PRINT(printf("Epicsput string for <%s> with data=%s\n", pv, sdata));
-        status = ca_put(DBR_STRING, ch, sdata);
+        status = EpicsArrayPut(DBR_STRING, 1, ch, sdata);
         if (status != ECA_NORMAL) {
             EpicsPut_ErrorMessage_ClearChannel_Return;
         }
@@ -1045,7 +1068,7 @@ int EpicsSetValue_Connected(chid ch,char *pv, double rdata, int32_t idata, char
 
     case DBF_INT:
         PRINT(printf("Epicsput int for <%s> with data=%d\n", pv, (int) idata));
-        status = ca_put(DBR_INT, ch, &idata);
+        status = EpicsArrayPut(DBR_INT, 1, ch, &idata);
         if (status != ECA_NORMAL) {
              EpicsPut_ErrorMessage_ClearChannel_Return;
         }
@@ -1053,7 +1076,7 @@ int EpicsSetValue_Connected(chid ch,char *pv, double rdata, int32_t idata, char
 
     case DBF_LONG:
         PRINT(printf("Epicsput long for <%s> with data=%d\n", pv, (int) idata));
-        status = ca_put(DBR_LONG, ch, &idata);
+        status = EpicsArrayPut(DBR_LONG, 1, ch, &idata);
         if (status != ECA_NORMAL) {
              EpicsPut_ErrorMessage_ClearChannel_Return;
         }
@@ -1062,7 +1085,7 @@ int EpicsSetValue_Connected(chid ch,char *pv, double rdata, int32_t idata, char
     case DBF_DOUBLE:
     case DBF_FLOAT:
         PRINT(printf("put double/float for <%s> with data=%f chid=%p\n", pv, rdata, ch));
-        status = ca_put(DBR_DOUBLE, ch, &rdata);
+        status = EpicsArrayPut(DBR_DOUBLE, 1, ch, &rdata);
         if (status != ECA_NORMAL) {
              EpicsPut_ErrorMessage_ClearChannel_Return;
         }
@@ -1070,7 +1093,7 @@ int EpicsSetValue_Connected(chid ch,char *pv, double rdata, int32_t idata, char
 
     case DBF_CHAR:
         PRINT(printf("put char array for <%s> with <%s>\n", pv, sdata));
-        status = ca_array_put(DBR_CHAR, strlen(sdata)+1, ch, sdata);
+        status = EpicsArrayPut(DBR_CHAR, strlen(sdata)+1, ch, sdata);
         if (status != ECA_NORMAL) {
              EpicsPut_ErrorMessage_ClearChannel_Return;
         }
@@ -1081,6 +1104,10 @@ int EpicsSetValue_Connected(chid ch,char *pv, double rdata, int32_t idata, char
 
     }
 
+    // queued for the flush of the batch or confirmed later by putCallback, the monitor will show what was written
+    if(putToken != 0 && !deferFlush) ca_flush_io();
+    if(deferFlush || putToken != 0) return ECA_NORMAL;
+
     status = ca_pend_io(CA_TIMEOUT);
     if (status != ECA_NORMAL) {
          EpicsPut_ErrorMessage_ClearChannel_Return;
@@ -1170,10 +1197,27 @@ int EpicsSetValue_Connected(chid ch,char *pv, double rdata, int32_t idata, char
     return ECA_NORMAL;
 
 }
+
+/**
+ * like EpicsSetValue_Connected, but the put is confirmed with its token when the server has processed it
+ */
+int EpicsSetValueAsync_Connected(chid ch, char *pv, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType, int token)
+{
+    int status;
+
+    putToken = token;
+    status = EpicsSetValue_Connected(ch, pv, rdata, idata, sdata, object, errmess, forceType);
+    putToken = 0;
+
+    // the put did not go out, there will be no callback
+    if(status != ECA_NORMAL) C_PutCompleted(mutexKnobdataPtr, token, false);
+    return status;
+}
+
 int EpicsSetValue(char *pv, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType)
 {
     chid     ch;
-    int status;
+    int status, defer;
 
     UNUSED(errmess);
     UNUSED(object);
@@ -1199,7 +1243,11 @@ int EpicsSetValue(char *pv, double rdata, int32_t idata, char *sdata, char *obje
         return status;
     }
 
+    // the channel is cleared right after, the put can not wait for a flush
+    defer = deferFlush;
+    deferFlush = false;
     EpicsSetValue_Connected(ch, pv, rdata, idata, sdata, object, errmess, forceType);
+    deferFlush = defer;
 
     status = ca_clear_channel(ch);
 
@@ -1326,6 +1374,14 @@ void EpicsFlushIO()
     ca_flush_io();
 }
 
+/**
+ * puts of a batch are only queued and go out together with EpicsFlushIO
+ */
+void EpicsDeferFlush(int defer)
+{
+    deferFlush = defer;
+}
+
 /**
  * exit handler, stop data acquisition
  */
@@ -165,6 +165,7 @@ private:
     PVAChannelPtr pvaChannel;
     bool gotFirstConnection;
     bool putFinished;
+    int putToken;
     bool unlistenCalled;
     bool monitorStarted;
     CreateRequest::shared_pointer createRequest;
@@ -264,7 +265,7 @@ public:
     void getScalarData(PVStructurePtr const & pvStructure);
     void getEnumData(PVStructurePtr const & pvStructure);
     void getScalarArrayData(PVStructurePtr const & pvStructure);
-    bool setValue(double rdata, int32_t idata, char *sdata, int forceType);
+    bool setValue(double rdata, int32_t idata, char *sdata, int forceType, int token = 0);
     bool setArrayValue(
             float *fdata, double *ddata,
             int16_t *data16, int32_t *data32,
@@ -632,6 +633,7 @@ PVAInterface::PVAInterface(
     : pvaChannel(pvaChannel),
       gotFirstConnection(false),
       putFinished(true),
+      putToken(0),
       unlistenCalled(false),
       monitorStarted(false),
       createRequest(CreateRequest::create()),
@@ -896,13 +898,19 @@ void PVAInterface::putDone(
         ChannelPut::shared_pointer const & channelPut)
 {
     Q_UNUSED(channelPut);
+    int token;
     if(!status.isOK()) {
         requester->message(pvaChannel->getFullName() + " " + status.getMessage(),errorMessage);
-        return;
     }
-    Lock lock(mutex);
-    putFinished = true;
+    {
+        Lock lock(mutex);
+        putFinished = true;
+        token = putToken;
+        putToken = 0;
+    }
     if(Epics4Plugin::getDebug()) cout << "PVAInterface::putDone set putFinished = true\n";
+    // an asynchronous put is confirmed to the write pipeline of the display
+    if(token != 0) mutexKnobData->PutCompleted(token, status.isOK());
 }
 
 
@@ -1470,7 +1478,7 @@ void PVAInterface::getScalarArrayData(PVStructurePtr const & pvStructure)
     }
 }
 
-bool PVAInterface::setValue(double rdata, int32_t idata, char *sdata, int forceType)
+bool PVAInterface::setValue(double rdata, int32_t idata, char *sdata, int forceType, int token)
 {
     if(!pvaChannel->getChannel()->isConnected()) {
         string mess("channel ");
@@ -1500,6 +1508,7 @@ bool PVAInterface::setValue(double rdata, int32_t idata, char *sdata, int forceT
             return false;
         }
         putFinished = false;
+        putToken = token;
     }
     size_t index = putPVStructure->getStructure()->getFieldIndex("value");
     putBitSet->set(index);
@@ -1524,7 +1533,9 @@ bool PVAInterface::setValue(double rdata, int32_t idata, char *sdata, int forceT
             pvaChannelPut->put(putPVStructure,putBitSet);
             return true;
         }
+        Lock lock(mutex);
         putFinished = true;
+        putToken = 0;
         return false;
     }
 
@@ -1876,6 +1887,21 @@ bool Epics4Plugin::pvSetValue(knobData *kData,
     return pvaInterface->setValue(rdata,idata,sdata,forceType);
 }
 
+bool Epics4Plugin::pvSetValueAsync(knobData *kData,
+                                   double rdata, int32_t idata,
+                                   char *sdata, char *object, char *errmess, int forceType, int token)
+{
+    Q_UNUSED(object);
+    Q_UNUSED(errmess);
+    if(Epics4Plugin::getDebug()) cout << "Epics4Plugin:pvSetValueAsync\n";
+    if (kData->edata.info == (void *) Q_NULLPTR) return false;
+    PVAInterfaceGlue *pvaInterfaceGlue  = static_cast<PVAInterfaceGlue *>(kData->edata.info);
+    PVAInterfacePtr pvaInterface = pvaInterfaceGlue->getPVAInterface();
+    if(!pvaInterface) return false;
+    // putDone confirms the put, a put not started is written again by pvSetValue
+    return pvaInterface->setValue(rdata,idata,sdata,forceType,token);
+}
+
 bool Epics4Plugin::pvSetWave(knobData *kData,
                              float *fdata, double *ddata,
                              int16_t *data16, int32_t *data32, char *sdata, int nelm,
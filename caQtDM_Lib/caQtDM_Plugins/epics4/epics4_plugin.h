@@ -98,6 +98,7 @@ public:
     int pvGetTimeStamp(char *pv, char *timestamp);
     int pvGetDescription(char *pv, char *description);
     bool pvSetValue(knobData *kData, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType);
+    bool pvSetValueAsync(knobData *kData, double rdata, int32_t idata, char *sdata, char *object, char *errmess, int forceType, int token);
     bool pvSetWave(knobData *kData, float *fdata, double *ddata, int16_t *data16, int32_t *data32, char *sdata, int nelm, char *object, char *errmess);
     bool pvGetTimeStampN(knobData *kData, char *timestamp);
     bool pvGetDescriptionN(knobData *kData, char *description);
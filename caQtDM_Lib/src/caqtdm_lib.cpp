@@ -71,6 +71,9 @@
 #endif
 
 #include "caqtdm_lib.h"
+#include "displaypreloader.h"
+#include "widgetbinding.h"
+#include "channelmetadata.h"
 #include "parsepepfile.h"
 #ifdef ADL_EDL_FILES
 #   include "parseotherfile.h"
@@ -109,6 +112,7 @@
 #define RELOADWINDOW 	"Reload"
 #define RAISEWINDOW 	"Raise main window"
 #define INCLUDES        "Include Files"
+#define UPDATEPROFILE   "Update Profile"
 #define TOGGLESIZE      "Toggle fit to size"
 #define CHANGEVALUE 	"Change Increment/Value"
 #define CHANGEAXIS      "Change Axis"
@@ -170,15 +174,15 @@
 // colors back after no connect
 
 #define SetColorsBack(obj)                            \
-    if(!obj->property("Connect").value<bool>()) { \
-    obj->setNormalColors();                   \
-    obj->setProperty("Connect", true);        \
+    if(!WidgetBinding::isConnected(obj)) {        \
+    obj->setNormalColors();                       \
+    WidgetBinding::attach(obj)->connected = true; \
     }
 
 // colors back after no connect
 #define SetColorsNotConnected(obj)                    \
-    obj->setAlarmColors(NOTCONNECTED);        \
-    obj->setProperty("Connect", false);
+    obj->setAlarmColors(NOTCONNECTED);                \
+    WidgetBinding::attach(obj)->connected = false;
 
 // replace visibility channels while macro could be used */
 #define replaceVisibilityChannels(obj) \
@@ -316,12 +320,20 @@ CaQtDM_Lib::CaQtDM_Lib(QWidget *parent, QString filename, QString macro, MutexKn
     QUiLoader loader;
     fromAS = false;
     AllowsUpdate = true;
+    updateTimingEnabled = false;
+
+    // profiling of the widget updates
+    updateProfilingEnabled = false;
+    QString profileUpdates = (QString) qgetenv("CAQTDM_PROFILE_UPDATES");
+    if(profileUpdates.toLower() == "true" || profileUpdates == "1") updateProfilingEnabled = true;
     mutexKnobDataP = mKnobData;
     messageWindowP = msgWindow;
     controlsInterfaces = interfaces;
     pepPrint = pepprint;
     firstResize = true;
     loopTimer = 0;
+    visibilityTracker = (VisibilityTracker *) Q_NULLPTR;
+    preloadTimer = (QTimer *) Q_NULLPTR;
     prcFile = false;
 
     // for cainclude, we need when updating internal positions to know about the resize factors
@@ -344,6 +356,7 @@ CaQtDM_Lib::CaQtDM_Lib(QWidget *parent, QString filename, QString macro, MutexKn
     watcher = new QFileSystemWatcher(this);
     QObject::connect(watcher, SIGNAL(fileChanged(const QString&)), this, SLOT(handleFileChanged(const QString&)));
 
+    myWidget = (QWidget*) Q_NULLPTR;
     if(parentAS != (QWidget*) Q_NULLPTR) {
         fromAS = true;
         myWidget = parentAS;
@@ -385,7 +398,7 @@ CaQtDM_Lib::CaQtDM_Lib(QWidget *parent, QString filename, QString macro, MutexKn
                 }else{
                     QBuffer *buffer = new QBuffer();
                     buffer->open(QIODevice::ReadWrite);
-                    buffer->write(file->readAll());
+                    buffer->write(DisplayPreloader::instance()->fileContents(file));
 
                     buffer->seek(0);
 
@@ -587,6 +600,13 @@ CaQtDM_Lib::CaQtDM_Lib(QWidget *parent, QString filename, QString macro, MutexKn
     foreach(QStackedWidget* widget, allStacks) {
         connect(widget, SIGNAL(currentChanged(int)), this, SLOT(Callback_TabChanged(int)));
     }
+
+#ifdef IO_OPTIMIZED_FOR_TABWIDGETS
+    // suspend the io of widgets that can not be seen, driven by tab changes, window state and scrolling
+    if(VisibilityTracker::hiddenMode() != VisibilityTracker::Tabs) {
+        visibilityTracker = new VisibilityTracker(this, myWidget, mutexKnobDataP, this);
+    }
+#endif
     // setup changeevent for QStackedWidgets
     allCalcs_Vectors.clear();
     QList<caCalc *> allCalcs = myWidget->findChildren<caCalc *>();
@@ -813,15 +833,15 @@ void CaQtDM_Lib::scanChildren(QList<QWidget*> children, QWidget *tab, int indexT
                     if(!tabstack->isVisible()) {
                         //qDebug() << "thus on hidden tab";
                         hidden = true;
-                        w1->setProperty("hidden", true);
+                        WidgetBinding::attach(w1)->hidden = true;
                     } else if(indexTab == currentIndex) {
                         //qDebug() << "thus on visible tab";
                         hidden = false;
-                        w1->setProperty("hidden", false);
+                        WidgetBinding::attach(w1)->hidden = false;
                     } else {
                         //qDebug() << "thus on hidden tab";
                         hidden = true;
-                        w1->setProperty("hidden", true);
+                        WidgetBinding::attach(w1)->hidden = true;
                     }
 
                     //qDebug() << w1->objectName() << "sitting in " << tabstack << "actual position is" << currentIndex << hidden;
@@ -858,6 +878,12 @@ void CaQtDM_Lib::EnableDisableIO()
 {
 #ifdef IO_OPTIMIZED_FOR_TABWIDGETS
 
+    // the visibility tracker knows about the tabs too
+    if(visibilityTracker != (VisibilityTracker *) Q_NULLPTR) {
+        visibilityTracker->updateVisibility();
+        return;
+    }
+
     // any tabwidgets in this window ? when not do nothing
     //qDebug() << "================================" << allTabs.count() << allStacks.count();
 
@@ -900,8 +926,9 @@ void CaQtDM_Lib::timerEvent(QTimerEvent *event)
     // for epics we flush the buffer every second
     FlushAllInterfaces();
 
+    // no polling needed when the visibility tracker gets the events
     if(loopTimer == 5){
-        EnableDisableIO();
+        if(visibilityTracker == (VisibilityTracker *) Q_NULLPTR) EnableDisableIO();
         loopTimer = 0;
     }
     loopTimer++;
@@ -1178,7 +1205,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
     // say not hideen
 
-    w1->setProperty("hidden", false);
+    WidgetBinding::attach(w1)->hidden = false;
 
     // when first pass specified, treat only caCalc
     //==================================================================================================================
@@ -1259,8 +1286,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
                 }
                 monitorList.insert(0, nbMonitors);
                 indexList.insert(0, nbMonitors);
-                calcWidget->setProperty("MonitorList", monitorList);
-                calcWidget->setProperty("IndexList", indexList);
+                WidgetBinding::attach(calcWidget)->setMonitors(monitorList, indexList);
                 calcWidget->setValue(calcWidget->getVariable());
             }
 
@@ -1296,7 +1322,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
             w1->setContextMenuPolicy(Qt::CustomContextMenu);
             connect(w1, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(ShowContextMenu(const QPoint&)));
-            w1->setProperty("Connect", false);
+            WidgetBinding::attach(w1)->connected = false;
 
 
             connect(w1, SIGNAL(changeValue(double)), this, SLOT(Callback_CaCalc(double)));
@@ -1531,7 +1557,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        menuWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(menuWidget)->setMonitors(integerList);
 
         menuWidget->setProperty("Taken", true);
 
@@ -1648,7 +1674,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        cameraWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(cameraWidget)->setMonitors(integerList);
 
         // finish tooltip
         tooltip.append(ToolTipPostfix);
@@ -1676,7 +1702,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        choiceWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(choiceWidget)->setMonitors(integerList);
 
         choiceWidget->setProperty("Taken", true);
 
@@ -1767,7 +1793,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        textentryWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(textentryWidget)->setMonitors(integerList);
 
         textentryWidget->setProperty("Taken", true);
 
@@ -1828,7 +1854,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        lineeditWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(lineeditWidget)->setMonitors(integerList);
 
         lineeditWidget->setProperty("Taken", true);
 
@@ -1855,7 +1881,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        multilinestringWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(multilinestringWidget)->setMonitors(integerList);
 
         multilinestringWidget->setProperty("Taken", true);
 
@@ -1907,7 +1933,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        applynumericWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(applynumericWidget)->setMonitors(integerList);
 
         applynumericWidget->setProperty("Taken", true);
 
@@ -1928,7 +1954,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        numericWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(numericWidget)->setMonitors(integerList);
 
         numericWidget->setProperty("Taken", true);
 
@@ -1949,7 +1975,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        spinboxWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(spinboxWidget)->setMonitors(integerList);
 
         spinboxWidget->setProperty("Taken", true);
 
@@ -1999,7 +2025,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        messagebuttonWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(messagebuttonWidget)->setMonitors(integerList);
 
         messagebuttonWidget->setProperty("Taken", true);
 
@@ -2024,7 +2050,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        togglebuttonWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(togglebuttonWidget)->setMonitors(integerList);
 
         togglebuttonWidget->setProperty("Taken", true);
 
@@ -2071,7 +2097,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        ledWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(ledWidget)->setMonitors(integerList);
 
         ledWidget->setProperty("Taken", true);
 
@@ -2093,7 +2119,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        bitnamesWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(bitnamesWidget)->setMonitors(integerList);
 
         bitnamesWidget->setProperty("Taken", true);
 
@@ -2115,7 +2141,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        sliderWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(sliderWidget)->setMonitors(integerList);
 
         sliderWidget->setProperty("Taken", true);
 
@@ -2136,7 +2162,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        clockWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(clockWidget)->setMonitors(integerList);
 
         clockWidget->setProperty("Taken", true);
 
@@ -2163,7 +2189,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        thermoWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(thermoWidget)->setMonitors(integerList);
 
         thermoWidget->setProperty("Taken", true);
 
@@ -2182,7 +2208,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        lineargaugeWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(lineargaugeWidget)->setMonitors(integerList);
 
         lineargaugeWidget->setProperty("Taken", true);
 
@@ -2201,7 +2227,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        circulargaugeWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(circulargaugeWidget)->setMonitors(integerList);
 
         circulargaugeWidget->setProperty("Taken", true);
 
@@ -2222,7 +2248,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        meterWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(meterWidget)->setMonitors(integerList);
 
         meterWidget->setProperty("Taken", true);
 
@@ -2241,7 +2267,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        byteWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(byteWidget)->setMonitors(integerList);
 
         byteWidget->setProperty("Taken", true);
 
@@ -2261,7 +2287,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        bytecontrollerWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(bytecontrollerWidget)->setMonitors(integerList);
 
         bytecontrollerWidget->setProperty("Taken", true);
 
@@ -2499,7 +2525,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
                                 QBuffer *buffer = new QBuffer();
                                 buffer->open(QIODevice::ReadWrite);
                                 //QByteArray data=file->readAll();
-                                buffer->write(file->readAll());
+                                buffer->write(DisplayPreloader::instance()->fileContents(file));
 
                                 //QCryptographicHash md5Gen(QCryptographicHash::Md5);
                                 //md5Gen.addData(data);
@@ -3022,7 +3048,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        cartesianplotWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(cartesianplotWidget)->setMonitors(integerList);
 
         cartesianplotWidget->setProperty("Taken", true);
 
@@ -3072,7 +3098,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         // insert dataindex list
         integerList.insert(0, nbMonitors);
-        waterfallplotWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(waterfallplotWidget)->setMonitors(integerList);
 
         waterfallplotWidget->setProperty("Taken", true);
 
@@ -3159,7 +3185,12 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
         if(reaffectText(map, &title, w1)) stripplotWidget->setTitleY(title);
 
         integerList.insert(0, nbMonitors); /* set property into stripplotWidget */
-        stripplotWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(stripplotWidget)->setMonitors(integerList);
+
+        // history older than what we have seen can be taken from an archive plugin (dynamic property archiveBackfill, e.g. archiveHTTP)
+        if(!stripplotWidget->property("archiveBackfill").toString().trimmed().isEmpty()) {
+            connect(stripplotWidget, SIGNAL(backfillRequest(double)), this, SLOT(Callback_StripPlotBackfill(double)));
+        }
 
         stripplotWidget->setProperty("Taken", true);
 
@@ -3177,20 +3208,17 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
         for(int i=0; i< vars.count(); i++) {
             pv = vars.at(i);
             if(pv.size() > 0) {
-                QTableWidgetItem *item;
                 specData[0] = i;            // table row
                 int num = addMonitor(myWidget, &kData, pv, w1, specData, map, &pv);
                 integerList.append(num);
                 nbMonitors++;
-                item = new QTableWidgetItem(pv);
-                item->setTextAlignment(Qt::AlignAbsolute | Qt:: AlignLeft);
-                tableWidget->setItem(i,0, item);
+                tableWidget->displayText(i, 0, -1, pv);
             }
         }
         tableWidget->setColumnSizes(tableWidget->getColumnSizes());
 
         integerList.insert(0, nbMonitors); /* set property into stripplotWidget */
-        tableWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(tableWidget)->setMonitors(integerList);
 
         tableWidget->setProperty("Taken", true);
         tableWidget->setToolTip("select row or columns, then with Ctrl+C you can copy to the clipboard\ninside X11 you can then do shft+ins\nwhen doubleclicking on a value, you may execute a shell script for that device");
@@ -3221,7 +3249,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
         }
 
         integerList.insert(0, nbMonitors); /* set property into stripplotWidget */
-        wavetableWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(wavetableWidget)->setMonitors(integerList);
 
         wavetableWidget->setProperty("Taken", true);
 
@@ -3332,7 +3360,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
         scan2dWidget->setToolTip(tooltip);
 
         integerList.insert(0, nbMonitors); /* set property into stripplotWidget */
-        scan2dWidget->setProperty("MonitorList", integerList);
+        WidgetBinding::attach(scan2dWidget)->setMonitors(integerList);
 
         scan2dWidget->setProperty("Taken", true);
     }
@@ -3353,7 +3381,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
 
         w1->setContextMenuPolicy(Qt::CustomContextMenu);
         connect(w1, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(ShowContextMenu(const QPoint&)));
-        w1->setProperty("Connect", false);
+        WidgetBinding::attach(w1)->connected = false;
         // in order to get the context on tablets
 #ifdef MOBILE
         w1->grabGesture(Qt::TapAndHoldGesture);
@@ -3369,7 +3397,7 @@ void CaQtDM_Lib::HandleWidget(QWidget *w1, QString macro, bool firstPass, bool t
         w1->setContextMenuPolicy(Qt::CustomContextMenu);
         disconnect(w1, SIGNAL(customContextMenuRequested(const QPoint&)), 0, 0);
         connect(w1, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(ShowContextMenu(const QPoint&)));
-        w1->setProperty("Connect", false);
+        WidgetBinding::attach(w1)->connected = false;
     }
 
 }
@@ -3766,7 +3794,7 @@ int CaQtDM_Lib::addMonitor(QWidget *thisW, knobData *kData, QString pv, QWidget
     ControlsInterface *plugininterface = (ControlsInterface *) 0;
 
     ftime(&now);
-    w->setProperty("Connect", false);
+    WidgetBinding::attach(w)->connected = false;
     int rate = DEFAULTRATE;  // default will be 5Hz
 
     if(pv.size() == 0) return -1;
@@ -3825,39 +3853,9 @@ int CaQtDM_Lib::addMonitor(QWidget *thisW, knobData *kData, QString pv, QWidget
     *pvRep = trimmedPV;
 
     // find out what kind of interface has to be used for this pv, default is epics3 or whatever is specified on the command line with -cs
-
-    // specified with the channel
-    pos = trimmedPV.indexOf("://");
-    if(pos != -1) {
-        pluginName = trimmedPV.mid(0, pos);
-        trimmedPV = trimmedPV.mid(pos+3);
-
-        // take care of some specialties epics4 (one can specify epics4://, pva:// or ca://
-        if(pluginName.contains("epics4")) pluginFlavor = "pva";  // default when epics4 is specified
-        else if(pluginName.contains("ca")) {
-            pluginName = "epics4";
-            pluginFlavor = "ca";
-        } else if(pluginName.contains("pva")) {
-            pluginName = "epics4";
-            pluginFlavor = "pva";
-        }
-
-    // not specified with the channel
-    } else {
-
-        // no default plugin specified on command line
-        if(defaultPlugin.isEmpty()) {
-#ifdef PVAISDEFAULTPROVIDER
-           pluginName = "epics4";
-           pluginFlavor = "ca";
-#else
-           pluginName = "epics3";
-#endif
-        // a default plugin is specied on the command line
-        } else {
-           pluginName = defaultPlugin;
-           if(pluginName.contains("epics4")) pluginFlavor = "pva";  // default when epics4 is specified
-        }
+    bool specified = trimmedPV.contains("://");
+    pluginName = channelPlugin(trimmedPV, pluginFlavor);
+    if(!specified) {
         if(kData->soft) pluginName = "intern";
         if(mutexKnobDataP->getSoftPV(trimmedPV, &indx, thisW)) pluginName = "intern";
     }
@@ -3945,8 +3943,18 @@ int CaQtDM_Lib::addMonitor(QWidget *thisW, knobData *kData, QString pv, QWidget
         lineedit->setText("");
     }
 
+    // a channel of a display closed shortly before is taken over with its connection and last values
+    int num = mutexKnobDataP->TakeLingeringMutexKnobDataSlot(kData, rate);
+    if(num != -1) {
+        delete mutex;
+        getUpdateHandler(num, (QWidget*) kData->dispW);
+        addMonitorInfo(w, kData);
+        memset(kData, 0, sizeof (knobData));
+        return num;
+    }
+
     // get an index in the data list
-    int num = mutexKnobDataP->GetMutexKnobDataIndex();
+    num = mutexKnobDataP->GetMutexKnobDataIndex();
     if(num == -1) {
         qDebug() << "this should never happen";
         return num;
@@ -3978,6 +3986,9 @@ int CaQtDM_Lib::addMonitor(QWidget *thisW, knobData *kData, QString pv, QWidget
     // update data structure
     mutexKnobDataP->SetMutexKnobData(num, *kData);
 
+    // resolve the update routine for this widget once
+    getUpdateHandler(num, (QWidget*) kData->dispW);
+
     // in case of a soft channel there is nothing to do
     if(kData->soft) {
         memset(kData, 0, sizeof (knobData));
@@ -3987,7 +3998,152 @@ int CaQtDM_Lib::addMonitor(QWidget *thisW, knobData *kData, QString pv, QWidget
     // define data acquisition
     if(plugininterface != (ControlsInterface *) Q_NULLPTR) plugininterface->pvAddMonitor(num, kData, rate, false);
 
-    // add for this widget the io info
+    addMonitorInfo(w, kData);
+
+    // clear data
+    memset(kData, 0, sizeof (knobData));
+
+    return num;
+}
+
+/**
+ * find out the plugin and its flavor for a channel, a plugin specified with the channel is removed from it
+ */
+QString CaQtDM_Lib::channelPlugin(QString &pv, QString &pluginFlavor)
+{
+    QString pluginName="";
+    pluginFlavor = "";
+
+    // specified with the channel
+    int pos = pv.indexOf("://");
+    if(pos != -1) {
+        pluginName = pv.mid(0, pos);
+        pv = pv.mid(pos+3);
+
+        // take care of some specialties epics4 (one can specify epics4://, pva:// or ca://
+        if(pluginName.contains("epics4")) pluginFlavor = "pva";  // default when epics4 is specified
+        else if(pluginName.contains("ca")) {
+            pluginName = "epics4";
+            pluginFlavor = "ca";
+        } else if(pluginName.contains("pva")) {
+            pluginName = "epics4";
+            pluginFlavor = "pva";
+        }
+
+    // not specified with the channel
+    } else {
+
+        // no default plugin specified on command line
+        if(defaultPlugin.isEmpty()) {
+#ifdef PVAISDEFAULTPROVIDER
+           pluginName = "epics4";
+           pluginFlavor = "ca";
+#else
+           pluginName = "epics3";
+#endif
+        // a default plugin is specied on the command line
+        } else {
+           pluginName = defaultPlugin;
+           if(pluginName.contains("epics4")) pluginFlavor = "pva";  // default when epics4 is specified
+        }
+    }
+    return pluginName;
+}
+
+/**
+ * prepare the displays of a related display: their files are read and parsed into the template cache
+ * and their channels are connected, the displays then take over the connected channels
+ */
+void CaQtDM_Lib::preloadRelatedDisplay(caRelatedDisplay *w)
+{
+    DisplayPreloader *preloader = DisplayPreloader::instance();
+    double validSeconds = mutexKnobDataP->getLingerSeconds();
+    QStringList files = w->getFiles().split(";");
+    QStringList args = relatedDisplayArgs(w, false);
+
+    // a menu can open any of its displays
+    for(int i=0; i < files.count(); i++) {
+        QString file = files[i].trimmed();
+        QString macro = (i < args.count()) ? args[i].trimmed() : "";
+        QStringList channels;
+        if(file.isEmpty()) continue;
+
+        QElapsedTimer timer;
+        timer.start();
+        if(!preloader->preload(file, macro, validSeconds, channels)) continue;
+
+        // without lingering channels only the file is prepared
+        int count = 0;
+        if(validSeconds > 0.0) {
+            QMap<QString, QString> map = createMap(macro);
+            foreach(QString channel, channels) {
+                if(preconnectChannel(map, channel)) count++;
+            }
+            if(count > 0) FlushAllInterfaces();
+        }
+        preloader->preloadDone(file, macro, (double) timer.elapsed(), count);
+    }
+}
+
+/**
+ * connect a channel of a display that is going to be opened and put it in the pool of lingering channels,
+ * where addMonitor takes it over; only for epics channels without json and unresolved macros
+ */
+bool CaQtDM_Lib::preconnectChannel(QMap<QString, QString> map, const QString &channel)
+{
+    knobData kData;
+    struct timeb now;
+    bool doNothing = false;
+
+    if(channel.contains("{")) return false;
+    QString pv = treatMacro(map, channel.trimmed(), &doNothing, "");
+    if(doNothing || pv.isEmpty() || pv.contains("$(")) return false;
+
+    QString pluginFlavor;
+    QString pluginName = channelPlugin(pv, pluginFlavor);
+    if(pluginName != "epics3" && pluginName != "epics4") return false;
+    ControlsInterface *plugininterface = getControlInterface(pluginName);
+    if(plugininterface == (ControlsInterface *) Q_NULLPTR) return false;
+
+    memset(&kData, 0, sizeof (knobData));
+    qstrncpy(kData.pluginName, (char*) qasc(pluginName), caqtdm_string_t_length);
+    qstrncpy(kData.pluginFlavor, (char*) qasc(pluginFlavor), caqtdm_string_t_length);
+    qstrncpy(kData.pv, qasc(pv), MAXPVLEN-1);
+
+    // connected already for a display that was closed or prepared before
+    if(mutexKnobDataP->HasLingeringMutexKnobDataSlot(&kData)) return false;
+
+    int num = mutexKnobDataP->GetMutexKnobDataIndex();
+    if(num == -1) return false;
+
+    ftime(&now);
+    kData.index = num;
+    kData.thisW = (void*) DisplayPreloader::instance();
+    kData.dispW = (void*) Q_NULLPTR;
+    kData.mutex = (void*) new QMutex;
+    kData.pluginInterface = (void *) plugininterface;
+    kData.edata.initialize = true;
+    kData.edata.lastTime = now;
+    kData.edata.repRate = DEFAULTRATE;
+    mutexKnobDataP->SetMutexKnobData(num, kData);
+
+    plugininterface->pvAddMonitor(num, &kData, DEFAULTRATE, false);
+
+    if(!mutexKnobDataP->LingerMutexKnobDataSlot(num)) {
+        plugininterface->pvClearMonitor(&kData);
+        kData.index = -1;
+        mutexKnobDataP->SetMutexKnobData(num, kData);
+        mutexKnobDataP->RetireMutexKnobDataSlot(num, plugininterface);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * add for this widget the io info and the plugin
+ */
+void CaQtDM_Lib::addMonitorInfo(QWidget *w, knobData *kData)
+{
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
     QVariant v = qVariantFromValue(kData->edata.info);
 #else
@@ -4007,11 +4163,6 @@ int CaQtDM_Lib::addMonitor(QWidget *thisW, knobData *kData, QString pv, QWidget
     QVariantList infoList2 = var2.toList();
     infoList2.append(plugin);
     w->setProperty("Interface", infoList2);
-
-    // clear data
-    memset(kData, 0, sizeof (knobData));
-
-    return num;
 }
 
 /**
@@ -4200,14 +4351,12 @@ bool CaQtDM_Lib::CalcVisibility(QWidget *w, double &result, bool &valid)
     qstrncpy(calcString, qasc(calcQString),calcstring_length);
 
     // any monitors ?
-    QVariant monitorList=w->property("MonitorList");
-    QVariantList MonitorList = monitorList.toList();
-    QVariant indexList=w->property("IndexList");
-    QVariantList IndexList = indexList.toList();
-
-    if(MonitorList.size() == 0) return true;
+    WidgetBinding *binding = WidgetBinding::get(w);
+    if(binding == (WidgetBinding *) Q_NULLPTR) return true;
+    const QVector<int> &monitors = binding->monitors;
+    const QVector<int> &inputs = binding->inputs;
 
-    int nbMonitors = MonitorList.at(0).toInt();
+    int nbMonitors = monitors.size();
     //qDebug() << "number of monitors" << nbMonitors << "calc=" << calcString;
     if(nbMonitors > 0)  {
 
@@ -4237,7 +4386,7 @@ bool CaQtDM_Lib::CalcVisibility(QWidget *w, double &result, bool &valid)
 #endif
 
         if (pos != -1){
-            knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(MonitorList.at(1).toInt());
+            knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(monitors.at(0));
             if(ptr != (knobData *) Q_NULLPTR) {
                 char dataString[STRING_EXCHANGE_SIZE];
                 int caFieldType= ptr->edata.fieldtype;
@@ -4252,7 +4401,7 @@ bool CaQtDM_Lib::CalcVisibility(QWidget *w, double &result, bool &valid)
                             QString String(dataString);
                             QStringList list;
                             //list = String.split(";");
-                            list = String.split((QChar)27);
+                            list = splitStrings(*ptr, String);
                             if((ptr->edata.fieldtype == caENUM)  && ((int) ptr->edata.ivalue < list.count() ) && (list.count() > 0)) {
                                 if(list.at((int) ptr->edata.ivalue).trimmed().size() != 0)  {  // string seems to empty, give value
                                     QString strng = list.at((int) ptr->edata.ivalue);
@@ -4300,11 +4449,11 @@ bool CaQtDM_Lib::CalcVisibility(QWidget *w, double &result, bool &valid)
                 //qDebug() << "qrect for cacalc detected";
                 for(int i=0; i<4; i++) valueArray[i] = -1;  //say default value will not do anything
                 for(int i=0; i<nbMonitors;i++) {
-                    knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(MonitorList.at(i+1).toInt());
+                    knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(monitors.at(i));
                     if(ptr != (knobData*) Q_NULLPTR) {
-                        //qDebug() << "calculate from index" << i << ptr->index << ptr->pv << ptr->edata.connected << ptr->edata.rvalue << IndexList.at(i+1).toInt();
+                        //qDebug() << "calculate from index" << i << ptr->index << ptr->pv << ptr->edata.connected << ptr->edata.rvalue << inputs.at(i);
                         // when connected
-                        int j = IndexList.at(i+1).toInt(); // input a,b,c,d
+                        int j = inputs.at(i); // input a,b,c,d
                         if(ptr->edata.connected) {
                             switch (ptr->edata.fieldtype){
                             case caINT:
@@ -4359,7 +4508,7 @@ bool CaQtDM_Lib::CalcVisibility(QWidget *w, double &result, bool &valid)
 
             for(int i=0; i < MAXMONITORS; i++) valueArray[i] = 0.0;
             for(int i=0; i< nbMonitors;i++) {
-                knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(MonitorList.at(i+1).toInt());
+                knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(monitors.at(i));
                 if(ptr == (knobData*) Q_NULLPTR) {
                     valid = false;
                     return false;
@@ -4404,10 +4553,10 @@ bool CaQtDM_Lib::CalcVisibility(QWidget *w, double &result, bool &valid)
             pArgs = PyTuple_New(MAXMONITORS);
             for(int i=0; i< MAXMONITORS; i++) pValueA[i] = PyFloat_FromDouble(0.0);
             for(int i=0; i< nbMonitors; i++) {
-                knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(MonitorList.at(i+1).toInt());
+                knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(monitors.at(i));
                 if(ptr != (knobData*) Q_NULLPTR) {
                     // when connected
-                    int j = IndexList.at(i+1).toInt(); // input a,b,c,d
+                    int j = inputs.at(i); // input a,b,c,d
                     if(ptr->edata.connected) {
                         valueArray[j] = ptr->edata.rvalue;
                     } else {
@@ -4452,11 +4601,11 @@ bool CaQtDM_Lib::CalcVisibility(QWidget *w, double &result, bool &valid)
             // scan and get the channels
             for(int i=0; i < MAX_CALC_INPUTS; i++) valueArray[i] = 0.0;
             for(int i=0; i< nbMonitors;i++) {
-                knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(MonitorList.at(i+1).toInt());
+                knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(monitors.at(i));
                 if(ptr != (knobData*) Q_NULLPTR) {
-                    //qDebug() << "calculate from index" << i << ptr->index << ptr->pv << ptr->edata.connected << ptr->edata.rvalue << ptr->edata.ivalue << IndexList.at(i+1).toInt();
+                    //qDebug() << "calculate from index" << i << ptr->index << ptr->pv << ptr->edata.connected << ptr->edata.rvalue << ptr->edata.ivalue << inputs.at(i);
                     // when connected
-                    int j = IndexList.at(i+1).toInt(); // input a,b,c,d
+                    int j = inputs.at(i); // input a,b,c,d
                     if(ptr->edata.connected) {
                         switch (ptr->edata.fieldtype){
                             case caINT:
@@ -4524,15 +4673,14 @@ short CaQtDM_Lib::ComputeAlarm(QWidget *w)
 {
     short status;
     // any monitors ?
-    QVariant var=w->property("MonitorList");
-    QVariantList list = var.toList();
-    int nbMonitors = list.at(0).toInt();
+    WidgetBinding *binding = WidgetBinding::get(w);
+    int nbMonitors = (binding != (WidgetBinding *) Q_NULLPTR) ? binding->monitors.size() : 0;
     //qDebug() << "number of monitors" << nbMonitors;
     status = NO_ALARM;
     if(nbMonitors > 0)  {
 
         // medm uses however only first channel
-        knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(list.at(1).toInt());
+        knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(binding->monitors.at(0));
         if(ptr != (knobData *) Q_NULLPTR) {
             // when connected
             if(ptr->edata.connected) {
@@ -4667,9 +4815,6 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
                                        const QString& String,
                                        const knobData& data)
 {
-    Q_UNUSED(indx);
-    Q_UNUSED(fec);
-
     if(!AllowsUpdate) return;
 
     // thread mutexknobdata emits to all instances of this class, later we will have to filter on the emit side to enhance performance
@@ -4687,13 +4832,222 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
         return;
     }
 
+    // per channel statistics (displays and latency)
+    mutexKnobDataP->SetMutexKnobDataDisplayed(indx);
+
+    int handler = getUpdateHandler(indx, w);
+
+    if(!updateTimingEnabled && !updateProfilingEnabled) {
+        UpdateWidget(w, handler, units, fec, String, data);
+    } else {
+        QElapsedTimer timer;
+        timer.start();
+        UpdateWidget(w, handler, units, fec, String, data);
+        double usec = (double) timer.nsecsElapsed() / 1000.0;
+        if(updateTimingEnabled) updateTimings.append((float) usec);
+        if(updateProfilingEnabled) ProfileWidgetUpdate(w, usec);
+    }
+}
+
+/**
+ * find the update routine for a widget, the order of the tests is important while some classes inherit from others;
+ * casts gets the number of class tests done, shown by the update profile
+ */
+#define RESOLVE_HANDLER(test, handler) tests++; if(test) { if(casts != (int*) Q_NULLPTR) *casts = tests; return handler; }
+
+int CaQtDM_Lib::resolveUpdateHandler(QWidget *w, int *casts)
+{
+    int tests = 0;
+    RESOLVE_HANDLER(dynamic_cast<caWidgetInterface *>(w), Handler_caWidgetInterface);
+    RESOLVE_HANDLER(qobject_cast<caCalc *>(w), Handler_caCalc);
+    RESOLVE_HANDLER(qobject_cast<caLabel *>(w), Handler_caLabel);
+    RESOLVE_HANDLER(qobject_cast<caLabelVertical *>(w), Handler_caLabelVertical);
+    RESOLVE_HANDLER(qobject_cast<caInclude *>(w), Handler_caInclude);
+    RESOLVE_HANDLER(qobject_cast<caFrame *>(w), Handler_caFrame);
+    RESOLVE_HANDLER(qobject_cast<caMenu *>(w), Handler_caMenu);
+    RESOLVE_HANDLER(qobject_cast<caChoice *>(w), Handler_caChoice);
+    RESOLVE_HANDLER(qobject_cast<caThermo *>(w), Handler_caThermo);
+    RESOLVE_HANDLER(qobject_cast<caSlider *>(w), Handler_caSlider);
+    RESOLVE_HANDLER(qobject_cast<caClock *>(w), Handler_caClock);
+    RESOLVE_HANDLER(qobject_cast<caLinearGauge *>(w), Handler_caLinearGauge);
+    RESOLVE_HANDLER(qobject_cast<caCircularGauge *>(w), Handler_caCircularGauge);
+    RESOLVE_HANDLER(qobject_cast<caMeter *>(w), Handler_caMeter);
+    RESOLVE_HANDLER(qobject_cast<caByte *>(w), Handler_caByte);
+    RESOLVE_HANDLER(qobject_cast<caByteController *>(w), Handler_caByteController);
+    RESOLVE_HANDLER(qobject_cast<replaceMacro *>(w), Handler_replaceMacro);
+    RESOLVE_HANDLER(qobject_cast<caLineEdit *>(w), Handler_caLineEdit);
+    RESOLVE_HANDLER(qobject_cast<caMultiLineString *>(w), Handler_caMultiLineString);
+    RESOLVE_HANDLER(qobject_cast<caGraphics *>(w), Handler_caGraphics);
+    RESOLVE_HANDLER(qobject_cast<caPolyLine *>(w), Handler_caPolyLine);
+    RESOLVE_HANDLER(qobject_cast<caLed *>(w), Handler_caLed);
+    RESOLVE_HANDLER(qobject_cast<caApplyNumeric *>(w), Handler_caApplyNumeric);
+    RESOLVE_HANDLER(qobject_cast<caNumeric *>(w), Handler_caNumeric);
+    RESOLVE_HANDLER(qobject_cast<caSpinbox *>(w), Handler_caSpinbox);
+    RESOLVE_HANDLER(qobject_cast<caToggleButton *>(w), Handler_caToggleButton);
+    RESOLVE_HANDLER(qobject_cast<caCartesianPlot *>(w), Handler_caCartesianPlot);
+    RESOLVE_HANDLER(qobject_cast<caWaterfallPlot *>(w), Handler_caWaterfallPlot);
+    RESOLVE_HANDLER(qobject_cast<caStripPlot *>(w), Handler_caStripPlot);
+    RESOLVE_HANDLER(qobject_cast<caImage *>(w), Handler_caImage);
+    RESOLVE_HANDLER(qobject_cast<caTable *>(w), Handler_caTable);
+    RESOLVE_HANDLER(qobject_cast<caWaveTable *>(w), Handler_caWaveTable);
+    RESOLVE_HANDLER(qobject_cast<caBitnames *>(w), Handler_caBitnames);
+    RESOLVE_HANDLER(qobject_cast<caCamera *>(w), Handler_caCamera);
+    RESOLVE_HANDLER(qobject_cast<caScan2D *>(w), Handler_caScan2D);
+    RESOLVE_HANDLER(qobject_cast<caMessageButton *>(w), Handler_caMessageButton);
+    if(casts != (int*) Q_NULLPTR) *casts = tests;
+    return Handler_unknown;
+}
+
+#undef RESOLVE_HANDLER
+
+/**
+ * handler for the widget of a slot, resolved once and then kept per slot; the class is compared too,
+ * as a released slot and a deleted widget may both be reused for a widget of another class at the same address
+ */
+int CaQtDM_Lib::getUpdateHandler(int indx, QWidget *w)
+{
+    if(indx < 0) return resolveUpdateHandler(w);
+    if(indx >= updateDispatchList.size()) {
+        int size = updateDispatchList.size();
+        updateDispatchList.resize(indx + 100);
+        for(int i=size; i < updateDispatchList.size(); i++) clearUpdateHandler(i);
+    }
+    updateDispatch &dispatch = updateDispatchList[indx];
+    const QMetaObject *meta = w->metaObject();
+    if(dispatch.widget != w || dispatch.meta != meta) {
+        dispatch.widget = w;
+        dispatch.meta = meta;
+        dispatch.handler = resolveUpdateHandler(w);
+    }
+    return dispatch.handler;
+}
+
+/**
+ * forget the handler of a released slot
+ */
+void CaQtDM_Lib::clearUpdateHandler(int indx)
+{
+    if(indx < 0 || indx >= updateDispatchList.size()) return;
+    updateDispatch &dispatch = updateDispatchList[indx];
+    dispatch.widget = (QWidget*) Q_NULLPTR;
+    dispatch.meta = (const QMetaObject*) Q_NULLPTR;
+    dispatch.handler = Handler_unknown;
+}
+
+/**
+ * compare the cost of resolving the update routine through the cast chain with the lookup in the dispatch table
+ */
+void CaQtDM_Lib::benchmarkDispatch(int iterations, double &chainNs, double &tableNs)
+{
+    QList<QPair<int, QWidget*> > monitored;
+    foreach(int i, mutexKnobDataP->GetMutexKnobDataWindowSlots(myWidget)) {
+        knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(i);
+        if((kPtr->index != -1) && (myWidget == (QWidget*) kPtr->thisW) && (kPtr->dispW != Q_NULLPTR)) {
+            monitored.append(QPair<int, QWidget*>(i, (QWidget*) kPtr->dispW));
+        }
+    }
+    chainNs = tableNs = 0.0;
+    if(monitored.isEmpty() || iterations <= 0) return;
+
+    volatile int sum = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for(int n=0; n < iterations; n++) {
+        for(int i=0; i < monitored.count(); i++) sum += resolveUpdateHandler(monitored.at(i).second);
+    }
+    chainNs = (double) timer.nsecsElapsed() / ((double) iterations * monitored.count());
+
+    timer.restart();
+    for(int n=0; n < iterations; n++) {
+        for(int i=0; i < monitored.count(); i++) sum += getUpdateHandler(monitored.at(i).first, monitored.at(i).second);
+    }
+    tableNs = (double) timer.nsecsElapsed() / ((double) iterations * monitored.count());
+    Q_UNUSED(sum);
+}
+
+/**
+ * keep count, cumulative and maximum update time per widget class and per widget,
+ * casts is the number of class tests needed when the update routine was resolved
+ */
+void CaQtDM_Lib::ProfileWidgetUpdate(QWidget *w, double usec)
+{
+    QString className = w->metaObject()->className();
+
+    QMap<QString, updateProfile>::iterator it = profileClassList.find(className);
+    if(it == profileClassList.end()) {
+        updateProfile profile;
+        profile.count = 0;
+        profile.sum = profile.max = 0.0;
+        resolveUpdateHandler(w, &profile.casts);
+        it = profileClassList.insert(className, profile);
+    }
+    it.value().count++;
+    it.value().sum += usec;
+    if(usec > it.value().max) it.value().max = usec;
+    int casts = it.value().casts;
+
+    QString objectName = w->objectName();
+    QMap<QString, updateProfile>::iterator ot = profileObjectList.find(objectName);
+    if(ot == profileObjectList.end()) {
+        updateProfile profile;
+        profile.count = 0;
+        profile.sum = profile.max = 0.0;
+        profile.casts = casts;
+        ot = profileObjectList.insert(objectName, profile);
+    }
+    ot.value().count++;
+    ot.value().sum += usec;
+    if(usec > ot.value().max) ot.value().max = usec;
+}
+
+/**
+ * update profile as html (context menu) or as plain text (dump on exit)
+ */
+QString CaQtDM_Lib::getUpdateProfile(bool html)
+{
+    QString info;
+    QString header = QString("%1 %2 %3 %4 %5 %6").arg("name", -40).arg("count", 10).arg("total[ms]", 12).arg("mean[us]", 10).arg("max[us]", 10).arg("casts", 6);
+    QList<QMap<QString, updateProfile> *> lists;
+    lists << &profileClassList << &profileObjectList;
+    QStringList titles;
+    titles << "per widget class" << "per widget";
+
+    for(int l=0; l < lists.count(); l++) {
+        info.append(html ? "<strong>" + titles.at(l) + "</strong><br>" : titles.at(l) + "\n");
+        info.append(header);
+        info.append(html ? "<br>" : "\n");
+        QMap<QString, updateProfile>::const_iterator it = lists.at(l)->constBegin();
+        while (it != lists.at(l)->constEnd()) {
+            updateProfile value = it.value();
+            QString line = QString("%1 %2 %3 %4 %5 %6").arg(it.key(), -40).arg(value.count, 10).arg(value.sum / 1000.0, 12, 'f', 1)
+                    .arg(value.count > 0 ? value.sum / (double) value.count : 0.0, 10, 'f', 1).arg(value.max, 10, 'f', 1).arg(value.casts, 6);
+            info.append(line);
+            info.append(html ? "<br>" : "\n");
+            ++it;
+        }
+        info.append(html ? "<br>" : "\n");
+    }
+    return info;
+}
+
+/**
+ * update the widget with the received data
+ */
+void CaQtDM_Lib::UpdateWidget(QWidget *w, int handler, const QString& units, const QString& fec, const QString& String, const knobData& data)
+{
+    Q_UNUSED(fec);
+
     // any caWidget with caWidgetInterface
-    if (caWidgetInterface* wif = dynamic_cast<caWidgetInterface *>(w)) {
+    switch(handler) {
+    case Handler_caWidgetInterface: {
+        caWidgetInterface* wif = dynamic_cast<caWidgetInterface *>(w);
         wif->caDataUpdate(units, String, data);
+        break;
     }
 
     // calc ==================================================================================================================
-    else if(caCalc *calcWidget = qobject_cast<caCalc *>(w)) {
+    case Handler_caCalc: {
+        caCalc *calcWidget = static_cast<caCalc *>(w);
         bool valid;
         double result;
         switch (data.edata.fieldtype){
@@ -4739,20 +5093,24 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             }
         }
 
-        // caLabel ==================================================================================================================
-    } else if(caLabel *labelWidget = qobject_cast<caLabel *>(w)) {
+        break;
+    }
+
+    // caLabel ==================================================================================================================
+    case Handler_caLabel: {
+        caLabel *labelWidget = static_cast<caLabel *>(w);
         //qDebug() << "we have a label";
 
         if(data.edata.connected) {
             int colorMode = labelWidget->getColorMode();
             if(colorMode == caLabel::Static) {
                 // done at initialisation, we have to set it back after no connect
-                if(!labelWidget->property("Connect").value<bool>()) {
+                if(!WidgetBinding::isConnected(labelWidget)) {
                     QColor fg = labelWidget->property("FColor").value<QColor>();
                     QColor bg = labelWidget->property("BColor").value<QColor>();
                     labelWidget->setForeground(fg);
                     labelWidget->setBackground(bg);
-                    labelWidget->setProperty("Connect", true);
+                    WidgetBinding::attach(labelWidget)->connected = true;
                 }
             } else if(colorMode == caLabel::Alarm) {
                 short status = ComputeAlarm(w);
@@ -4765,20 +5123,24 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(labelWidget);
         }
 
-        // caLabelVertical ==================================================================================================================
-    } else if(caLabelVertical *labelverticalWidget = qobject_cast<caLabelVertical *>(w)) {
+        break;
+    }
+
+    // caLabelVertical ==================================================================================================================
+    case Handler_caLabelVertical: {
+        caLabelVertical *labelverticalWidget = static_cast<caLabelVertical *>(w);
         //qDebug() << "we have a label";
 
         if(data.edata.connected) {
             int colorMode = labelverticalWidget->getColorMode();
             if(colorMode == caLabelVertical::Static) {
                 // done at initialisation, we have to set it back after no connect
-                if(!labelverticalWidget->property("Connect").value<bool>()) {
+                if(!WidgetBinding::isConnected(labelverticalWidget)) {
                     QColor fg = labelverticalWidget->property("FColor").value<QColor>();
                     QColor bg = labelverticalWidget->property("BColor").value<QColor>();
                     labelverticalWidget->setForeground(fg);
                     labelverticalWidget->setBackground(bg);
-                    labelverticalWidget->setProperty("Connect", true);
+                    WidgetBinding::attach(labelverticalWidget)->connected = true;
                 }
             } else if(colorMode == caLabelVertical::Alarm) {
                 short status = ComputeAlarm(w);
@@ -4791,8 +5153,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(labelverticalWidget);
         }
 
-        // caInclude ==================================================================================================================
-    } else if(caInclude *includeWidget = qobject_cast<caInclude *>(w)) {
+        break;
+    }
+
+    // caInclude ==================================================================================================================
+    case Handler_caInclude: {
+        caInclude *includeWidget = static_cast<caInclude *>(w);
         //qDebug() << "we have an include";
 
         // visibility
@@ -4887,20 +5253,28 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             }
         }
 
-        // caFrame ==================================================================================================================
-    } else if(caFrame *frameWidget = qobject_cast<caFrame *>(w)) {
+        break;
+    }
+
+    // caFrame ==================================================================================================================
+    case Handler_caFrame: {
+        caFrame *frameWidget = static_cast<caFrame *>(w);
         //qDebug() << "we have a frame";
 
         setObjectVisibility(frameWidget, data.edata.rvalue);
 
-        // caMenu ==================================================================================================================
-    } else if (caMenu *menuWidget = qobject_cast<caMenu *>(w)) {
+        break;
+    }
+
+    // caMenu ==================================================================================================================
+    case Handler_caMenu: {
+        caMenu *menuWidget = static_cast<caMenu *>(w);
         //qDebug() << "we have a menu" << data.pv << data.edata.connected << data.specData[0];
 
         if(data.edata.connected) {
             // set enum strings
             if((data.edata.fieldtype == caENUM) && (data.specData[0] == 0)) {
-                QStringList stringlist = String.split((QChar)27);
+                QStringList stringlist = splitStrings(data, String);
                 menuWidget->populateCells(stringlist);
                 if(menuWidget->getLabelDisplay()) menuWidget->setCurrentIndex(0);
                 else {
@@ -4934,12 +5308,16 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
         menuWidget->setAccessW(data.edata.accessW);
         updateAccessCursor(menuWidget);
 
-        // caChoice ==================================================================================================================
-    } else if (caChoice *choiceWidget = qobject_cast<caChoice *>(w)) {
+        break;
+    }
+
+    // caChoice ==================================================================================================================
+    case Handler_caChoice: {
+        caChoice *choiceWidget = static_cast<caChoice *>(w);
         //qDebug() << "we have a choiceButton" << String << (int) data.edata.ivalue << choiceWidget;
 
         if(data.edata.connected) {
-            QStringList stringlist = String.split((QChar)27);
+            QStringList stringlist = splitStrings(data, String);
             // set enum strings
             if(data.edata.fieldtype == caENUM) {
                 // at initialisatioon or when list changes
@@ -4962,8 +5340,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
         choiceWidget->setAccessW(data.edata.accessW);
         updateAccessCursor(choiceWidget);
 
-        // caThermo ==================================================================================================================
-    } else if (caThermo *thermoWidget = qobject_cast<caThermo *>(w)) {
+        break;
+    }
+
+    // caThermo ==================================================================================================================
+    case Handler_caThermo: {
+        caThermo *thermoWidget = static_cast<caThermo *>(w);
         //qDebug() << "we have a thermometer";
 
         if(data.edata.connected) {
@@ -5005,8 +5387,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(thermoWidget);
         }
 
-        // caSlider ==================================================================================================================
-    } else if (caSlider *sliderWidget = qobject_cast<caSlider *>(w)) {
+        break;
+    }
+
+    // caSlider ==================================================================================================================
+    case Handler_caSlider: {
+        caSlider *sliderWidget = static_cast<caSlider *>(w);
 
         if(data.edata.connected) {
             bool highChannelLimitEnabled = false;
@@ -5061,8 +5447,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(sliderWidget);
         }
 
-        // caClock ==================================================================================================================
-    } else if (caClock *clockWidget = qobject_cast<caClock *>(w)) {
+        break;
+    }
+
+    // caClock ==================================================================================================================
+    case Handler_caClock: {
+        caClock *clockWidget = static_cast<caClock *>(w);
         if(data.edata.connected) {
             if(clockWidget->getTimeType() == caClock::ReceiveTime) {
                 clockWidget->setAlarmColors(data.edata.severity);
@@ -5078,8 +5468,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(clockWidget);
         }
 
-        // linear gauge (like thermometer) ==================================================================================================================
-    } else if (caLinearGauge *lineargaugeWidget = qobject_cast<caLinearGauge *>(w)) {
+        break;
+    }
+
+    // linear gauge (like thermometer) ==================================================================================================================
+    case Handler_caLinearGauge: {
+        caLinearGauge *lineargaugeWidget = static_cast<caLinearGauge *>(w);
         //qDebug() << "we have a linear gauge" << value;
         Q_UNUSED(lineargaugeWidget);
         EAbstractGauge *gauge =  qobject_cast<EAbstractGauge *>(w);
@@ -5090,8 +5484,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             if(gauge->isConnected()) gauge->setConnected(false);
         }
 
-        // circular gauge  ==================================================================================================================
-    } else if (caCircularGauge *circulargaugeWidget = qobject_cast<caCircularGauge *>(w)) {
+        break;
+    }
+
+    // circular gauge  ==================================================================================================================
+    case Handler_caCircularGauge: {
+        caCircularGauge *circulargaugeWidget = static_cast<caCircularGauge *>(w);
         //qDebug() << "we have a linear gauge" << value;
         Q_UNUSED(circulargaugeWidget);
         EAbstractGauge *gauge =  qobject_cast<EAbstractGauge *>(w);
@@ -5102,8 +5500,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             if(gauge->isConnected()) gauge->setConnected(false);
         }
 
-        // simple meter ==================================================================================================================
-    } else if (caMeter *meterWidget = qobject_cast<caMeter *>(w)) {
+        break;
+    }
+
+    // simple meter ==================================================================================================================
+    case Handler_caMeter: {
+        caMeter *meterWidget = static_cast<caMeter *>(w);
         //qDebug() << "we have a simple meter";
 
         if(data.edata.connected) {
@@ -5120,14 +5522,18 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(meterWidget);
         }
 
-        // byte ==================================================================================================================
-    } else if (caByte *byteWidget = qobject_cast<caByte *>(w)) {
+        break;
+    }
+
+    // byte ==================================================================================================================
+    case Handler_caByte: {
+        caByte *byteWidget = static_cast<caByte *>(w);
 
         if(data.edata.connected) {
             int colorMode = byteWidget->getColorMode();
             if(colorMode == caByte::Static) {
-                if(!byteWidget->property("Connect").value<bool>()) {
-                    byteWidget->setProperty("Connect", true);
+                if(!WidgetBinding::isConnected(byteWidget)) {
+                    WidgetBinding::attach(byteWidget)->connected = true;
                 }
                 byteWidget->setValue(data.edata.ivalue);
             } else if(colorMode == caByte::Alarm) {
@@ -5138,14 +5544,18 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(byteWidget);
         }
 
-        // byte ==================================================================================================================
-    } else if (caByteController *bytecontrollerWidget = qobject_cast<caByteController *>(w)) {
+        break;
+    }
+
+    // byte ==================================================================================================================
+    case Handler_caByteController: {
+        caByteController *bytecontrollerWidget = static_cast<caByteController *>(w);
 
         if(data.edata.connected) {
             int colorMode = bytecontrollerWidget->getColorMode();
             if(colorMode == caByteController::Static) {
-                if(!bytecontrollerWidget->property("Connect").value<bool>()) {
-                    bytecontrollerWidget->setProperty("Connect", true);
+                if(!WidgetBinding::isConnected(bytecontrollerWidget)) {
+                    WidgetBinding::attach(bytecontrollerWidget)->connected = true;
                 }
                 bytecontrollerWidget->setValue(data.edata.ivalue);
             } else if(colorMode == caByteController::Alarm) {
@@ -5156,11 +5566,15 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(bytecontrollerWidget);
         }
 
-       // replacemacro ==================================================================================================================
-     } else if(replaceMacro* replaceMacroWidget = qobject_cast<replaceMacro *>(w)) {
+        break;
+    }
+
+    // replacemacro ==================================================================================================================
+    case Handler_replaceMacro: {
+        replaceMacro *replaceMacroWidget = static_cast<replaceMacro *>(w);
 
         if(data.edata.connected) {
-            QStringList stringlist = String.split((QChar)27);
+            QStringList stringlist = splitStrings(data, String);
             // set enum strings
             if(data.edata.fieldtype == caENUM) {
                 // at initialisation or when list changes
@@ -5173,8 +5587,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(replaceMacroWidget);
         }
 
-        // lineEdit and textEntry ====================================================================================================
-    } else if (caLineEdit *lineeditWidget = qobject_cast<caLineEdit *>(w)) {
+        break;
+    }
+
+    // lineEdit and textEntry ====================================================================================================
+    case Handler_caLineEdit: {
+        caLineEdit *lineeditWidget = static_cast<caLineEdit *>(w);
 
         //qDebug() << "we have a linedit or textentry" << lineeditWidget << data.edata.rvalue <<  data.edata.ivalue;
 
@@ -5194,14 +5612,14 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
                 lineeditWidget->setValueType(false);
                 int colorMode = lineeditWidget->getColorMode();
                 if(colorMode == caLineEdit::Static || colorMode == caLineEdit::Default) { // done at initialisation
-                    if(!lineeditWidget->property("Connect").value<bool>()) {                    // but was disconnected before
+                    if(!WidgetBinding::isConnected(lineeditWidget)) {                    // but was disconnected before
                         lineeditWidget->setAlarmColors(data.edata.severity, (double) data.edata.ivalue, bg, fg);
-                        lineeditWidget->setProperty("Connect", true);
+                        WidgetBinding::attach(lineeditWidget)->connected = true;
                     }
                 } else {
                     lineeditWidget->setAlarmColors(data.edata.severity, (double) data.edata.ivalue, bg, fg);
                 }
-                list = String.split((QChar)27);
+                list = splitStrings(data, String);
 
                 //qDebug() << lineeditWidget << String << list << data.pv << (int) data.edata.ivalue << data.edata.valueCount;
 
@@ -5258,7 +5676,7 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
                 lineeditWidget->setValueType(true);
 
                 if(colorMode == caLineEdit::Static || colorMode == caLineEdit::Default) { // done at initialisation
-                    if(!lineeditWidget->property("Connect").value<bool>()) {                      // but was disconnected before
+                    if(!WidgetBinding::isConnected(lineeditWidget)) {                      // but was disconnected before
                         switch (data.edata.fieldtype){
                             case caINT:
                             case caLONG:{
@@ -5269,7 +5687,7 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
                                 lineeditWidget->setAlarmColors(data.edata.severity, data.edata.rvalue, bg, fg);
                             }
                         }
-                        lineeditWidget->setProperty("Connect", true);
+                        WidgetBinding::attach(lineeditWidget)->connected = true;
                     }
                 } else {
                     switch (data.edata.fieldtype){
@@ -5315,7 +5733,7 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             lineeditWidget->setValueType(false);
             lineeditWidget->setTextLine("");
             lineeditWidget->setAlarmColors(NOTCONNECTED, 0.0, bg, fg);        \
-            lineeditWidget->setProperty("Connect", false);
+            WidgetBinding::attach(lineeditWidget)->connected = false;
         }
 
         if(data.edata.connected) {
@@ -5324,8 +5742,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             }
         }
 
-        // multilinestring ====================================================================================================
-    } else if (caMultiLineString *multilinestringWidget = qobject_cast<caMultiLineString *>(w)) {
+        break;
+    }
+
+    // multilinestring ====================================================================================================
+    case Handler_caMultiLineString: {
+        caMultiLineString *multilinestringWidget = static_cast<caMultiLineString *>(w);
 
         //qDebug() << "we have a multilinedit" << multilinestringWidget << data.edata.rvalue <<  data.edata.ivalue;
 
@@ -5341,9 +5763,9 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
 
                 int colorMode = multilinestringWidget->getColorMode();
                 if(colorMode == caMultiLineString::Static || colorMode == caMultiLineString::Default) { // done at initialisation
-                    if(!multilinestringWidget->property("Connect").value<bool>()) {                    // but was disconnected before
+                    if(!WidgetBinding::isConnected(multilinestringWidget)) {                    // but was disconnected before
                         multilinestringWidget->setAlarmColors(data.edata.severity, (double) data.edata.ivalue, bg, fg);
-                        multilinestringWidget->setProperty("Connect", true);
+                        WidgetBinding::attach(multilinestringWidget)->connected = true;
                     }
                 } else {
                     multilinestringWidget->setAlarmColors(data.edata.severity, (double) data.edata.ivalue, bg, fg);
@@ -5377,23 +5799,27 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
         } else {
             multilinestringWidget->setTextLine("");
             multilinestringWidget->setAlarmColors(NOTCONNECTED, 0.0, bg, fg);        \
-            multilinestringWidget->setProperty("Connect", false);
+            WidgetBinding::attach(multilinestringWidget)->connected = false;
         }
 
-        // Graphics ==================================================================================================================
-    } else if (caGraphics *graphicsWidget = qobject_cast<caGraphics *>(w)) {
+        break;
+    }
+
+    // Graphics ==================================================================================================================
+    case Handler_caGraphics: {
+        caGraphics *graphicsWidget = static_cast<caGraphics *>(w);
         //qDebug() << "caGraphics" << graphicsWidget->objectName() << graphicsWidget->getColorMode() << data.pv;
 
         if(data.edata.connected) {
             int colorMode = graphicsWidget->getColorMode();
             if(colorMode == caGraphics::Static) {
                 // done at initialisation, we have to set it back after no connect
-                if(!graphicsWidget->property("Connect").value<bool>()) {
+                if(!WidgetBinding::isConnected(graphicsWidget)) {
                     QColor fg = graphicsWidget->property("FColor").value<QColor>();
                     QColor lg = graphicsWidget->property("LColor").value<QColor>();
                     graphicsWidget->setForeground(fg);
                     graphicsWidget->setLineColor(lg);
-                    graphicsWidget->setProperty("Connect", true);
+                    WidgetBinding::attach(graphicsWidget)->connected = true;
                 }
             } else if(colorMode == caGraphics::Alarm) {
                 short status = ComputeAlarm(w);
@@ -5406,19 +5832,23 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(graphicsWidget);
         }
 
-        // Polyline ==================================================================================================================
-    } else if (caPolyLine *polylineWidget = qobject_cast<caPolyLine *>(w)) {
+        break;
+    }
+
+    // Polyline ==================================================================================================================
+    case Handler_caPolyLine: {
+        caPolyLine *polylineWidget = static_cast<caPolyLine *>(w);
 
         if(data.edata.connected) {
             int colorMode = polylineWidget->getColorMode();
             if(colorMode == caPolyLine::Static) {
                 // done at initialisation, we have to set it back after no connect
-                if(!polylineWidget->property("Connect").value<bool>()) {
+                if(!WidgetBinding::isConnected(polylineWidget)) {
                     QColor fg = polylineWidget->property("FColor").value<QColor>();
                     QColor lg = polylineWidget->property("LColor").value<QColor>();
                     polylineWidget->setForeground(fg);
                     polylineWidget->setLineColor(lg);
-                    polylineWidget->setProperty("Connect", true);
+                    WidgetBinding::attach(polylineWidget)->connected = true;
                 }
             } else if(colorMode == caPolyLine::Alarm) {
                 short status = ComputeAlarm(w);
@@ -5431,8 +5861,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(polylineWidget);
         }
 
-        // Led ==================================================================================================================
-    } else if (caLed *ledWidget = qobject_cast<caLed *>(w)) {
+        break;
+    }
+
+    // Led ==================================================================================================================
+    case Handler_caLed: {
+        caLed *ledWidget = static_cast<caLed *>(w);
         //qDebug() << "led" << led->objectName();
         Qt::CheckState state = Qt::Unchecked;
 
@@ -5448,8 +5882,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             ledWidget->setAlarmColors(NOTCONNECTED);
         }
 
-        // ApplyNumeric and Numeric =====================================================================================================
-    } else if (caApplyNumeric *applynumericWidget = qobject_cast<caApplyNumeric *>(w)) {
+        break;
+    }
+
+    // ApplyNumeric and Numeric =====================================================================================================
+    case Handler_caApplyNumeric: {
+        caApplyNumeric *applynumericWidget = static_cast<caApplyNumeric *>(w);
         //qDebug() << "caApplyNumeric" << applynumericWidget->objectName() << data.pv << data.edata.monitorCount;
 
         if(data.edata.connected) {
@@ -5477,8 +5915,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             applynumericWidget->setConnectedColors(false);
         }
 
-        // Numeric =====================================================================================================
-    } else if (caNumeric *numericWidget = qobject_cast<caNumeric *>(w)) {
+        break;
+    }
+
+    // Numeric =====================================================================================================
+    case Handler_caNumeric: {
+        caNumeric *numericWidget = static_cast<caNumeric *>(w);
         // qDebug() << "caNumeric" << numericWidget->objectName() << data.pv;
 
         if(data.edata.connected) {
@@ -5507,8 +5949,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             numericWidget->setConnectedColors(false);
         }
 
-        // Numeric =====================================================================================================
-    } else if (caSpinbox *spinboxWidget = qobject_cast<caSpinbox *>(w)) {
+        break;
+    }
+
+    // Numeric =====================================================================================================
+    case Handler_caSpinbox: {
+        caSpinbox *spinboxWidget = static_cast<caSpinbox *>(w);
         //qDebug() << "caSpinbox" << spinboxWidget->objectName() << data.pv;
 
         if(data.edata.connected) {
@@ -5535,8 +5981,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             spinboxWidget->setConnectedColors(false);
         }
 
-        // Toggle =====================================================================================================
-    } else if (caToggleButton *togglebuttonWidget = qobject_cast<caToggleButton *>(w)) {
+        break;
+    }
+
+    // Toggle =====================================================================================================
+    case Handler_caToggleButton: {
+        caToggleButton *togglebuttonWidget = static_cast<caToggleButton *>(w);
         //qDebug() << "caToggleButton" << togglebuttonWidget->objectName() << data.pv;
         Qt::CheckState state = Qt::Unchecked;
 
@@ -5556,8 +6006,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             SetColorsNotConnected(togglebuttonWidget);
         }
 
-        // cartesian plot ==================================================================================================================
-    } else if (caCartesianPlot *cartesianplotWidget = qobject_cast<caCartesianPlot *>(w)) {
+        break;
+    }
+
+    // cartesian plot ==================================================================================================================
+    case Handler_caCartesianPlot: {
+        caCartesianPlot *cartesianplotWidget = static_cast<caCartesianPlot *>(w);
         //qDebug() << "caCartesianPlot" << cartesianplotWidget->objectName() << data.pv << data.specData[0] << data.specData[1]  << data.specData[2];
 
         int curvNB = data.specData[0];    // curve or scale number
@@ -5603,8 +6057,8 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
                 // qDebug() << "scale monitor from" << data.pv << data.edata.rvalue << "min/max" << data.specData[0] << "scale" << XorY;
             }
 
-            if(!cartesianplotWidget->property("Connect").value<bool>()) {
-                cartesianplotWidget->setProperty("Connect", true);
+            if(!WidgetBinding::isConnected(cartesianplotWidget)) {
+                WidgetBinding::attach(cartesianplotWidget)->connected = true;
                 cartesianplotWidget->setAllProperties();
             }
 
@@ -5646,11 +6100,15 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
         } else if(strstr(data.pluginName, "archive") == (char*) Q_NULLPTR) {
             cartesianplotWidget->setCountNumber(0);
             cartesianplotWidget->setWhiteColors();
-            cartesianplotWidget->setProperty("Connect", false);
+            WidgetBinding::attach(cartesianplotWidget)->connected = false;
         }
 
-        // waterfall plot ==================================================================================================================
-    } else if (caWaterfallPlot *waterfallplotWidget = qobject_cast<caWaterfallPlot *>(w)) {
+        break;
+    }
+
+    // waterfall plot ==================================================================================================================
+    case Handler_caWaterfallPlot: {
+        caWaterfallPlot *waterfallplotWidget = static_cast<caWaterfallPlot *>(w);
         //qDebug() << "caWaterfallPlot" << waterfallplotWidget->objectName() << data.pv;
 
         int pvType = data.specData[0];      // waveform=0; Count=1
@@ -5708,8 +6166,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
 
         }
 
-        // stripchart ==================================================================================================================
-    } else if(caStripPlot *stripplotWidget = qobject_cast<caStripPlot *>(w)) {
+        break;
+    }
+
+    // stripchart ==================================================================================================================
+    case Handler_caStripPlot: {
+        caStripPlot *stripplotWidget = static_cast<caStripPlot *>(w);
 
         int actPlot= data.specData[1];
         if(data.edata.connected) {
@@ -5749,8 +6211,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
 
         }
 
-        // animated gif ==================================================================================================================
-    } else if(caImage *imageWidget = qobject_cast<caImage *>(w)) {
+        break;
+    }
+
+    // animated gif ==================================================================================================================
+    case Handler_caImage: {
+        caImage *imageWidget = static_cast<caImage *>(w);
 
         double valueArray[MAX_CALC_INPUTS];
         char post[calcstring_length];
@@ -5779,9 +6245,8 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             return;
         } else {
             // any monitors ?
-            QVariant var=imageWidget->property("MonitorList");
-            QVariantList list = var.toList();
-            int nbMonitors = list.at(0).toInt();
+            WidgetBinding *binding = WidgetBinding::get(imageWidget);
+            int nbMonitors = (binding != (WidgetBinding *) Q_NULLPTR) ? binding->monitors.size() : 0;
             //qDebug() << image << "number of monitors" << nbMonitors;
             if(nbMonitors > 0)  {
 
@@ -5792,7 +6257,7 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
                 // scan and get the channels
                 for(int i=0; i < 4; i++) valueArray[i] = 0.0;
                 for(int i=0; i< nbMonitors;i++) {
-                    knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(list.at(i+1).toInt());
+                    knobData *ptr = mutexKnobDataP->GetMutexKnobDataPtr(binding->monitors.at(i));
                     if(ptr != (knobData *) Q_NULLPTR) {
                         // when connected
                         if(ptr->edata.connected) {
@@ -5831,8 +6296,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             }
         }
 
-        // table with pv name, value and unit==========================================================================
-    } else if(caTable *tableWidget = qobject_cast<caTable *>(w)) {
+        break;
+    }
+
+    // table with pv name, value and unit==========================================================================
+    case Handler_caTable: {
+        caTable *tableWidget = static_cast<caTable *>(w);
 
         int row= data.specData[0];
 
@@ -5858,8 +6327,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             tableWidget->displayText(row, 2, NOTCONNECTED, "NC");
         }
 
-        // table for waveform values==========================================================================
-    } else if(caWaveTable *wavetableWidget = qobject_cast<caWaveTable *>(w)) {
+        break;
+    }
+
+    // table for waveform values==========================================================================
+    case Handler_caWaveTable: {
+        caWaveTable *wavetableWidget = static_cast<caWaveTable *>(w);
 
         if(data.edata.connected) {
             // data from vector
@@ -5884,7 +6357,7 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
                 }
             } else if(data.specData[0] == 1) {
                 QStringList list;
-                list = String.split((QChar)27);
+                list = splitStrings(data, String);
                 // here we have to be carefull, while a waveform will give you an index to
                 // a list ("STRING", "CHAR", "UCHAR", "SHORT", "USHORT", "LONG", "ULONG", "FLOAT", "DOUBLE", "ENUM")
                 // however it could be something else
@@ -5901,8 +6374,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             wavetableWidget->setStringList(list, NOTCONNECTED, list.size());
         }
 
-        // bitnames table with text and coloring according the value=========================================================
-    } else if (caBitnames *bitnamesWidget = qobject_cast<caBitnames *>(w)) {
+        break;
+    }
+
+    // bitnames table with text and coloring according the value=========================================================
+    case Handler_caBitnames: {
+        caBitnames *bitnamesWidget = static_cast<caBitnames *>(w);
         if(data.edata.connected) {
             // set enum strings
             if(data.edata.fieldtype == caENUM) {
@@ -5916,8 +6393,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             // todo
         }
 
-        // camera =========================================================
-    } else if (caCamera *cameraWidget = qobject_cast<caCamera *>(w)) {
+        break;
+    }
+
+    // camera =========================================================
+    case Handler_caCamera: {
+        caCamera *cameraWidget = static_cast<caCamera *>(w);
 
         //qDebug() << data.pv << data.edata.connected << data.specData[0];
         if(data.edata.connected) {
@@ -5971,8 +6452,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             // todo
         }
 
-        // scan2d =========================================================
-    } else if (caScan2D *scan2dWidget = qobject_cast<caScan2D *>(w)) {
+        break;
+    }
+
+    // scan2d =========================================================
+    case Handler_caScan2D: {
+        caScan2D *scan2dWidget = static_cast<caScan2D *>(w);
 
         //qDebug() << "Callback_UpdateWidget: caScan2D" << data.pv << data.edata.connected << data.specData[0];
         if (data.edata.connected) {
@@ -6016,8 +6501,12 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
             //scan2dWidget->showDisconnected();
         }
 
-        // messagebutton, yust treat access ==========================================================================
-    } else if (caMessageButton *messagebuttonWidget = qobject_cast<caMessageButton *>(w)) {
+        break;
+    }
+
+    // messagebutton, yust treat access ==========================================================================
+    case Handler_caMessageButton: {
+        caMessageButton *messagebuttonWidget = static_cast<caMessageButton *>(w);
 
         if(data.edata.connected) {
 
@@ -6042,12 +6531,32 @@ void CaQtDM_Lib::Callback_UpdateWidget(int indx, QWidget *w,
         messagebuttonWidget->setAccessW((bool) data.edata.accessW);
         updateAccessCursor(messagebuttonWidget);
 
-        // something else (user defined monitors with non ca imageWidgets ?) ==============================================
-    } else {
+        break;
+    }
+
+    // something else (user defined monitors with non ca imageWidgets ?) ==============================================
+    default:
         qDebug() << "unrecognized widget" << w->metaObject()->className();
+        break;
     }
 }
 
+/**
+ * timing of the widget updates in microseconds, used for benchmarking
+ */
+void CaQtDM_Lib::setUpdateTiming(bool enable)
+{
+    updateTimingEnabled = enable;
+    updateTimings.clear();
+}
+
+QVector<float> CaQtDM_Lib::getUpdateTimings(bool clear)
+{
+    QVector<float> timings = updateTimings;
+    if(clear) updateTimings.clear();
+    return timings;
+}
+
 void CaQtDM_Lib::Cartesian(caCartesianPlot *widget, int curvNB, int curvType, int XorY, const knobData &data)
 {
     QMutex *datamutex;
@@ -6241,6 +6750,18 @@ void CaQtDM_Lib::WaterFall(caWaterfallPlot *widget, const knobData &data)
     }
 }
 
+/**
+ * split the strings delivered with the data, the enum strings are split once and shared by all the slots of the pv
+ */
+QStringList CaQtDM_Lib::splitStrings(const knobData &data, const QString &String)
+{
+    if(data.edata.fieldtype == caENUM) {
+        ChannelMetadata *metadata = mutexKnobDataP->GetMutexKnobDataMetadata(data.index);
+        if(metadata != (ChannelMetadata*) Q_NULLPTR) return metadata->enumStrings(String);
+    }
+    return String.split((QChar)27);
+}
+
 void CaQtDM_Lib::getStatesToggleAndLed(QWidget *widget, const knobData &data, const QString &String, Qt::CheckState &state)
 {
     QString trueString, falseString;
@@ -6280,7 +6801,7 @@ void CaQtDM_Lib::getStatesToggleAndLed(QWidget *widget, const knobData &data, co
 
         QString str = "";
         QStringList list;
-        list = String.split((QChar)27);
+        list = splitStrings(data, String);
 
         if((int) data.edata.ivalue < list.count()  && (list.count() > 0))  str = list.at((int) data.edata.ivalue);
 
@@ -6338,7 +6859,7 @@ void CaQtDM_Lib::Callback_EApplyNumeric(double value)
     caApplyNumeric *numeric = qobject_cast<caApplyNumeric *>(sender());
     if(!numeric->getAccessW()) return;
     if(numeric->getPV().length() > 0) {
-        TreatOrdinaryValue(numeric->getPV(), rdata,  idata, "", (QWidget*) numeric);
+        TreatOrdinaryValue(numeric->getPV(), rdata,  idata, "", (QWidget*) numeric, WritePipeline::NoCoalesce);
     }
 }
 /**
@@ -6352,7 +6873,7 @@ void CaQtDM_Lib::Callback_ENumeric(double value)
     caNumeric *numeric = qobject_cast<caNumeric *>(sender());
     if(!numeric->getAccessW()) return;
     if(numeric->getPV().length() > 0) {
-        TreatOrdinaryValue(numeric->getPV(), rdata,  idata, "", (QWidget*) numeric);
+        TreatOrdinaryValue(numeric->getPV(), rdata,  idata, "", (QWidget*) numeric, WritePipeline::Coalesce);
     }
 }
 
@@ -6367,7 +6888,7 @@ void CaQtDM_Lib::Callback_Spinbox(double value)
     caSpinbox *numeric = qobject_cast<caSpinbox *>(sender());
     if(!numeric->getAccessW()) return;
     if(numeric->getPV().length() > 0) {
-        TreatOrdinaryValue(numeric->getPV(), rdata,  idata, "", (QWidget*) numeric);
+        TreatOrdinaryValue(numeric->getPV(), rdata,  idata, "", (QWidget*) numeric, WritePipeline::Coalesce);
     }
 }
 
@@ -6379,7 +6900,7 @@ void CaQtDM_Lib::Callback_SliderValueChanged(double value)
     caSlider *numeric = qobject_cast<caSlider *>(sender());
     if(!numeric->getAccessW()) return;
     if(numeric->getPV().length() > 0) {
-        TreatOrdinaryValue(numeric->getPV(), rdata, idata,  "", (QWidget*) numeric);
+        TreatOrdinaryValue(numeric->getPV(), rdata, idata,  "", (QWidget*) numeric, WritePipeline::Coalesce);
     }
 }
 
@@ -6416,7 +6937,7 @@ void CaQtDM_Lib::Callback_ToggleButton(bool type)
     }
 
     if(w->getPV().length() > 0) {
-        TreatOrdinaryValue(w->getPV(), rvalue, ivalue, svalue, (QWidget*) w);
+        TreatOrdinaryValue(w->getPV(), rvalue, ivalue, svalue, (QWidget*) w, WritePipeline::NoCoalesce);
     }
 }
 
@@ -6435,8 +6956,6 @@ void CaQtDM_Lib::Callback_UpdateLine(const QString& text, const QString& name)
  */
 void CaQtDM_Lib::Callback_ChoiceClicked(const QString& text)
 {
-    char errmess[SMALL_STRING_LENGTH];
-
     caChoice *choice = qobject_cast<caChoice *>(sender());
 
     choice->updateChoice();
@@ -6451,9 +6970,7 @@ void CaQtDM_Lib::Callback_ChoiceClicked(const QString& text)
         if(plugininterface != (ControlsInterface *) Q_NULLPTR) {
             knobData *kPtr;
             if((kPtr = GetMutexKnobDataPV((QWidget*) choice, param1)) != (knobData *) Q_NULLPTR) {
-                if(!plugininterface->pvSetValue(kPtr, 0.0, 0, param2, param3, errmess, 0)) {
-                    plugininterface->pvSetValue(param1, 0.0, 0, param2, param3, errmess, 0);
-                }
+                WritePipeline::instance()->put(mutexKnobDataP, plugininterface, kPtr, param1, 0.0, 0, param2, param3, 0, WritePipeline::NoCoalesce);
             }
         }
     }
@@ -6464,7 +6981,6 @@ void CaQtDM_Lib::Callback_ChoiceClicked(const QString& text)
  */
 void CaQtDM_Lib::Callback_MenuClicked(const QString& text)
 {
-    char errmess[SMALL_STRING_LENGTH];
     caMenu *menu = qobject_cast<caMenu *>(sender());
 
     if(!menu->getAccessW()) return;
@@ -6476,9 +6992,7 @@ void CaQtDM_Lib::Callback_MenuClicked(const QString& text)
         if(plugininterface != (ControlsInterface *) Q_NULLPTR) {
             knobData *kPtr;
             if((kPtr = GetMutexKnobDataPV((QWidget*) menu, param1)) != (knobData *) Q_NULLPTR) {
-                if(!plugininterface->pvSetValue(kPtr, 0.0, 0, param2, param3, errmess, 0)) {
-                    plugininterface->pvSetValue(param1, 0.0, 0, param2, param3, errmess, 0);
-                }
+                WritePipeline::instance()->put(mutexKnobDataP, plugininterface, kPtr, param1, 0.0, 0, param2, param3, 0, WritePipeline::NoCoalesce);
             }
         }
     }
@@ -6517,15 +7031,11 @@ void CaQtDM_Lib::Callback_WaveEntryChanged(const QString& text, int index)
 }
 
 /**
- * callback will call the specified ui file
+ * the macro arguments of the displays of a caRelatedDisplay, with the macros read from files and the replacements applied
  */
-void CaQtDM_Lib::Callback_RelatedDisplayClicked(int indx)
+QStringList CaQtDM_Lib::relatedDisplayArgs(caRelatedDisplay *w, bool verbose)
 {
-    caRelatedDisplay *w = qobject_cast<caRelatedDisplay *>(sender());
-    QStringList files = w->getFiles().split(";");
     QStringList args = w->getArgs().split(";");
-    QStringList removeParents = w->getReplaceModes().split(";");
-
 
     // special case where macros are coming from a macro definition file
     // when specified with %(read filename) in the argument list
@@ -6555,11 +7065,11 @@ void CaQtDM_Lib::Callback_RelatedDisplayClicked(int indx)
                     char asc[MAX_STRING_LENGTH];
                     if(fileNameFound.isNull()) {
                         snprintf(asc, MAX_STRING_LENGTH, "macro definition file %s could not be loaded for related display", qasc(macroFile));
-                        postMessage(QtCriticalMsg, asc);
+                        if(verbose) postMessage(QtCriticalMsg, asc);
                     }
                     else {
                         snprintf(asc, MAX_STRING_LENGTH, "macro definition file %s loaded for related display", qasc(macroFile));
-                        postMessage(QtWarningMsg, asc);
+                        if(verbose) postMessage(QtWarningMsg, asc);
                         QFile file(fileNameFound);
                         file.open(QFile::ReadOnly);
                         QString macroString = QLatin1String(file.readAll());
@@ -6577,7 +7087,6 @@ void CaQtDM_Lib::Callback_RelatedDisplayClicked(int indx)
         args[j] = macro_list_expanded.join(",");
     }
 
-    //qDebug() << "files:" << files;
     //qDebug() << "args" <<  w->getArgs() << args;
 
     // get global macro, replace specified keys and build the macro string of caRelatedDisplay, but
@@ -6597,6 +7106,22 @@ void CaQtDM_Lib::Callback_RelatedDisplayClicked(int indx)
         }
     }
 
+    return args;
+}
+
+/**
+ * callback will call the specified ui file
+ */
+void CaQtDM_Lib::Callback_RelatedDisplayClicked(int indx)
+{
+    caRelatedDisplay *w = qobject_cast<caRelatedDisplay *>(sender());
+    QStringList files = w->getFiles().split(";");
+    QStringList args = relatedDisplayArgs(w, true);
+    QStringList removeParents = w->getReplaceModes().split(";");
+
+    // a display prepared while the pointer was on the button
+    if(indx < files.count()) DisplayPreloader::instance()->requested(files[indx].trimmed(), (indx < args.count()) ? args[indx].trimmed() : "");
+
     // find position of this window
     int xpos = this->pos().x();
     int ypos = this->pos().y();
@@ -6666,11 +7191,11 @@ void CaQtDM_Lib::Callback_ByteControllerClicked(int bit)
     // bit set
     if(w->bitState(w->getValue(), bit)) {
         number &= ~(1 << bit);
-        TreatOrdinaryValue(w->getPV(), (double) number, (int32_t) number, "",  w1);
+        TreatOrdinaryValue(w->getPV(), (double) number, (int32_t) number, "",  w1, WritePipeline::NoCoalesce);
         // bit not set
     } else {
         number |= 1 << bit;
-        TreatOrdinaryValue(w->getPV(), (double) number, (int32_t) number, "",  w1);
+        TreatOrdinaryValue(w->getPV(), (double) number, (int32_t) number, "",  w1, WritePipeline::NoCoalesce);
     }
 }
 
@@ -6808,7 +7333,7 @@ void CaQtDM_Lib::shellCommand(QString command) {
 
     if(command.contains("&D")) {
         QStringList pv_list;
-        for (int i=0; i < mutexKnobDataP->GetMutexKnobDataSize(); i++) {
+        foreach(int i, mutexKnobDataP->GetMutexKnobDataWindowSlots(myWidget)) {
             knobData kData = mutexKnobDataP->GetMutexKnobData(i);
             if((kData.index != -1) && (myWidget == (QWidget*) kData.thisW)) {
                 QString pv = kData.pv;
@@ -6888,9 +7413,21 @@ void CaQtDM_Lib::closeEvent(QCloseEvent* ce)
 
     killTimer(loopTimerID);
 
+    if(visibilityTracker != (VisibilityTracker *) Q_NULLPTR) {
+        delete visibilityTracker;
+        visibilityTracker = (VisibilityTracker *) Q_NULLPTR;
+    }
+
     AllowsUpdate = false;
 
-    for(int i=0; i < mutexKnobDataP->GetMutexKnobDataSize(); i++) {
+    if(updateProfilingEnabled) {
+        printf("caQtDM_Lib -- update profile of %s\n%s", qasc(thisFileShort), qasc(getUpdateProfile(false)));
+        fflush(stdout);
+    }
+
+    // only the slots of this window have to be looked at
+    QList<int> windowSlots = mutexKnobDataP->GetMutexKnobDataWindowSlots(myWidget);
+    foreach(int i, windowSlots) {
 
         knobData kData =  mutexKnobDataP->GetMutexKnobData(i);
 
@@ -6901,6 +7438,9 @@ void CaQtDM_Lib::closeEvent(QCloseEvent* ce)
             //qDebug() << pv << "clear monitor at" << i << "index="  << kData.index << "plugin" << kData.pluginName;
             if(soft) {
                 mutexKnobDataP->RemoveSoftPV(pv, w, kData.index);
+            } else if(mutexKnobDataP->LingerMutexKnobDataSlot(i)) {
+                // stays connected for a while, a display opened again takes it over
+                continue;
             } else {
                ControlsInterface * plugininterface = getControlInterface(kData.pluginName);
                if(plugininterface != (ControlsInterface *) 0) plugininterface->pvClearMonitor(&kData);
@@ -6911,23 +7451,15 @@ void CaQtDM_Lib::closeEvent(QCloseEvent* ce)
         }
     }
 
-    Sleep::msleep(200);
-
     // get rid of memory that was allocated before for this window.
-    // it has not been done previously, while otherwise in the datacallback
-    // you can run into trouble
-    for(int i=0; i < mutexKnobDataP->GetMutexKnobDataSize(); i++) {
+    // a data callback could still be running, so this is done later by the timer of mutexKnobData
+    // and the slots can then be used again
+    foreach(int i, windowSlots) {
         knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(i);
         if(kPtr != (knobData *) Q_NULLPTR) {
             if(myWidget == (QWidget*) kPtr->thisW) {
-                ControlsInterface * plugininterface = getControlInterface(kPtr->pluginName);
-                if(plugininterface != (ControlsInterface *) 0) plugininterface->pvFreeAllocatedData(kPtr);
-                kPtr->thisW = (void*) Q_NULLPTR;
-                if(kPtr->mutex != (QMutex *) Q_NULLPTR) {
-                    QMutex *mutex = (QMutex *) kPtr->mutex;
-                    delete mutex;
-                    kPtr->mutex = (QMutex *) Q_NULLPTR;
-                }
+                mutexKnobDataP->RetireMutexKnobDataSlot(i, getControlInterface(kPtr->pluginName));
+                clearUpdateHandler(i);
             }
         }
     }
@@ -7010,11 +7542,11 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
     }
 
     // get the monitor list back for this widget
-    QVariant monitorList=w->property("MonitorList");
-    QVariantList MonitorList = monitorList.toList();
+    QVector<int> monitors;
+    WidgetBinding *binding = WidgetBinding::get(w);
+    if(binding != (WidgetBinding *) Q_NULLPTR) monitors = binding->monitors;
 
-    int nbMonitors = 0;
-    if(MonitorList.size() > 0) nbMonitors = MonitorList.at(0).toInt();
+    int nbMonitors = monitors.size();
 
     if(caWidgetInterface* wif = dynamic_cast<caWidgetInterface *>(w)) {   // any caWidget with caWidgetInterface
         QString pv[20];
@@ -7024,10 +7556,9 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
         for(int i=0; i<nbMonitors; i++) {
             knobData *kPtr =  mutexKnobDataP->getMutexKnobDataPV(w, pv[i]);
             if(kPtr != (knobData*) Q_NULLPTR) {
-            MonitorList.append(kPtr->index);
+            monitors.append(kPtr->index);
         }
         }
-        MonitorList.insert(0, nbMonitors);
 
     } else if(caImage* imageWidget = qobject_cast<caImage *>(w)) {
         GetDefinedCalcString(caImage, imageWidget, calcString);
@@ -7086,7 +7617,7 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
             precMode = true;
             Precision = applynumericWidget->decDigits();
         } else if(nbMonitors > 0) {
-            dataIndex = MonitorList.at(1).toInt();
+            dataIndex = monitors.at(0);
             knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(dataIndex);
             if(kPtr != (knobData *) Q_NULLPTR) Precision =  kPtr->edata.precision;
         }
@@ -7096,7 +7627,7 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
             precMode = true;
             Precision = numericWidget->decDigits();
         } else if(nbMonitors > 0) {
-            dataIndex = MonitorList.at(1).toInt();
+            dataIndex = monitors.at(0);
             knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(dataIndex);
             if(kPtr != (knobData *) Q_NULLPTR) Precision =  kPtr->edata.precision;
         }
@@ -7106,7 +7637,7 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
             precMode = true;
             Precision = spinboxWidget->decDigits();
         } else if(nbMonitors > 0) {
-            dataIndex = MonitorList.at(1).toInt();
+            dataIndex = monitors.at(0);
             knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(dataIndex);
             if(kPtr != (knobData *) Q_NULLPTR) Precision =  kPtr->edata.precision;
         }
@@ -7124,7 +7655,7 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
             precMode = true;
             Precision = sliderWidget->getPrecision();
         } else if(nbMonitors > 0) {
-            dataIndex = MonitorList.at(1).toInt();
+            dataIndex = monitors.at(0);
             knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(dataIndex);
             if(kPtr != (knobData *) Q_NULLPTR) Precision =  kPtr->edata.precision;
         }
@@ -7138,7 +7669,7 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
             limitsMin = thermoWidget->minValue();
         }
         if(nbMonitors > 0) {
-            dataIndex = MonitorList.at(1).toInt();
+            dataIndex = monitors.at(0);
             knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(dataIndex);
             if(kPtr != (knobData *) Q_NULLPTR) {
                if(kPtr->edata.lower_disp_limit == kPtr->edata.upper_disp_limit) {
@@ -7182,6 +7713,7 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
         myMenu.addAction(RELOADWINDOW);
         myMenu.addAction(RAISEWINDOW);
         myMenu.addAction(INCLUDES);
+        if(updateProfilingEnabled) myMenu.addAction(UPDATEPROFILE);
     }
 
     // add some more actions
@@ -7241,7 +7773,7 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
     if(caTextEntry* catextentryWidget = qobject_cast<caTextEntry *>(w)) {
         if(catextentryWidget->getAccessW()) {
             if(nbMonitors > 0) {
-                dataIndex = MonitorList.at(1).toInt();
+                dataIndex = monitors.at(0);
                 knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(dataIndex);
                 if((kPtr != (knobData *) Q_NULLPTR) && (strlen(kPtr->pv) > 0)) {
                     myMenu.addAction(INPUTDIALOG);
@@ -7344,6 +7876,16 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
             else if(caScan2D * scan2dWidget = qobject_cast< caScan2D *>(w)) scan2dWidget->setColormap(caScan2D::grey);
             else if(caWaterfallPlot * waterfallplotWidget = qobject_cast< caWaterfallPlot *>(w)) waterfallplotWidget->setColormap(caWaterfallPlot::grey);
 
+        } else  if(selectedItem->text().contains(UPDATEPROFILE)) {
+            QString info;
+            info.append("<div style='background-color:lightyellow; color:black; white-space: pre; font-family: monospace;'>");
+            info.append("<strong>update times of the widgets since the display was opened</strong><br><br>");
+            info.append(getUpdateProfile(true));
+            info.append(InfoPostfix);
+            myMessageBox box(this);
+            box.setText("<html>" + info + "</html>");
+            box.exec();
+
         } else  if(selectedItem->text().contains(INCLUDES)) {
             QString info;
             info.append(InfoPrefix);
@@ -7412,7 +7954,7 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
 
             for(int i=0; i< nbMonitors; i++) {
 
-                dataIndex = MonitorList.at(i+1).toInt();
+                dataIndex = monitors.at(i);
                 knobData *kPtr =  mutexKnobDataP->GetMutexKnobDataPtr(dataIndex);
 
                 if((kPtr != (knobData *) Q_NULLPTR)) {
@@ -7728,7 +8270,7 @@ void CaQtDM_Lib::DisplayContextMenu(QWidget* w)
                         if(selectedItem->text().contains(item[0])) {
                             QString command = item[1];
                             if(command.contains("&P") && nbMonitors > 0) {
-                                dataIndex = MonitorList.at(1).toInt();
+                                dataIndex = monitors.at(0);
                                 knobData *kPtr =  mutexKnobDataP->GetMutexKnobDataPtr(dataIndex);
                                 if(kPtr != (knobData *) 0) command.replace("&P", kPtr->pv);
                                 command.replace(".X", "");  // this is only to get rid of our pseudo extensions .X or .Y for the archive cartesian plot
@@ -7778,22 +8320,18 @@ void CaQtDM_Lib::ShowContextMenu(const QPoint& position) // this is a slot
 
     // when this widget has no monitors, it could be that an eventual underlying widget has monitors
     // get the monitor list back for this widget
-    QVariant monitorList = w->property("MonitorList");
-    QVariantList MonitorList = monitorList.toList();
-    int nbMonitors = 0;
+    WidgetBinding *binding = WidgetBinding::get(w);
+    int nbMonitors = (binding != (WidgetBinding *) Q_NULLPTR) ? binding->monitors.size() : 0;
     bool found = false;
 
-    if(MonitorList.size() > 0) nbMonitors = MonitorList.at(0).toInt();
-
     // no monitors, then find a first underlying ca widget with monitors
     if(nbMonitors == 0) {
         QList<QWidget*> wList;
         QPoint globalPos = qobject_cast< QWidget* >( sender() )->mapToGlobal( position );
         QWidget *widgetAt = qApp->widgetAt(globalPos);
         while (widgetAt != (QWidget *) Q_NULLPTR) {
-            monitorList=widgetAt->property("MonitorList");
-            MonitorList = monitorList.toList();
-            if(MonitorList.size() > 0) nbMonitors = MonitorList.at(0).toInt();
+            binding = WidgetBinding::get(widgetAt);
+            nbMonitors = (binding != (WidgetBinding *) Q_NULLPTR) ? binding->monitors.size() : 0;
             QString className = widgetAt->metaObject()->className();
             if((nbMonitors > 0) && (className.contains("ca")) && (widgetAt != w) && (!className.contains("caInclude")) && (!className.contains("caRel"))) {
                 DisplayContextMenu(widgetAt);
@@ -7971,36 +8509,28 @@ int CaQtDM_Lib::InitVisibility(QWidget* widget, knobData* kData, QMap<QString, Q
     /* set property into widget */
     if (caCalc *calcWidget = qobject_cast<caCalc *>(widget)) {
         calcWidget->setCalc(text);
-        calcWidget->setProperty("MonitorList", monitorList);
-        calcWidget->setProperty("IndexList", indexList);
+        WidgetBinding::attach(calcWidget)->setMonitors(monitorList, indexList);
     } else if (caImage *imageWidget = qobject_cast<caImage *>(widget)) {
         imageWidget->setVisibilityCalc(text);
-        imageWidget->setProperty("MonitorList", monitorList);
-        imageWidget->setProperty("IndexList", indexList);
+        WidgetBinding::attach(imageWidget)->setMonitors(monitorList, indexList);
     } else if (caGraphics *graphicsWidget = qobject_cast<caGraphics *>(widget)) {
         graphicsWidget->setVisibilityCalc(text);
-        graphicsWidget->setProperty("MonitorList", monitorList);
-        graphicsWidget->setProperty("IndexList", indexList);
+        WidgetBinding::attach(graphicsWidget)->setMonitors(monitorList, indexList);
     } else if (caPolyLine *polylineWidget = qobject_cast<caPolyLine *>(widget)) {
         polylineWidget->setVisibilityCalc(text);
-        polylineWidget->setProperty("MonitorList", monitorList);
-        polylineWidget->setProperty("IndexList", indexList);
+        WidgetBinding::attach(polylineWidget)->setMonitors(monitorList, indexList);
     } else if (caInclude *includeWidget = qobject_cast<caInclude *>(widget)) {
         includeWidget->setVisibilityCalc(text);
-        includeWidget->setProperty("MonitorList", monitorList);
-        includeWidget->setProperty("IndexList", indexList);
+        WidgetBinding::attach(includeWidget)->setMonitors(monitorList, indexList);
     } else if (caFrame *frameWidget = qobject_cast<caFrame *>(widget)) {
         frameWidget->setVisibilityCalc(text);
-        frameWidget->setProperty("MonitorList", monitorList);
-        frameWidget->setProperty("IndexList", indexList);
+        WidgetBinding::attach(frameWidget)->setMonitors(monitorList, indexList);
     } else if (caLabel *labelWidget = qobject_cast<caLabel *>(widget)) {
         labelWidget->setVisibilityCalc(text);
-        labelWidget->setProperty("MonitorList", monitorList);
-        labelWidget->setProperty("IndexList", indexList);
+        WidgetBinding::attach(labelWidget)->setMonitors(monitorList, indexList);
     } else if (caLabelVertical *labelverticalWidget = qobject_cast<caLabelVertical *>(widget)) {
         labelverticalWidget->setVisibilityCalc(text);
-        labelverticalWidget->setProperty("MonitorList", monitorList);
-        labelverticalWidget->setProperty("IndexList", indexList);
+        WidgetBinding::attach(labelverticalWidget)->setMonitors(monitorList, indexList);
     }
 
     // when no monitors we have a static visibility calculation, except for cacalc
@@ -8195,9 +8725,8 @@ int CaQtDM_Lib::Execute(char *command)
 #endif
 #endif
 
-void CaQtDM_Lib::TreatOrdinaryValue(QString pvo, double value, int32_t idata,  QString svalue, QWidget *w)
+void CaQtDM_Lib::TreatOrdinaryValue(QString pvo, double value, int32_t idata,  QString svalue, QWidget *w, WritePipeline::Mode mode)
 {
-    char errmess[SMALL_STRING_LENGTH];
     int indx;
 
     QString pv = pvo.trimmed();
@@ -8228,9 +8757,7 @@ void CaQtDM_Lib::TreatOrdinaryValue(QString pvo, double value, int32_t idata,  Q
     if(plugininterface != (ControlsInterface *) Q_NULLPTR) {
         knobData *kPtr;
         if((kPtr = GetMutexKnobDataPV(w, param1)) != (knobData *) Q_NULLPTR) {
-            if(!plugininterface->pvSetValue(kPtr, value, idata, param2, param3, errmess, 0)) {
-               plugininterface->pvSetValue(param1, value, idata, param2, param3, errmess, 0);
-            }
+            WritePipeline::instance()->put(mutexKnobDataP, plugininterface, kPtr, param1, value, idata, param2, param3, 0, mode);
         }
     }
 }
@@ -8273,7 +8800,6 @@ double CaQtDM_Lib::getDoubleValueFromString(char *textValue, FormatType fType, c
   */
 void CaQtDM_Lib::TreatRequestedValue(QString pvo, QString text, FormatType fType, QWidget *w)
 {
-    char errmess[SMALL_STRING_LENGTH];
     double value;
     long longValue;
     char *end = Q_NULLPTR, textValue[SMALL_STRING_LENGTH];
@@ -8313,9 +8839,7 @@ void CaQtDM_Lib::TreatRequestedValue(QString pvo, QString text, FormatType fType
     case caSTRING:
         //qDebug() << "set string" << text << plugininterface->pluginName();
         if(plugininterface != (ControlsInterface *) Q_NULLPTR) {
-           if(!plugininterface->pvSetValue(kPtr,  0.0, 0, (char*) qasc(text), (char*) qasc(w->objectName()), errmess, 0)) {
-              plugininterface->pvSetValue(kPtr->pv, 0.0, 0, (char*) qasc(text), (char*) qasc(w->objectName()), errmess, 0);
-           }
+           WritePipeline::instance()->put(mutexKnobDataP, plugininterface, kPtr, kPtr->pv, 0.0, 0, (char*) qasc(text), (char*) qasc(w->objectName()), 0, WritePipeline::NoCoalesce);
         }
         break;
 
@@ -8333,9 +8857,7 @@ void CaQtDM_Lib::TreatRequestedValue(QString pvo, QString text, FormatType fType
                 if(!text.compare(list.at(i).trimmed())) {
                     //qDebug() << "set enum text" << textValue;
                     if(plugininterface != (ControlsInterface *) Q_NULLPTR) {
-                        if(!plugininterface->pvSetValue(kPtr, 0.0, 0, textValue, (char*) qasc(w->objectName().toLower()), errmess, 0)) {
-                            plugininterface->pvSetValue((char*) kPtr->pv, 0.0, 0, textValue, (char*) qasc(w->objectName().toLower()), errmess, 0);
-                        }
+                        WritePipeline::instance()->put(mutexKnobDataP, plugininterface, kPtr, (char*) kPtr->pv, 0.0, 0, textValue, (char*) qasc(w->objectName().toLower()), 0, WritePipeline::NoCoalesce);
                     }
                     match = true;
                     break;
@@ -8353,9 +8875,7 @@ void CaQtDM_Lib::TreatRequestedValue(QString pvo, QString text, FormatType fType
                 if(*end == 0 && end != textValue && longValue >= 0 && longValue <= kPtr->edata.enumCount) {
                     //qDebug() << "decode value *end=0, set a longvalue to enum" << longValue;
                     if(plugininterface != (ControlsInterface *) Q_NULLPTR) {
-                        if(!plugininterface->pvSetValue(kPtr,  0.0, (int32_t) longValue, textValue, (char*) qasc(w->objectName().toLower()), errmess, 0)) {
-                           plugininterface->pvSetValue((char*) kPtr->pv, 0.0, (int32_t) longValue, textValue, (char*) qasc(w->objectName().toLower()), errmess, 0);
-                        }
+                        WritePipeline::instance()->put(mutexKnobDataP, plugininterface, kPtr, (char*) kPtr->pv, 0.0, (int32_t) longValue, textValue, (char*) qasc(w->objectName().toLower()), 0, WritePipeline::NoCoalesce);
                     }
                 } else {
                     char asc[MAX_STRING_LENGTH];
@@ -8369,9 +8889,7 @@ void CaQtDM_Lib::TreatRequestedValue(QString pvo, QString text, FormatType fType
             } else
                 //qDebug() << "set normal longvalue" << longValue;
                 if(plugininterface != (ControlsInterface *) Q_NULLPTR) {
-                    if(!plugininterface->pvSetValue(kPtr, 0.0, (int32_t) longValue, textValue, (char*) qasc(w->objectName().toLower()), errmess, 0)) {
-                       plugininterface->pvSetValue((char*) kPtr->pv, 0.0, (int32_t) longValue, textValue, (char*) qasc(w->objectName().toLower()), errmess, 0);
-                    }
+                    WritePipeline::instance()->put(mutexKnobDataP, plugininterface, kPtr, (char*) kPtr->pv, 0.0, (int32_t) longValue, textValue, (char*) qasc(w->objectName().toLower()), 0, WritePipeline::NoCoalesce);
                 }
         }
 
@@ -8382,18 +8900,14 @@ void CaQtDM_Lib::TreatRequestedValue(QString pvo, QString text, FormatType fType
             if(kPtr->edata.nelm > 1) {
                //qDebug() << "set string" << text;
                if(plugininterface != (ControlsInterface *) 0) {
-                   if(!plugininterface->pvSetValue(kPtr,  0.0, 0, (char*) qasc(text), (char*) qasc(w->objectName().toLower()), errmess, 0)) {
-                      plugininterface->pvSetValue((char*) kPtr->pv, 0.0, 0, (char*) qasc(text), (char*) qasc(w->objectName().toLower()), errmess, 0);
-                   }
+                   WritePipeline::instance()->put(mutexKnobDataP, plugininterface, kPtr, (char*) kPtr->pv, 0.0, 0, (char*) qasc(text), (char*) qasc(w->objectName().toLower()), 0, WritePipeline::NoCoalesce);
                }
             } else {  // single char written through its ascii code while character entered
                text = text.trimmed();
                if(text.size()> 0) {
                  QChar c = text.at(0);
                  if(plugininterface != (ControlsInterface *) Q_NULLPTR) {
-                     if(!plugininterface->pvSetValue(kPtr,  0.0, (int)c.toLatin1(), (char*)  "", (char*) qasc(w->objectName().toLower()), errmess, 2)) {
-                         plugininterface->pvSetValue((char*) kPtr->pv, 0.0, (int)c.toLatin1(), (char*)  "", (char*) qasc(w->objectName().toLower()), errmess, 2);
-                     }
+                     WritePipeline::instance()->put(mutexKnobDataP, plugininterface, kPtr, (char*) kPtr->pv, 0.0, (int)c.toLatin1(), (char*)  "", (char*) qasc(w->objectName().toLower()), 2, WritePipeline::NoCoalesce);
                  }
                }
             }
@@ -8428,9 +8942,7 @@ void CaQtDM_Lib::TreatRequestedValue(QString pvo, QString text, FormatType fType
 
                     }
 
-                    if(!plugininterface->pvSetValue(kPtr,  value, 0, textValue, (char*) qasc(w->objectName().toLower()), errmess, 1)) {
-                       plugininterface->pvSetValue((char*) kPtr->pv, value, 0, textValue, (char*) qasc(w->objectName().toLower()), errmess, 1);
-                    }
+                    WritePipeline::instance()->put(mutexKnobDataP, plugininterface, kPtr, (char*) kPtr->pv, value, 0, textValue, (char*) qasc(w->objectName().toLower()), 1, WritePipeline::NoCoalesce);
                  }
             }
 
@@ -8818,12 +9330,6 @@ void CaQtDM_Lib::resizeSpecials(QString className, QWidget *widget, QVariantList
         f.setPointSize(qRound(fontSize));
 
         table->setUpdatesEnabled(false);
-        for(int i = 0; i < table->rowCount(); ++i) {
-            for(int j = 0; j < table->columnCount(); ++j) {
-                QTableWidgetItem* selectedItem = table->item(i, j);
-                if(selectedItem != (QTableWidgetItem*) Q_NULLPTR) selectedItem->setFont(f);
-            }
-        }
         table->setValueFont(f);
         table->verticalHeader()->setDefaultSectionSize((int) (qMin(factX, factY)*20));
 
@@ -8842,12 +9348,6 @@ void CaQtDM_Lib::resizeSpecials(QString className, QWidget *widget, QVariantList
         f.setPointSize(qRound(fontSize));
 
         table->setUpdatesEnabled(false);
-        for(int i = 0; i < table->rowCount(); ++i) {
-            for(int j = 0; j < table->columnCount(); ++j) {
-                QTableWidgetItem* selectedItem = table->item(i, j);
-                if(selectedItem != (QTableWidgetItem*) Q_NULLPTR) selectedItem->setFont(f);
-            }
-        }
         table->setValueFont(f);
         table->verticalHeader()->setDefaultSectionSize((int) (qMin(factX, factY)*20));
 
@@ -9090,9 +9590,30 @@ void CaQtDM_Lib::send_delayed_popup_signal(){
     }
 }
 
+/**
+ * the pointer stayed on a related display, prepare its displays
+ */
+void CaQtDM_Lib::Callback_PreloadRelatedDisplay()
+{
+    if(preloadWidget.isNull() || !preloadWidget->isVisible()) return;
+    preloadRelatedDisplay(preloadWidget);
+}
+
 bool CaQtDM_Lib::eventFilter(QObject *obj, QEvent *event)
 {
     if (event->type() == QEvent::HoverEnter) {
+        // prepare the displays of a related display when the pointer stays on it
+        if(caRelatedDisplay *related = qobject_cast<caRelatedDisplay *>(obj)) {
+            if(DisplayPreloader::instance()->isEnabled()) {
+                if(preloadTimer == (QTimer *) Q_NULLPTR) {
+                    preloadTimer = new QTimer(this);
+                    preloadTimer->setSingleShot(true);
+                    connect(preloadTimer, SIGNAL(timeout()), this, SLOT(Callback_PreloadRelatedDisplay()));
+                }
+                preloadWidget = related;
+                preloadTimer->start(DisplayPreloader::instance()->getDelay());
+            }
+        }
         QWidget *w= (QWidget*) obj;
         QVariant dynVars = w->property("caqtdmPopupUI");
         if(!dynVars.isNull()) {
@@ -9135,6 +9656,7 @@ bool CaQtDM_Lib::eventFilter(QObject *obj, QEvent *event)
             }
         }
     } else if(event->type() == QEvent::HoverLeave) {
+        if((preloadTimer != (QTimer *) Q_NULLPTR) && (obj == preloadWidget.data())) preloadTimer->stop();
         QWidget *wo= (QWidget*) obj;
         QVariant dynVars = wo->property("caqtdmPopupUI");
         if(!dynVars.isNull()) {
@@ -9566,6 +10088,56 @@ void CaQtDM_Lib::StripPlotsVerticalAlign()
    }
 }
 
+/**
+ * a strip plot misses data after a period change, ask the archive once for every curve
+ */
+void CaQtDM_Lib::Callback_StripPlotBackfill(double seconds)
+{
+    caStripPlot *stripplotWidget = qobject_cast<caStripPlot *>(sender());
+    if(stripplotWidget == (caStripPlot *) Q_NULLPTR) return;
+
+    QString plugin = stripplotWidget->property("archiveBackfill").toString().trimmed();
+    if(plugin.isEmpty()) return;
+
+    // previous requests are not needed anymore
+    QVariantList backfillList = stripplotWidget->property("BackfillList").toList();
+    for(int i=0; i < backfillList.count(); i++) {
+        int indx = backfillList.at(i).toInt();
+        knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(indx);
+        if(kPtr == (knobData *) Q_NULLPTR || kPtr->index == -1) continue;
+        knobData kData = mutexKnobDataP->GetMutexKnobData(indx);
+        ControlsInterface * plugininterface = getControlInterface(kData.pluginName);
+        if(plugininterface != (ControlsInterface *) Q_NULLPTR) plugininterface->pvClearMonitor(&kData);
+        kData.index = -1;
+        mutexKnobDataP->SetMutexKnobData(indx, kData);
+        mutexKnobDataP->RetireMutexKnobDataSlot(indx, plugininterface);
+        clearUpdateHandler(indx);
+    }
+    backfillList.clear();
+
+    stripplotWidget->setProperty("secondsPast", (int) (seconds + 1.0));
+    stripplotWidget->setProperty("nrOfBins", stripplotWidget->canvas()->width());
+
+    // addMonitor would change the tooltip
+    QString tooltip = stripplotWidget->toolTip();
+    QStringList vars = stripplotWidget->getPVS().split(";", SKIP_EMPTY_PARTS);
+    for(int i=0; i < qMin(vars.count(), (int) caStripPlot::MAXCURVES); i++) {
+        knobData kData;
+        int specData[5] = {0,0,0,0,0};
+        memset(&kData, 0, sizeof (knobData));
+        QString pv = vars.at(i).trimmed();
+        if(pv.size() == 0) continue;
+        int pos = pv.indexOf("://");
+        if(pos != -1) pv = pv.mid(pos+3);
+        specData[1] = i;            // curve number
+        specData[0] = vars.count(); // number of curves
+        int num = addMonitor(myWidget, &kData, plugin + "://" + pv, stripplotWidget, specData, QMap<QString, QString>(), &pv);
+        if(num != -1) backfillList.append(num);
+    }
+    stripplotWidget->setToolTip(tooltip);
+    stripplotWidget->setProperty("BackfillList", backfillList);
+}
+
 void CaQtDM_Lib::Callback_WriteDetectedValues(QWidget* child)
 {
     double x,y,w,h;
@@ -9659,7 +10231,7 @@ void CaQtDM_Lib::Callback_WriteDetectedValues(QWidget* child)
         int32_t idata = (int32_t) values[i];
         double rdata = (double) values[i];
         if(thisString.at(i).trimmed().length() > 0) {
-            TreatOrdinaryValue(thisString.at(i), rdata,  idata, "", widget);
+            TreatOrdinaryValue(thisString.at(i), rdata,  idata, "", widget, WritePipeline::Coalesce);
         }
     }
 }
@@ -78,6 +78,8 @@
 #include "limitsDialog.h"
 #include "sliderDialog.h"
 #include "splashscreen.h"
+#include "visibilitytracker.h"
+#include "writepipeline.h"
 #include "messageQueue.h"
 
 // interface to different controlsystems
@@ -108,6 +110,16 @@ enum macro_parser{
     parse_simple,parse_withconst
 };
 
+// update routines of CaQtDM_Lib::UpdateWidget, resolved once per monitored widget
+enum update_handler{
+    Handler_caWidgetInterface, Handler_caCalc, Handler_caLabel, Handler_caLabelVertical, Handler_caInclude, Handler_caFrame,
+    Handler_caMenu, Handler_caChoice, Handler_caThermo, Handler_caSlider, Handler_caClock, Handler_caLinearGauge, Handler_caCircularGauge, Handler_caMeter,
+    Handler_caByte, Handler_caByteController, Handler_replaceMacro, Handler_caLineEdit, Handler_caMultiLineString, Handler_caGraphics, Handler_caPolyLine, Handler_caLed,
+    Handler_caApplyNumeric, Handler_caNumeric, Handler_caSpinbox, Handler_caToggleButton, Handler_caCartesianPlot, Handler_caWaterfallPlot, Handler_caStripPlot, Handler_caImage,
+    Handler_caTable, Handler_caWaveTable, Handler_caBitnames, Handler_caCamera, Handler_caScan2D, Handler_caMessageButton,
+    Handler_unknown
+};
+
 namespace Ui {
 class CaQtDM_Lib;
 }
@@ -140,6 +152,10 @@ public:
     QWidget* getMyWidget(){ return myWidget; }
     // interface finish (perhaps we need more)
 
+    void setUpdateTiming(bool enable);
+    QVector<float> getUpdateTimings(bool clear = true);
+    void benchmarkDispatch(int iterations, double &chainNs, double &tableNs);
+
 #ifdef MOBILE
     void grabSwipeGesture(Qt::GestureType fingerSwipeGestureTypeID);
 #endif
@@ -359,17 +375,29 @@ private:
     int Execute(char *command);
 
     void TreatRequestedWave(QString pv, QString text, caWaveTable::FormatType fType, int index, QWidget *w);
-    void TreatOrdinaryValue(QString pv, double value, int32_t idata, QString svalue, QWidget *w);
+    void TreatOrdinaryValue(QString pv, double value, int32_t idata, QString svalue, QWidget *w, WritePipeline::Mode mode);
     bool getSoftChannel(QString pv, knobData &data);
     int parseForDisplayRate(QString &input, int &rate);
     bool checkJsonString(QString &inputc);
     bool parseForQRectConst(QString &input,double* valueArray);
     void getStatesToggleAndLed(QWidget *widget, const knobData &data, const QString &String, Qt::CheckState &state);
+    QStringList splitStrings(const knobData &data, const QString &String);
 
     QRect widgetResize(QWidget *w, double factX, double factY);
     void resizeSpecials(QString className, QWidget *widget, QVariantList list, double factX, double factY);
     void shellCommand(QString command);
 
+    void UpdateWidget(QWidget *w, int handler, const QString& units, const QString& fec, const QString& String, const knobData& data);
+    int resolveUpdateHandler(QWidget *w, int *casts = (int*) Q_NULLPTR);
+    int getUpdateHandler(int indx, QWidget *w);
+    void clearUpdateHandler(int indx);
+    void addMonitorInfo(QWidget *w, knobData *kData);
+    QString channelPlugin(QString &pv, QString &pluginFlavor);
+    QStringList relatedDisplayArgs(caRelatedDisplay *w, bool verbose);
+    void preloadRelatedDisplay(caRelatedDisplay *w);
+    bool preconnectChannel(QMap<QString, QString> map, const QString &channel);
+    void ProfileWidgetUpdate(QWidget *w, double usec);
+    QString getUpdateProfile(bool html);
     void WaterFall(caWaterfallPlot *widget, const knobData &data);
     void Cartesian(caCartesianPlot *widget, int curvNB, int curvType, int XorY, const knobData &data);
     void CameraWaveform(caCamera *widget, int curvNB, int curvType, int XorY, const knobData &data);
@@ -449,9 +477,25 @@ private:
     bool AllowsUpdate;
     bool fromAS;
 
+    bool updateTimingEnabled;
+    QVector<float> updateTimings;
+
+    struct updateDispatch {QWidget *widget; const QMetaObject *meta; int handler;};
+    QVector<updateDispatch> updateDispatchList;
+
+    struct updateProfile {qint64 count; double sum; double max; int casts;};
+    bool updateProfilingEnabled;
+    QMap<QString, updateProfile> profileClassList;
+    QMap<QString, updateProfile> profileObjectList;
+
     int loopTimer;
     int loopTimerID;
 
+    VisibilityTracker *visibilityTracker;
+
+    QTimer *preloadTimer;
+    QPointer<caRelatedDisplay> preloadWidget;
+
     QMap<QString, ControlsInterface*> controlsInterfaces;
     MutexKnobData *mutexKnobDataP;
     MessageWindow *messageWindowP;
@@ -510,6 +554,7 @@ private slots:
     void handleFileChanged(const QString&);
 
     void Callback_WriteDetectedValues(QWidget* w);
+    void Callback_StripPlotBackfill(double seconds);
 
     void Callback_ReloadWindowL() {
 
@@ -548,6 +593,7 @@ private slots:
     void updateResize();
 #ifndef MOBILE
     void send_delayed_popup_signal();
+    void Callback_PreloadRelatedDisplay();
 #endif
 
 };
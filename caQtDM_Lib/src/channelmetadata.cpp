@@ -0,0 +1,91 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include "channelmetadata.h"
+
+// the objects are kept for the lifetime of the application, so that reopened displays find them again
+static QMutex internMutex;
+static QHash<QByteArray, ChannelMetadata*> internTable;
+
+/**
+ * get the metadata object of a pv, created at the first request
+ */
+ChannelMetadata *ChannelMetadata::intern(const char *plugin, const char *pv)
+{
+    QByteArray key(plugin);
+    key.append(':');
+    key.append(pv);
+
+    QMutexLocker locker(&internMutex);
+    ChannelMetadata *metadata = internTable.value(key, (ChannelMetadata*) Q_NULLPTR);
+    if(metadata == (ChannelMetadata*) Q_NULLPTR) {
+        metadata = new ChannelMetadata();
+        internTable.insert(key, metadata);
+    }
+    return metadata;
+}
+
+/**
+ * number of pv's with metadata
+ */
+int ChannelMetadata::count()
+{
+    QMutexLocker locker(&internMutex);
+    return internTable.count();
+}
+
+/**
+ * get the enum strings, split again only when they changed
+ */
+QStringList ChannelMetadata::enumStrings(const QString &joined)
+{
+    QMutexLocker locker(&mutex);
+    if(joined != enumsJoined || enums.isEmpty()) {
+        enumsJoined = joined;
+        enums = joined.split((QChar)27);
+    }
+    return enums;
+}
+
+/**
+ * get the formatted units, false when they were never set or are different now
+ */
+bool ChannelMetadata::cachedUnits(const char *raw, QString &units)
+{
+    QMutexLocker locker(&mutex);
+    if(unitsRaw.isNull() || qstrcmp(unitsRaw.constData(), raw) != 0) return false;
+    units = unitsFormatted;
+    return true;
+}
+
+/**
+ * keep the formatted units of the raw units
+ */
+void ChannelMetadata::setUnits(const char *raw, const QString &units)
+{
+    QMutexLocker locker(&mutex);
+    unitsRaw = QByteArray(raw);
+    unitsFormatted = units;
+}
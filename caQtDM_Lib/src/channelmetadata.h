@@ -0,0 +1,61 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef CHANNELMETADATA_H
+#define CHANNELMETADATA_H
+
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+#include "caQtDM_Lib_global.h"
+
+/**
+ * the decoded metadata of a channel, one object per plugin and pv shared by all the slots monitoring it.
+ * the enum strings are split and the units formatted only when the plugin delivers different ones,
+ * the update routines get the cached results instead of decoding them again for every monitor
+ */
+class CAQTDM_LIBSHARED_EXPORT ChannelMetadata
+{
+public:
+    static ChannelMetadata *intern(const char *plugin, const char *pv);
+    static int count();
+
+    QStringList enumStrings(const QString &joined);
+    bool cachedUnits(const char *raw, QString &units);
+    void setUnits(const char *raw, const QString &units);
+
+private:
+    ChannelMetadata() {}
+
+    QMutex mutex;
+    QString enumsJoined;       // enum strings as delivered, separated by \033
+    QStringList enums;
+    QByteArray unitsRaw;       // units as delivered by the plugin
+    QString unitsFormatted;    // units with the special characters replaced
+};
+
+#endif
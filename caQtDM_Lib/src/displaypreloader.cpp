@@ -0,0 +1,248 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include <QApplication>
+#include <QFileInfo>
+#include <QXmlStreamReader>
+#include <QSet>
+#include "displaypreloader.h"
+#include "searchfile.h"
+
+DisplayPreloader *DisplayPreloader::instance()
+{
+    static DisplayPreloader *preloader = (DisplayPreloader *) Q_NULLPTR;
+    if(preloader == (DisplayPreloader *) Q_NULLPTR) preloader = new DisplayPreloader(qApp);
+    return preloader;
+}
+
+DisplayPreloader::DisplayPreloader(QObject *parent) : QObject(parent)
+{
+    bool ok;
+    enabled = ((QString) qgetenv("CAQTDM_PRELOAD_RELATED")).toLower().replace("\"","") == "true";
+    delay = ((QString) qgetenv("CAQTDM_PRELOAD_DELAY")).toInt(&ok);
+    if(!ok || delay < 0) delay = PRELOAD_DELAY;
+    recentCount = ((QString) qgetenv("CAQTDM_PRELOAD_RECENT")).toInt(&ok);
+    if(!ok || recentCount < 1) recentCount = PRELOAD_RECENT;
+    useCounter = 0;
+    nbPreloads = nbChannels = nbRequests = nbHits = 0;
+    savedMs = 0.0;
+    clock.start();
+}
+
+/**
+ * the contents of an opened display file, taken from the template cache when the file did not change
+ */
+QByteArray DisplayPreloader::fileContents(QFile *file)
+{
+    if(!enabled && pinned.isEmpty()) return file->readAll();
+
+    QString path = QFileInfo(*file).absoluteFilePath();
+    templateEntry *entry = cachedTemplate(path);
+    if(entry != (templateEntry *) Q_NULLPTR) return entry->contents;
+
+    QByteArray contents = file->readAll();
+    if(enabled || pinned.contains(path)) storeTemplate(path, contents);
+    return contents;
+}
+
+/**
+ * keep a display file for the whole session (server mode), independent of CAQTDM_PRELOAD_RELATED
+ */
+bool DisplayPreloader::keepTemplate(const QString &fileName)
+{
+    QString path = QFileInfo(fileName).absoluteFilePath();
+    QFile file(path);
+    if(!file.open(QFile::ReadOnly)) return false;
+    pinned.insert(path);
+    storeTemplate(path, file.readAll());
+    file.close();
+    return true;
+}
+
+/**
+ * get the channels of a related display to be connected ahead; false when the display can not be found or was
+ * prepared already and its channels are still connected
+ */
+bool DisplayPreloader::preload(const QString &fileName, const QString &macro, double validSeconds, QStringList &channels)
+{
+    if(!enabled) return false;
+
+    QString key = fileName + "&" + macro;
+    double now = (double) clock.elapsed();
+    QHash<QString, preloadEntry>::iterator it = preloads.find(key);
+    if(it != preloads.end() && now < it->expires) return false;
+
+    QString path = resolveFile(fileName);
+    if(path.isEmpty()) return false;
+
+    templateEntry *entry = cachedTemplate(path);
+    if(entry == (templateEntry *) Q_NULLPTR) {
+        QFile file(path);
+        if(!file.open(QFile::ReadOnly)) return false;
+        entry = storeTemplate(path, file.readAll());
+        file.close();
+    }
+    if(!entry->parsed) parseChannels(entry);
+    channels = entry->channels;
+
+    preloadEntry preloaded;
+    preloaded.expires = now + validSeconds * 1000.0;
+    preloaded.ms = 0.0;
+    preloads.insert(key, preloaded);
+    return true;
+}
+
+/**
+ * time spent to prepare a display
+ */
+void DisplayPreloader::preloadDone(const QString &fileName, const QString &macro, double ms, int channels)
+{
+    QHash<QString, preloadEntry>::iterator it = preloads.find(fileName + "&" + macro);
+    if(it == preloads.end()) return;
+    it->ms = ms;
+    nbPreloads++;
+    nbChannels += channels;
+}
+
+/**
+ * a related display was clicked, the time of its preparation is saved when it was prepared and still valid
+ */
+void DisplayPreloader::requested(const QString &fileName, const QString &macro)
+{
+    if(!enabled) return;
+    nbRequests++;
+    QHash<QString, preloadEntry>::iterator it = preloads.find(fileName + "&" + macro);
+    if(it == preloads.end()) return;
+    if((double) clock.elapsed() < it->expires) {
+        nbHits++;
+        savedMs += it->ms;
+    }
+    // the channels are taken over now, a next hover prepares the display again
+    preloads.erase(it);
+}
+
+QString DisplayPreloader::statisticsString()
+{
+    if(nbRequests == 0) return QString();
+    return QString("preload hits %1/%2 (%3%), %4 ms saved, %5 PV preconnected").arg(nbHits).arg(nbRequests)
+            .arg(100.0 * nbHits / nbRequests, 0, 'f', 0).arg(savedMs, 0, 'f', 0).arg(nbChannels);
+}
+
+/**
+ * find a display like the file open of the viewer does, only ui files are prepared
+ */
+QString DisplayPreloader::resolveFile(const QString &fileName)
+{
+    QString name = fileName;
+    if(!name.endsWith(".ui")) {
+        if(name.endsWith(".prc") || name.endsWith(".adl") || name.endsWith(".edl")) return QString();
+        name = name.split(".", SKIP_EMPTY_PARTS).value(0) + ".ui";
+    }
+    searchFile s(name);
+    QString found = s.findFile();
+    if(found.isNull()) return QString();
+    return QFileInfo(found).absoluteFilePath();
+}
+
+/**
+ * a template that is still valid, it becomes the most recently used one
+ */
+DisplayPreloader::templateEntry *DisplayPreloader::cachedTemplate(const QString &path)
+{
+    QHash<QString, templateEntry>::iterator it = templates.find(path);
+    if(it == templates.end()) return (templateEntry *) Q_NULLPTR;
+
+    // the file was edited in the meantime
+    QFileInfo fi(path);
+    if(fi.size() != it->size || fi.lastModified() != it->modified) {
+        templates.erase(it);
+        return (templateEntry *) Q_NULLPTR;
+    }
+    it->used = ++useCounter;
+    return &it.value();
+}
+
+/**
+ * keep a display file, the least recently used template is dropped when the cache is full
+ */
+DisplayPreloader::templateEntry *DisplayPreloader::storeTemplate(const QString &path, const QByteArray &contents)
+{
+    QFileInfo fi(path);
+    templateEntry entry;
+    entry.contents = contents;
+    entry.modified = fi.lastModified();
+    entry.size = fi.size();
+    entry.used = ++useCounter;
+    entry.parsed = false;
+
+    // the kept templates do not count for the most recently used ones
+    templates.remove(path);
+    while(templates.count() - pinned.count() >= recentCount) {
+        QHash<QString, templateEntry>::iterator oldest = templates.end();
+        for(QHash<QString, templateEntry>::iterator it = templates.begin(); it != templates.end(); ++it) {
+            if(pinned.contains(it.key())) continue;
+            if(oldest == templates.end() || it->used < oldest->used) oldest = it;
+        }
+        if(oldest == templates.end()) break;
+        templates.erase(oldest);
+    }
+    return &templates.insert(path, entry).value();
+}
+
+/**
+ * the channels of all properties named channel..., without the soft channels defined with caCalc variables
+ */
+void DisplayPreloader::parseChannels(templateEntry *entry)
+{
+    QSet<QString> channels;
+    QSet<QString> variables;
+    QString property;
+
+    QXmlStreamReader xml(entry->contents);
+    while(!xml.atEnd()) {
+        xml.readNext();
+        if(!xml.isStartElement()) continue;
+        if(xml.name() == QLatin1String("property")) {
+            property = xml.attributes().value("name").toString();
+        } else if(xml.name() == QLatin1String("string")) {
+            QString text = xml.readElementText();
+            if(property == "variable") {
+                variables.insert(text.trimmed());
+            } else if(property.startsWith("channel")) {
+                foreach(QString channel, text.split(";", SKIP_EMPTY_PARTS)) {
+                    channel = channel.trimmed();
+                    if(!channel.isEmpty()) channels.insert(channel);
+                }
+            }
+            property = "";
+        }
+    }
+
+    entry->channels.clear();
+    foreach(QString channel, channels) {
+        if(!variables.contains(channel)) entry->channels.append(channel);
+    }
+    entry->parsed = true;
+}
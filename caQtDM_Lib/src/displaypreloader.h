@@ -0,0 +1,100 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef DISPLAYPRELOADER_H
+#define DISPLAYPRELOADER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QFile>
+#include <QDateTime>
+#include <QStringList>
+#include <QElapsedTimer>
+#include "caQtDM_Lib_global.h"
+
+#define PRELOAD_DELAY 200   // ms the pointer has to stay on a related display
+#define PRELOAD_RECENT 8    // number of display templates kept
+
+/**
+ * prepares the displays of a caRelatedDisplay while the pointer rests on it, with CAQTDM_PRELOAD_RELATED=true.
+ * the display files are kept with their channel list in a template cache of the CAQTDM_PRELOAD_RECENT most recently
+ * used displays and the channels are connected ahead, so that a click only has to build the widgets.
+ */
+class CAQTDM_LIBSHARED_EXPORT DisplayPreloader : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DisplayPreloader *instance();
+
+    bool isEnabled() const { return enabled; }
+    int getDelay() const { return delay; }
+
+    QByteArray fileContents(QFile *file);
+    bool keepTemplate(const QString &fileName);
+    bool preload(const QString &fileName, const QString &macro, double validSeconds, QStringList &channels);
+    void preloadDone(const QString &fileName, const QString &macro, double ms, int channels);
+    void requested(const QString &fileName, const QString &macro);
+    QString statisticsString();
+
+private:
+    DisplayPreloader(QObject *parent);
+
+    typedef struct _templateEntry {
+        QByteArray contents;
+        QDateTime modified;
+        qint64 size;
+        qint64 used;
+        bool parsed;
+        QStringList channels;
+    } templateEntry;
+
+    typedef struct _preloadEntry {
+        double expires;
+        double ms;
+    } preloadEntry;
+
+    QString resolveFile(const QString &fileName);
+    templateEntry *cachedTemplate(const QString &path);
+    templateEntry *storeTemplate(const QString &path, const QByteArray &contents);
+    void parseChannels(templateEntry *entry);
+
+    bool enabled;
+    int delay;
+    int recentCount;
+    qint64 useCounter;
+    QElapsedTimer clock;
+
+    // templates by absolute file path and the displays prepared by file and macro
+    QHash<QString, templateEntry> templates;
+    QHash<QString, preloadEntry> preloads;
+    QSet<QString> pinned;
+
+    qint64 nbPreloads, nbChannels, nbRequests, nbHits;
+    double savedMs;
+};
+
+#endif
@@ -98,6 +98,26 @@ typedef struct _knobData {
     caqtdm_string_t pluginFlavor;       /* plugin additional data */
 } knobData;
 
+/* the fields of a knob a data callback changes, read and written without copying the whole knob */
+typedef struct _knobValue {
+    int          index;                 /* index (-1 for not used) */
+    void         *mutex;                /* mutex used for waveforms */
+    int          connected;             /* connection flag */
+    caqtdm_string_t fec;                   /* ioc */
+    int          monitorCount;          /* acquisition counter */
+    int          valueCount;            /* number of values */
+    short        fieldtype;             /* fieldtype */
+    short        status;                /* status of value */
+    short        severity;              /* severity of alarm */
+    double       rvalue;                /* real value */
+    long         ivalue;                /* integer value */
+    int          accessW;               /* epics access control */
+    int          accessR;
+    int          dataSize;              /* size of vector data */
+    void         *dataB;                /* vector data */
+    struct timeb actTime;               /* receive time */
+} knobValue;
+
 #ifdef __cplusplus
 }
 #endif
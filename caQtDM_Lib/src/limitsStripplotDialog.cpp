@@ -25,6 +25,7 @@
 
 #include <QtGui>
 #include "limitsStripplotDialog.h"
+#include "widgetbinding.h"
 
 limitsStripplotDialog::limitsStripplotDialog(caStripPlot *w, MutexKnobData *data, const QString &title, QWidget *parent) : QWidget(parent)
 {
@@ -189,6 +190,16 @@ limitsStripplotDialog::limitsStripplotDialog(caStripPlot *w, MutexKnobData *data
     buttonBox->addButton(button, QDialogButtonBox::ApplyRole );
     Layout->addWidget(buttonBox, vars.size()+3, 0);
 
+    // period of the chart, history is kept when changed
+    QString unitsName = "seconds";
+    if(StripPlot->getUnits() == caStripPlot::Millisecond) unitsName = "milliseconds";
+    else if(StripPlot->getUnits() == caStripPlot::Minute) unitsName = "minutes";
+    QLabel *periodLabel = new QLabel("Period (" + unitsName + "):");
+    text.setNum(StripPlot->getPeriod());
+    periodLineEdit = new QLineEdit(text);
+    Layout->addWidget(periodLabel, vars.size()+4, 1);
+    Layout->addWidget(periodLineEdit, vars.size()+4, 2);
+
     setLayout(Layout);
     setWindowTitle(title);
 
@@ -204,14 +215,13 @@ void limitsStripplotDialog::cancelClicked()
 void limitsStripplotDialog::applyClicked()
 {
     bool ok;
-    QVariant var=StripPlot->property("MonitorList");
-    QVariantList list = var.toList();
-    int nbMonitors = list.at(0).toInt();
+    WidgetBinding *binding = WidgetBinding::get(StripPlot);
+    int nbMonitors = (binding != (WidgetBinding *) Q_NULLPTR) ? binding->monitors.size() : 0;
     for(int i=0; i< qMin(vars.size(), nbMonitors); i++) {
         QString pv = vars.at(i).trimmed();
         if(pv.size() > 0) {
 
-            knobData *ptr = monData->GetMutexKnobDataPtr(list.at(i+1).toInt());
+            knobData *ptr = monData->GetMutexKnobDataPtr(binding->monitors.at(i));
             if(ptr == (knobData *) Q_NULLPTR) break;
 
             int indx = minComboBox[i]->currentIndex();
@@ -303,6 +313,11 @@ void limitsStripplotDialog::applyClicked()
     }
 
     StripPlot->setAutoscaleMinYOverride(overRideAutoScaleActive->isChecked());
+
+    double period = periodLineEdit->text().toDouble(&ok);
+    if(ok && period > 0.0 && period != StripPlot->getPeriod()) StripPlot->setPeriod(period);
+    text.setNum(StripPlot->getPeriod());
+    periodLineEdit->setText(text);
 }
 
 void limitsStripplotDialog::exec()
@@ -93,6 +93,7 @@
      QCheckBox *sAutoScaleSelected[caStripPlot::MAXCURVES];
      QComboBox *YaxisType;
      QComboBox *YaxisScaling;
+     QLineEdit *periodLineEdit;
 
      QStringList vars;
      caStripPlot *StripPlot;
@@ -33,26 +33,93 @@
 #include <QWidget>
 #include <QDebug>
 #include <QPair>
+#include <QFile>
+#include <QTextStream>
+#include <QApplication>
+#include <QCursor>
+#include <QElapsedTimer>
+#include <algorithm>
 #include "QtControls"
+#include "controlsinterface.h"
+#include "widgetbinding.h"
+#include "channelmetadata.h"
+
+// display budget: priorities, a channel is noisy when it gets this many times more monitors than it can display
+#define DISPLAY_PRIORITY_LOW 0
+#define DISPLAY_PRIORITY_NORMAL 1
+#define DISPLAY_PRIORITY_HIGH 2
+#define NOISY_MONITOR_FACTOR 4.0
+#define MAX_DISPLAY_THROTTLE 32
+
+// timer periods and milliseconds a retired slot is kept at least, a data callback that got the slot before cannot be
+// running anymore; only the epics3 plugin marks its readers, for the other plugins the time is what the former sleep
+// of 200 ms on closing a window guaranteed
+#define RETIRE_EPOCHS 2
+#define RETIRE_GRACE_MS 200.0
+
+// seconds the channels of a closed window stay connected by default, off unless CAQTDM_CHANNEL_LINGER is set
+#define CHANNEL_LINGER_SECONDS 0.0
+
+/**
+ * actual time in milliseconds, used for the latency statistics
+ */
+static double msTime()
+{
+    struct timeb now;
+    ftime(&now);
+    return (double) now.time * 1000.0 + (double) now.millitm;
+}
+
+/**
+ * the value fields exchanged with the data callbacks
+ */
+static void knobToValue(const knobData *kPtr, knobValue *value)
+{
+    value->index = kPtr->index;
+    value->mutex = kPtr->mutex;
+    value->connected = kPtr->edata.connected;
+    memcpy(value->fec, kPtr->edata.fec, sizeof(caqtdm_string_t));
+    value->monitorCount = kPtr->edata.monitorCount;
+    value->valueCount = kPtr->edata.valueCount;
+    value->fieldtype = kPtr->edata.fieldtype;
+    value->status = kPtr->edata.status;
+    value->severity = kPtr->edata.severity;
+    value->rvalue = kPtr->edata.rvalue;
+    value->ivalue = kPtr->edata.ivalue;
+    value->accessW = kPtr->edata.accessW;
+    value->accessR = kPtr->edata.accessR;
+    value->dataSize = kPtr->edata.dataSize;
+    value->dataB = kPtr->edata.dataB;
+    value->actTime = kPtr->edata.actTime;
+}
+
+static void valueToKnob(const knobValue *value, knobData *kPtr)
+{
+    kPtr->edata.connected = value->connected;
+    memcpy(kPtr->edata.fec, value->fec, sizeof(caqtdm_string_t));
+    kPtr->edata.monitorCount = value->monitorCount;
+    kPtr->edata.valueCount = value->valueCount;
+    kPtr->edata.fieldtype = value->fieldtype;
+    kPtr->edata.status = value->status;
+    kPtr->edata.severity = value->severity;
+    kPtr->edata.rvalue = value->rvalue;
+    kPtr->edata.ivalue = value->ivalue;
+    kPtr->edata.accessW = value->accessW;
+    kPtr->edata.accessR = value->accessR;
+    kPtr->edata.dataSize = value->dataSize;
+    kPtr->edata.dataB = value->dataB;
+    kPtr->edata.actTime = value->actTime;
+}
 
 /**
  * this routine (re)allocates memory and copies the old data to the new memory
  */
 MutexKnobData::MutexKnobData()
 {
-    KnobDataArraySize=500;
-    KnobData = (knobData*) malloc(KnobDataArraySize * sizeof(knobData));
-    if (KnobData==Q_NULLPTR) {
-        printf("caQtDM -- could not allocate memory -> exit\n");
-        exit(1);
-    }
-    for(int i=0; i < KnobDataArraySize; i++){
-        KnobData[i].index  = -1;
-        KnobData[i].thisW = (void*) Q_NULLPTR;
-        KnobData[i].mutex = (void*) Q_NULLPTR;
-        KnobData[i].edata.dataB = (void*) Q_NULLPTR;
-        KnobData[i].edata.dataPtr = (void*) Q_NULLPTR;
-    }
+    nbChunks = 0;
+    KnobDataArraySize = 0;
+    AllocateChunks(1);
+    timerEpoch = 0;
 
     nbMonitorsPerSecond = 0;
     nbDisplayCountPerSecond = 0;
@@ -64,9 +131,36 @@ MutexKnobData::MutexKnobData()
     highestCountPerSecond = 0;
 
     suppressUpdates = false;
+    displayStatistics = false;
+
+    // display budget in ms of gui time per timer period, off when not set, "auto" uses half of the period
+    bool ok;
+    QString budget = ((QString) qgetenv("CAQTDM_DISPLAY_BUDGET_MS")).toLower();
+    displayBudgetDefault = (budget == "auto");
+    displayBudgetMs = budget.toDouble(&ok);
+    if(!ok || displayBudgetMs < 0.0) displayBudgetMs = 0.0;
+    if(displayBudgetDefault) displayBudgetMs = 500.0 / DEFAULTRATE;
+    // highest number of updates per second for one window, 0 = no limit
+    windowBudget = ((QString) qgetenv("CAQTDM_WINDOW_BUDGET")).toInt();
+    // the channels of a closed window stay connected for this many seconds, 0 clears them at once
+    lingerSeconds = ((QString) qgetenv("CAQTDM_CHANNEL_LINGER")).toDouble(&ok);
+    if(!ok || lingerSeconds < 0.0) lingerSeconds = CHANNEL_LINGER_SECONDS;
+    lingerTaken = 0;
+    windowUpdatesTime = 0;
+    nbDeferred = nbDeferredPerSecond = 0;
+    budgetUsed = 0.0;
+
     ftime(&last);
     ftime(&monitorTiming);
 
+    // data callbacks change only the value fields of a slot under one of the striped locks,
+    // with CAQTDM_KNOBDATA_FIELDACCESS=false whole knobs are copied under the global lock as before
+    fieldAccess = true;
+    if (qgetenv("CAQTDM_KNOBDATA_FIELDACCESS").toLower().replace("\"","") == "false") fieldAccess = false;
+    memset(&globalLock, 0, sizeof(lockStatistics));
+    memset(stripeLock, 0, sizeof(stripeLock));
+    memset(stripeMonitors, 0, sizeof(stripeMonitors));
+
     // start a timer with 10Hz
     prvRepetitionRate = DEFAULTRATE;
     timerId = startTimer(1000/DEFAULTRATE);
@@ -187,6 +281,43 @@ void MutexKnobData::ReAllocate(int oldsize, int newsize, void **ptr)
     *ptr = tmp;
 }
 
+/**
+ * add chunks of slots, the chunks already there stay where they are, so that pointers to the slots remain valid
+ */
+void MutexKnobData::AllocateChunks(int count)
+{
+    if(nbChunks + count > KNOBCHUNKS) count = KNOBCHUNKS - nbChunks;
+    if(count <= 0) {
+        printf("caQtDM -- could not allocate any more slots -> exit\n");
+        exit(1);
+    }
+    for(int c=nbChunks; c < nbChunks + count; c++) {
+        KnobChunks[c] = (knobData*) malloc(KNOBCHUNKSIZE * sizeof(knobData));
+        StatisticsChunks[c] = (knobStatistics*) calloc(KNOBCHUNKSIZE, sizeof(knobStatistics));
+        if (KnobChunks[c]==Q_NULLPTR || StatisticsChunks[c]==Q_NULLPTR) {
+            printf("caQtDM -- could not allocate memory -> exit\n");
+            exit(1);
+        }
+        for(int i=0; i < KNOBCHUNKSIZE; i++){
+            KnobChunks[c][i].index  = -1;
+            KnobChunks[c][i].thisW = (void*) Q_NULLPTR;
+            KnobChunks[c][i].mutex = (void*) Q_NULLPTR;
+            KnobChunks[c][i].edata.dataB = (void*) Q_NULLPTR;
+            KnobChunks[c][i].edata.dataPtr = (void*) Q_NULLPTR;
+        }
+    }
+    // free slots are taken from the end, lowest indexes first
+    int oldsize = KnobDataArraySize;
+    int newsize = (nbChunks + count) * KNOBCHUNKSIZE;
+    QVector<int> list;
+    list.reserve(freeSlots.size() + newsize - oldsize);
+    for(int i=newsize-1; i >= oldsize; i--) list.append(i);
+    list += freeSlots;
+    freeSlots = list;
+    nbChunks += count;
+    KnobDataArraySize = newsize;
+}
+
 /**
  * this routine allows to change between direct updated and timed updates
  */
@@ -224,7 +355,7 @@ void MutexKnobData::InsertSoftPV(QString pv, int num, QWidget *w)
     int indx;
     //char asc[MAXPVLEN+20];
     //sprintf(asc, "%s_%p", qasc(pv),  w);
-    QMutexLocker locker(&mutex);
+    GlobalLocker locker(this);
     QString asc=SoftPV_Name(pv, w);
     if(!getSoftPV(pv, &indx, (QWidget*) w)) {
         softPV_WidgetList.insert(asc, num);
@@ -239,35 +370,35 @@ void  MutexKnobData::BuildSoftPVList(QWidget *w)
 {
     char asc[MAXPVLEN+20];
     softlist softstruct;
-    QMutexLocker locker(&mutex);
+    GlobalLocker locker(this);
     softPV_List.clear();
     // go through all our monitors
     for(int i=0; i < KnobDataArraySize; i++) {
-        if(KnobData[i].index != -1 && KnobData[i].soft) {
-            QWidget *w1 = (QWidget*) KnobData[i].thisW;
+        if(Knob(i)->index != -1 && Knob(i)->soft) {
+            QWidget *w1 = (QWidget*) Knob(i)->thisW;
             // when the main widget corresponds keep it
             if(w == w1) {
-                sprintf(asc, "%s_%d_%p", KnobData[i].pv, KnobData[i].index, w);
-                softstruct.pv = QString(KnobData[i].pv);
-                softstruct.index = KnobData[i].index;
+                sprintf(asc, "%s_%d_%p", Knob(i)->pv, Knob(i)->index, w);
+                softstruct.pv = QString(Knob(i)->pv);
+                softstruct.index = Knob(i)->index;
                 softstruct.w = w;
                 softPV_List.insert(asc, softstruct);
-                //qDebug() << "insert softpv_list" << asc << KnobData[i].dispName ;
+                //qDebug() << "insert softpv_list" << asc << Knob(i)->dispName ;
             }
         }
         // for softpvs that were not yet known as soft pv, add them
-        if(KnobData[i].index != -1) {
+        if(Knob(i)->index != -1) {
             int index;
-            if(getSoftPV(KnobData[i].pv, &index, (QWidget *) KnobData[i].thisW)) {
+            if(getSoftPV(Knob(i)->pv, &index, (QWidget *) Knob(i)->thisW)) {
                 mutex.unlock();
-                sprintf(asc, "%s_%d_%p", KnobData[i].pv, KnobData[i].index, w);
-                softstruct.pv = QString(KnobData[i].pv);
-                softstruct.index = KnobData[i].index;
+                sprintf(asc, "%s_%d_%p", Knob(i)->pv, Knob(i)->index, w);
+                softstruct.pv = QString(Knob(i)->pv);
+                softstruct.index = Knob(i)->index;
                 softstruct.w = w;
                 softPV_List.insert(asc, softstruct);
-                InsertSoftPV(KnobData[i].pv, KnobData[i].index, (QWidget *) KnobData[i].thisW);
-                //qDebug() << "insert untill now unknown pv" << asc << KnobData[i].index;
-                mutex.lock();
+                InsertSoftPV(Knob(i)->pv, Knob(i)->index, (QWidget *) Knob(i)->thisW);
+                //qDebug() << "insert untill now unknown pv" << asc << Knob(i)->index;
+                LockGlobal();
             }
         }
     }
@@ -289,7 +420,7 @@ void  MutexKnobData::BuildSoftPVList(QWidget *w)
 void MutexKnobData::RemoveSoftPV(QString pv, QWidget *w, int indx)
 {
     //char asc[MAXPVLEN+20];
-    QMutexLocker locker(&mutex);
+    GlobalLocker locker(this);
     // remove from the softpv list
     //sprintf(asc, "%s_%p", qasc(pv),  w);
     QString asc=SoftPV_Name(pv, w);
@@ -297,8 +428,8 @@ void MutexKnobData::RemoveSoftPV(QString pv, QWidget *w, int indx)
 
     // and remove from the global list
     char asc1[MAXPVLEN+20];
-    QWidget *w1 = (QWidget*) KnobData[indx].thisW;
-    sprintf(asc1, "%s_%d_%p",  KnobData[indx].pv, KnobData[indx].index,  w1);
+    QWidget *w1 = (QWidget*) Knob(indx)->thisW;
+    sprintf(asc1, "%s_%d_%p",  Knob(indx)->pv, Knob(indx)->index,  w1);
     softPV_List.remove(asc1);
 
 /*
@@ -361,32 +492,32 @@ void MutexKnobData::UpdateSoftPV(QString pv, double value, QWidget *w, int dataI
         softstruct = i.value();
         if(pv == softstruct.pv) {
             int indx = softstruct.index;
-            if(KnobData[indx].index != -1 && KnobData[indx].pv == pv && softstruct.w == w) {
+            if(Knob(indx)->index != -1 && Knob(indx)->pv == pv && softstruct.w == w) {
                 //qDebug() <<  "     update index=" << softstruct.index << i.key() <<  w << "with" << value;
 
                 // simple double
                 if(dataCount <= 1) {
-                    KnobData[indx].edata.rvalue = value;
+                    Knob(indx)->edata.rvalue = value;
 
                 // waveform
                 } else {
                     // allocate and initialize data to nan
-                    if((int) (dataCount * sizeof(double)) !=  KnobData[indx].edata.dataSize) {
-                        if( KnobData[indx].edata.dataB != (void*) Q_NULLPTR) free( KnobData[indx].edata.dataB);
-                        KnobData[indx].edata.dataB = (void*) malloc(dataCount * sizeof(double));
-                        double *data = (double *) KnobData[indx].edata.dataB;
+                    if((int) (dataCount * sizeof(double)) !=  Knob(indx)->edata.dataSize) {
+                        if( Knob(indx)->edata.dataB != (void*) Q_NULLPTR) free( Knob(indx)->edata.dataB);
+                        Knob(indx)->edata.dataB = (void*) malloc(dataCount * sizeof(double));
+                        double *data = (double *) Knob(indx)->edata.dataB;
                         for(int i=0; i<dataCount; i++) data[i] = qQNaN();
                     }
-                    KnobData[indx].edata.dataSize = dataCount * sizeof(double);
-                    KnobData[indx].edata.valueCount = dataCount;
-                    KnobData[indx].edata.rvalue = value;
+                    Knob(indx)->edata.dataSize = dataCount * sizeof(double);
+                    Knob(indx)->edata.valueCount = dataCount;
+                    Knob(indx)->edata.rvalue = value;
                 }
-                KnobData[indx].edata.fieldtype = caDOUBLE;
-                KnobData[indx].edata.precision = 3;
-                KnobData[indx].edata.connected = true;
-                KnobData[indx].edata.upper_disp_limit=0.0;
-                KnobData[indx].edata.lower_disp_limit=0.0;
-                KnobData[indx].edata.connected = true;
+                Knob(indx)->edata.fieldtype = caDOUBLE;
+                Knob(indx)->edata.precision = 3;
+                Knob(indx)->edata.connected = true;
+                Knob(indx)->edata.upper_disp_limit=0.0;
+                Knob(indx)->edata.lower_disp_limit=0.0;
+                Knob(indx)->edata.connected = true;
             }
         }
     }
@@ -409,19 +540,136 @@ bool MutexKnobData::getSoftPV(QString pv, int *indx, QWidget *w)
     return false;
 }
 
+/**
+ * global lock, contention is counted
+ */
+void MutexKnobData::LockGlobal()
+{
+    if(!mutex.tryLock()) {
+        mutex.lock();
+        globalLock.contended++;
+    }
+    globalLock.acquired++;
+}
+
+/**
+ * lock of the value fields of a slot, contention is counted
+ */
+QMutex *MutexKnobData::LockStripe(int index)
+{
+    int stripe = index % KNOBSTRIPES;
+    if(!stripeMutex[stripe].tryLock()) {
+        stripeMutex[stripe].lock();
+        stripeLock[stripe].contended++;
+    }
+    stripeLock[stripe].acquired++;
+    return &stripeMutex[stripe];
+}
+
 /**
  * get a copy for a knob
  */
 knobData MutexKnobData::GetMutexKnobData(int index)
 {
     knobData kData;
-    QMutexLocker locker(&mutex);
-
-    memcpy(&kData, &KnobData[index], sizeof(knobData));
-    memcpy(&kData.edata, &KnobData[index].edata, sizeof(epicsData));
+    LockGlobal();
+    QMutex *stripe = LockStripe(index);
+    memcpy(&kData, Knob(index), sizeof(knobData));
+    stripe->unlock();
+    mutex.unlock();
     return kData;
 }
 
+/**
+ * get the value fields of a knob, false when the slot is not used,
+ * when used the slot can not be reclaimed before ReleaseMutexKnobDataValue is called
+ */
+bool MutexKnobData::GetMutexKnobDataValue(int index, knobValue *value)
+{
+    if((index < 0) || (index >= KnobDataArraySize)) {
+        value->index = -1;
+        return false;
+    }
+
+    if(!fieldAccess) LockGlobal();
+    QMutex *stripe = LockStripe(index);
+    knobToValue(Knob(index), value);
+    if(value->index != -1) Statistics(index)->readers++;
+    stripe->unlock();
+    if(!fieldAccess) mutex.unlock();
+    return (value->index != -1);
+}
+
+/**
+ * the data callback does not use the value fields anymore
+ */
+void MutexKnobData::ReleaseMutexKnobDataValue(int index)
+{
+    if((index < 0) || (index >= KnobDataArraySize)) return;
+    QMutex *stripe = LockStripe(index);
+    if(Statistics(index)->readers > 0) Statistics(index)->readers--;
+    stripe->unlock();
+}
+
+extern "C" MutexKnobData* C_ReleaseMutexKnobDataValue(MutexKnobData* p, int indx)
+{
+    p->ReleaseMutexKnobDataValue(indx);
+    return p;
+}
+
+extern "C" MutexKnobData* C_GetMutexKnobDataValue(MutexKnobData* p, int indx, knobValue *value)
+{
+    p->GetMutexKnobDataValue(indx, value);
+    return p;
+}
+
+/**
+ * update the value fields of a knob with received data, only the stripe of the slot is locked
+ */
+void MutexKnobData::SetMutexKnobDataValue(int index, knobValue *value)
+{
+    struct timeb now;
+
+    // with direct updates the widget is updated from here, this needs the whole knob
+    if(!fieldAccess || myUpdateType == UpdateDirect) {
+        knobData kData = GetMutexKnobData(index);
+        if(kData.index == -1) return;
+        valueToKnob(value, &kData);
+        SetMutexKnobDataReceived(&kData);
+        return;
+    }
+
+    if((index >= 0) && (index < KnobDataArraySize)) {
+        QMutex *stripe = LockStripe(index);
+        knobData *kPtr = Knob(index);
+        if(kPtr->index != -1) {
+            // per slot statistics, a monitor not yet displayed will be overwritten by this one
+            knobStatistics *stat = Statistics(index);
+            if(kPtr->edata.monitorCount > kPtr->edata.displayCount) stat->coalesced++;
+            stat->monitorsReceived++;
+            if(value->dataB != (void*) Q_NULLPTR) stat->bytesReceived += value->dataSize;
+            if(displayStatistics && stat->pendingSince == 0.0) stat->pendingSince = msTime();
+            valueToKnob(value, kPtr);
+            stripeMonitors[index % KNOBSTRIPES]++;
+        }
+        stripe->unlock();
+    }
+
+    // global statistics every 5 seconds
+    ftime(&now);
+    if(now.time - monitorTiming.time >= 5) {
+        LockGlobal();
+        UpdateMonitorStatistics(now);
+        mutex.unlock();
+    }
+}
+
+extern "C" MutexKnobData* C_SetMutexKnobDataValue(MutexKnobData* p, int indx, knobValue *value)
+{
+    p->SetMutexKnobDataValue(indx, value);
+    return p;
+}
+
 extern "C" MutexKnobData* C_GetMutexKnobData(MutexKnobData* p, int indx, knobData *data)
 {
     *data = p->GetMutexKnobData(indx);
@@ -434,22 +682,16 @@ extern "C" MutexKnobData* C_GetMutexKnobData(MutexKnobData* p, int indx, knobDat
  */
 int MutexKnobData::GetMutexKnobDataIndex()
 {
-    int oldsize, newsize;
-    QMutexLocker locker(&mutex);
-    for(int i=0; i < KnobDataArraySize; i++) {
-        if(KnobData[i].index == -1) {
+    GlobalLocker locker(this);
+    while(true) {
+        if(freeSlots.isEmpty()) AllocateChunks(nbChunks);
+        int i = freeSlots.last();
+        freeSlots.removeLast();
+        if(Knob(i)->index == -1) {
+            memset(Statistics(i), 0, sizeof(knobStatistics));
             return i;
         }
     }
-    oldsize=KnobDataArraySize;
-    newsize = KnobDataArraySize+200;
-    void *p = &KnobData;
-    ReAllocate(oldsize * (int) sizeof(knobData), newsize * (int) sizeof(knobData), (void**) p);
-    for(int i=oldsize; i < newsize; i++){
-        KnobData[i].index  = -1;
-    }
-    KnobDataArraySize=newsize;
-    return oldsize;
 }
 //*********************************************************************************************************************
 
@@ -467,9 +709,222 @@ int MutexKnobData::GetMutexKnobDataSize()
  */
 void MutexKnobData::SetMutexKnobData(int index, knobData data)
 {
-    QMutexLocker locker(&mutex);
-    if (KnobData&&(index<KnobDataArraySize))
-        memcpy(&KnobData[index], &data, sizeof(knobData));
+    LockGlobal();
+    if ((index >= 0) && (index < KnobDataArraySize)) {
+        QMutex *stripe = LockStripe(index);
+        void *oldW = Knob(index)->thisW;
+        memcpy(Knob(index), &data, sizeof(knobData));
+        stripe->unlock();
+        if(oldW != data.thisW) {
+            SetWindowSlot(index, oldW, data.thisW);
+            if(data.thisW == (void*) Q_NULLPTR && data.index == -1) freeSlots.append(index);
+        }
+    }
+    mutex.unlock();
+}
+
+/**
+ * keep the slots of every window, so that a window does not have to look at all slots
+ */
+void MutexKnobData::SetWindowSlot(int index, void *oldW, void *newW)
+{
+    if(oldW != (void*) Q_NULLPTR) {
+        QHash<void*, QSet<int> >::iterator it = windowSlots.find(oldW);
+        if(it != windowSlots.end()) {
+            it.value().remove(index);
+            if(it.value().isEmpty()) windowSlots.erase(it);
+        }
+    }
+    if(newW != (void*) Q_NULLPTR) windowSlots[newW].insert(index);
+}
+
+/**
+ * get the slots used by a window, released slots of which the memory was not yet freed are included
+ */
+QList<int> MutexKnobData::GetMutexKnobDataWindowSlots(void *thisW)
+{
+    GlobalLocker locker(this);
+    QList<int> list;
+    foreach(int index, windowSlots.value(thisW)) list.append(index);
+    std::sort(list.begin(), list.end());
+    return list;
+}
+
+/**
+ * a released slot (index -1) of a closed window is kept aside until no data callback can use it anymore,
+ * the gui does not have to wait for this
+ */
+void MutexKnobData::RetireMutexKnobDataSlot(int index, ControlsInterface *plugin)
+{
+    GlobalLocker locker(this);
+    if((index < 0) || (index >= KnobDataArraySize)) return;
+    knobData *kPtr = Knob(index);
+    if(kPtr->index != -1 || kPtr->thisW == (void*) Q_NULLPTR) return;
+    SetWindowSlot(index, kPtr->thisW, (void*) Q_NULLPTR);
+    kPtr->thisW = (void*) Q_NULLPTR;
+    RetireSlot(index, plugin);
+}
+
+void MutexKnobData::RetireSlot(int index, ControlsInterface *plugin)
+{
+    retiredSlot retired;
+    retired.index = index;
+    retired.plugin = plugin;
+    retired.epoch = timerEpoch;
+    retired.since = msTime();
+    retiredSlots.append(retired);
+}
+
+/**
+ * free the data of the retired slots that are not used anymore and put them back into the free list
+ */
+void MutexKnobData::ReclaimRetiredSlots()
+{
+    QVector<retiredSlot> ready;
+    double now = msTime();
+    LockGlobal();
+    for(int i=retiredSlots.size()-1; i >= 0; i--) {
+        const retiredSlot &retired = retiredSlots.at(i);
+        if(timerEpoch - retired.epoch < RETIRE_EPOCHS || now - retired.since < RETIRE_GRACE_MS) continue;
+        QMutex *stripe = LockStripe(retired.index);
+        int readers = Statistics(retired.index)->readers;
+        stripe->unlock();
+        if(readers > 0) continue;
+        ready.append(retired);
+        retiredSlots.remove(i);
+    }
+    mutex.unlock();
+    if(ready.isEmpty()) return;
+
+    // the plugins lock the data mutex of the slot, this is done without holding our lock
+    for(int i=0; i < ready.size(); i++) {
+        knobData *kPtr = Knob(ready.at(i).index);
+        if(ready.at(i).plugin != (ControlsInterface *) Q_NULLPTR) ready.at(i).plugin->pvFreeAllocatedData(kPtr);
+        if(kPtr->mutex != (void*) Q_NULLPTR) {
+            QMutex *datamutex = (QMutex *) kPtr->mutex;
+            delete datamutex;
+            kPtr->mutex = (void*) Q_NULLPTR;
+        }
+    }
+
+    GlobalLocker locker(this);
+    for(int i=0; i < ready.size(); i++) freeSlots.append(ready.at(i).index);
+}
+
+/**
+ * channels of the same plugin and pv can take over a lingering slot
+ */
+QString MutexKnobData::LingerKey(const knobData *kPtr)
+{
+    return QString("%1:%2://%3").arg(kPtr->pluginName).arg(kPtr->pluginFlavor).arg(kPtr->pv);
+}
+
+/**
+ * keep the channel of a slot of a closing window connected for a while, the slot is detached from its widget,
+ * false when the channel has to be cleared now
+ */
+bool MutexKnobData::LingerMutexKnobDataSlot(int index)
+{
+    if(lingerSeconds <= 0.0) return false;
+    GlobalLocker locker(this);
+    if((index < 0) || (index >= KnobDataArraySize)) return false;
+    knobData *kPtr = Knob(index);
+    if(kPtr->index == -1 || kPtr->soft || kPtr->thisW == (void*) Q_NULLPTR) return false;
+    // a suspended monitor has no actual value
+    if(Statistics(index)->suspended) return false;
+    // the other plugins keep requests for the widget
+    QString pluginName(kPtr->pluginName);
+    if(pluginName != "epics3" && pluginName != "epics4") return false;
+
+    QMutex *stripe = LockStripe(index);
+    SetWindowSlot(index, kPtr->thisW, (void*) Q_NULLPTR);
+    kPtr->thisW = (void*) Q_NULLPTR;
+    kPtr->dispW = (void*) Q_NULLPTR;
+    stripe->unlock();
+
+    lingerSlots.insert(LingerKey(kPtr), index);
+    lingerUntil.insert(index, msTime() + lingerSeconds * 1000.0);
+    return true;
+}
+
+/**
+ * take over a lingering slot for a new channel, the slot keeps its connection, last value, limits and enum strings
+ * and is displayed with the next timer; -1 when there is none
+ */
+int MutexKnobData::TakeLingeringMutexKnobDataSlot(knobData *kData, int rate)
+{
+    if(lingerSeconds <= 0.0 || kData->soft) return -1;
+    GlobalLocker locker(this);
+    QMultiHash<QString, int>::iterator it = lingerSlots.find(LingerKey(kData));
+    if(it == lingerSlots.end()) return -1;
+    int index = it.value();
+    lingerSlots.erase(it);
+    lingerUntil.remove(index);
+    lingerTaken++;
+
+    knobData *kPtr = Knob(index);
+    QMutex *stripe = LockStripe(index);
+    kPtr->thisW = kData->thisW;
+    kPtr->dispW = kData->dispW;
+    memcpy(kPtr->specData, kData->specData, sizeof(int) * NBSPECS);
+    kPtr->valPix = kData->valPix;
+    memcpy(kPtr->clasName, kData->clasName, MAXDISPLEN);
+    memcpy(kPtr->dispName, kData->dispName, MAXDISPLEN);
+    memcpy(kPtr->fileName, kData->fileName, MAXFILELEN);
+    kPtr->pluginInterface = kData->pluginInterface;
+    kPtr->edata.repRate = rate;
+    kPtr->edata.initialize = true;
+    kPtr->edata.unconnectCount = 0;
+    kPtr->edata.displayCount = kPtr->edata.monitorCount - 1;
+    kPtr->edata.lastTime.time = 0;
+    kData->index = index;
+    kData->mutex = kPtr->mutex;
+    kData->edata.info = kPtr->edata.info;
+    stripe->unlock();
+
+    SetWindowSlot(index, (void*) Q_NULLPTR, kPtr->thisW);
+    return index;
+}
+
+/**
+ * true when a channel of the same plugin and pv is lingering
+ */
+bool MutexKnobData::HasLingeringMutexKnobDataSlot(const knobData *kData)
+{
+    GlobalLocker locker(this);
+    return lingerSlots.contains(LingerKey(kData));
+}
+
+/**
+ * clear the channels that were not taken over in time
+ */
+void MutexKnobData::ExpireLingeringSlots()
+{
+    QList<int> expired;
+    double now = msTime();
+    LockGlobal();
+    QHash<int, double>::iterator it = lingerUntil.begin();
+    while(it != lingerUntil.end()) {
+        if(it.value() <= now) {
+            expired.append(it.key());
+            lingerSlots.remove(LingerKey(Knob(it.key())), it.key());
+            it = lingerUntil.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    mutex.unlock();
+
+    // the plugins wait for running callbacks when clearing, this is done without holding our lock
+    foreach(int index, expired) {
+        knobData kData = GetMutexKnobData(index);
+        ControlsInterface *plugin = (ControlsInterface *) kData.pluginInterface;
+        if(plugin != (ControlsInterface *) Q_NULLPTR) plugin->pvClearMonitor(&kData);
+        kData.index = -1;
+        SetMutexKnobData(index, kData);
+        GlobalLocker locker(this);
+        RetireSlot(index, plugin);
+    }
 }
 
 extern "C" MutexKnobData* C_SetMutexKnobData(MutexKnobData* p, int index, knobData data)
@@ -485,11 +940,11 @@ extern "C" MutexKnobData* C_SetMutexKnobData(MutexKnobData* p, int index, knobDa
 knobData* MutexKnobData::getMutexKnobDataPV(QWidget *widget, QString pv)
 {
     int loop = 0;
-    QMutexLocker locker(&mutex);
+    GlobalLocker locker(this);
     while (loop < 2) {
 
         for(int i=0; i < GetMutexKnobDataSize(); i++) {
-            knobData *kPtr = (knobData*) &KnobData[i];
+            knobData *kPtr = (knobData*) Knob(i);
             if(kPtr->index != -1) {
                 QWidget *w = (QWidget *) kPtr->dispW;
                 QString kpv(kPtr->pv);
@@ -520,8 +975,8 @@ knobData* MutexKnobData::getMutexKnobDataPV(QWidget *widget, QString pv)
  */
 knobData* MutexKnobData::GetMutexKnobDataPtr(int index)
 {
-    QMutexLocker locker(&mutex);
-    return (knobData*) &KnobData[index];
+    GlobalLocker locker(this);
+    return (knobData*) Knob(index);
 }
 //*********************************************************************************************************************
 
@@ -547,6 +1002,14 @@ extern "C" MutexKnobData* C_DataUnlock(MutexKnobData* p, knobData *kData) {
     p->DataUnlock(kData);
     return p;
 }
+extern "C" MutexKnobData* C_DataLockValue(MutexKnobData* p, knobValue *value) {
+    if(value->mutex != (void*) Q_NULLPTR) ((QMutex*) value->mutex)->lock();
+    return p;
+}
+extern "C" MutexKnobData* C_DataUnlockValue(MutexKnobData* p, knobValue *value) {
+    if(value->mutex != (void*) Q_NULLPTR) ((QMutex*) value->mutex)->unlock();
+    return p;
+}
 
 /**
  * update array with the received data
@@ -555,11 +1018,20 @@ void MutexKnobData::SetMutexKnobDataReceived(knobData *kData) {
     char units[40];
     char fec[40];
     char dataString[STRING_EXCHANGE_SIZE];
-    double diff;
     struct timeb now;
-    QMutexLocker locker(&mutex);
+    LockGlobal();
     int index = kData->index;
-    memcpy(&KnobData[index].edata, &kData->edata, sizeof(epicsData));
+    QMutex *stripe = LockStripe(index);
+
+    // per slot statistics, a monitor not yet displayed will be overwritten by this one
+    knobStatistics *stat = Statistics(index);
+    if((Knob(index)->index != -1) && (Knob(index)->edata.monitorCount > Knob(index)->edata.displayCount)) stat->coalesced++;
+    stat->monitorsReceived++;
+    if(kData->edata.dataB != (void*) Q_NULLPTR) stat->bytesReceived += kData->edata.dataSize;
+    if(displayStatistics && stat->pendingSince == 0.0) stat->pendingSince = msTime();
+
+    memcpy(&Knob(index)->edata, &kData->edata, sizeof(epicsData));
+    stripe->unlock();
 
     /*****************************************************************************************/
     // Statistics
@@ -575,25 +1047,7 @@ void MutexKnobData::SetMutexKnobDataReceived(knobData *kData) {
 
     // calculate after 5 seconds our statistics
     ftime(&now);
-    diff = ((double) now.time + (double) now.millitm / (double)1000) -
-            ((double) monitorTiming.time + (double) monitorTiming.millitm / (double)1000);
-
-    if(diff >= 5.0) {
-        ftime(&monitorTiming);
-        nbMonitorsPerSecond = (int) (nbMonitors/diff);
-        nbMonitors = 0;
-        // remember monitor count for all monitors
-        for(int i=0; i < GetMutexKnobDataSize(); i++) {
-            knobData *kPtr = (knobData*) &KnobData[i];
-            if(kPtr->index != -1) kPtr->edata.monitorCountPrev = kPtr->edata.monitorCount;
-        }
-
-        highestCountPerSecond = highestCount / (float) diff;
-        highestIndexPV = highestIndex;
-        highestCount = 0;
-        nbDisplayCountPerSecond =  (int) (displayCount/diff);
-        displayCount = 0;
-    }
+    UpdateMonitorStatistics(now);
 
     /*****************************************************************************************/
 
@@ -617,33 +1071,102 @@ void MutexKnobData::SetMutexKnobDataReceived(knobData *kData) {
             }
 
             kData->edata.displayCount = kData->edata.monitorCount;
-            locker.unlock();
-            UpdateWidget(index, dispW, units, fec, dataString, KnobData[index]);
+            mutex.unlock();
+            UpdateWidget(index, dispW, units, fec, dataString, *Knob(index));
             kData->edata.lastTime = now;
             kData->edata.initialize = false;
             displayCount++;
+            return;
         }
     }
+    mutex.unlock();
+}
+
+/**
+ * statistics over all slots, every 5 seconds; to be called with the global lock held
+ */
+void MutexKnobData::UpdateMonitorStatistics(struct timeb &now)
+{
+    double diff = ((double) now.time + (double) now.millitm / (double)1000) -
+            ((double) monitorTiming.time + (double) monitorTiming.millitm / (double)1000);
+    if(diff < 5.0) return;
+
+    ftime(&monitorTiming);
+
+    // monitors written through the field accessors are counted per stripe
+    for(int s=0; s < KNOBSTRIPES; s++) {
+        QMutex *stripe = LockStripe(s);
+        nbMonitors += stripeMonitors[s];
+        stripeMonitors[s] = 0;
+        stripe->unlock();
+    }
+    nbMonitorsPerSecond = (int) (nbMonitors/diff);
+    nbMonitors = 0;
+
+    // remember monitor count for all monitors
+    for(int i=0; i < GetMutexKnobDataSize(); i++) {
+        knobData *kPtr = (knobData*) Knob(i);
+        if(kPtr->index != -1) {
+            QMutex *stripe = LockStripe(i);
+            // find monitor with highest count since last time
+            if((kPtr->edata.monitorCount - kPtr->edata.monitorCountPrev) > highestCount) {
+                highestCount = kPtr->edata.monitorCount - kPtr->edata.monitorCountPrev;
+                highestIndex = i;
+            }
+            kPtr->edata.monitorCountPrev = kPtr->edata.monitorCount;
+            knobStatistics *sPtr = Statistics(i);
+            sPtr->monitorsPerSecond = (float) ((sPtr->monitorsReceived - sPtr->monitorsPrev) / diff);
+            sPtr->displaysPerSecond = (float) ((sPtr->displaysDone - sPtr->displaysPrev) / diff);
+            sPtr->monitorsPrev = sPtr->monitorsReceived;
+            sPtr->displaysPrev = sPtr->displaysDone;
+            stripe->unlock();
+        }
+    }
+
+    highestCountPerSecond = highestCount / (float) diff;
+    highestIndexPV = highestIndex;
+    highestCount = 0;
+    nbDisplayCountPerSecond =  (int) (displayCount/diff);
+    displayCount = 0;
+    nbDeferredPerSecond = (int) (nbDeferred/diff);
+    nbDeferred = 0;
+}
+
+/**
+ * how often the global lock and the striped locks were taken and how often somebody had to wait
+ */
+void MutexKnobData::getLockStatistics(qint64 &globalAcquired, qint64 &globalContended, qint64 &stripeAcquired, qint64 &stripeContended)
+{
+    GlobalLocker locker(this);
+    globalAcquired = globalLock.acquired;
+    globalContended = globalLock.contended;
+    stripeAcquired = stripeContended = 0;
+    for(int s=0; s < KNOBSTRIPES; s++) {
+        stripeMutex[s].lock();
+        stripeAcquired += stripeLock[s].acquired;
+        stripeContended += stripeLock[s].contended;
+        stripeMutex[s].unlock();
+    }
 }
 
 int MutexKnobData::getMonitorsPerSecond()
 {
-    QMutexLocker locker(&mutex);
+    GlobalLocker locker(this);
     return nbMonitorsPerSecond;
 }
 
 int MutexKnobData::getDisplaysPerSecond()
 {
-    QMutexLocker locker(&mutex);
+    GlobalLocker locker(this);
     return nbDisplayCountPerSecond;
 }
 
 float MutexKnobData::getHighestCountPV(QString &pv)
 {
-    QMutexLocker locker(&mutex);
+    GlobalLocker locker(this);
 
-    if(KnobData[highestIndexPV].index != -1) {
-        pv = KnobData[highestIndexPV].pv;
+    if(Knob(highestIndexPV)->index != -1) {
+        pv = Knob(highestIndexPV)->pv;
         return highestCountPerSecond;
     } else {
         return 0.0;
@@ -652,11 +1175,225 @@ float MutexKnobData::getHighestCountPV(QString &pv)
 
 void MutexKnobData::initHighestCountPV()
 {
-    QMutexLocker locker(&mutex);
+    GlobalLocker locker(this);
     ftime(&monitorTiming);
     highestCount = 0;
 }
 
+/**
+ * the latencies are only measured while the statistics are displayed or written,
+ * they start again from the monitors received after switching them on
+ */
+void MutexKnobData::setDisplayStatistics(bool on)
+{
+    GlobalLocker locker(this);
+    if(on && !displayStatistics) {
+        for(int i=0; i < KnobDataArraySize; i++) {
+            QMutex *stripe = LockStripe(i);
+            knobStatistics *stat = Statistics(i);
+            stat->pendingSince = 0.0;
+            stat->latencySum = stat->latencyMax = 0.0;
+            stat->latencyCount = 0;
+            stripe->unlock();
+        }
+    }
+    displayStatistics = on;
+}
+
+/**
+ * a widget has been updated with the data of this slot, keep the latency since the data were received;
+ * only done while the statistics are displayed or written, as it takes the global lock for every widget update
+ */
+void MutexKnobData::SetMutexKnobDataDisplayed(int index)
+{
+    if(!displayStatistics) return;
+    GlobalLocker locker(this);
+    if((index < 0) || (index >= KnobDataArraySize)) return;
+    QMutex *stripe = LockStripe(index);
+    knobStatistics *stat = Statistics(index);
+    stat->displaysDone++;
+    if(stat->pendingSince > 0.0) {
+        double latency = msTime() - stat->pendingSince;
+        if(latency < 0.0) latency = 0.0;
+        stat->latencySum += latency;
+        stat->latencyCount++;
+        if(latency > stat->latencyMax) stat->latencyMax = latency;
+        stat->pendingSince = 0.0;
+    }
+    stripe->unlock();
+}
+
+/**
+ * get a copy of the statistics for a slot
+ */
+bool MutexKnobData::GetMutexKnobStatistics(int index, knobStatistics &stat)
+{
+    GlobalLocker locker(this);
+    if((index < 0) || (index >= KnobDataArraySize) || (Knob(index)->index == -1)) return false;
+    memcpy(&stat, Statistics(index), sizeof(knobStatistics));
+    return true;
+}
+
+/**
+ * get the metadata shared by the slots of the pv, the global lock is not taken as the display update may hold it;
+ * a slot keeps its pv until released, two threads asking at the same time get the same object
+ */
+ChannelMetadata *MutexKnobData::GetMutexKnobDataMetadata(int index)
+{
+    if((index < 0) || (index >= KnobDataArraySize)) return (ChannelMetadata*) Q_NULLPTR;
+    knobStatistics *stat = Statistics(index);
+    if(stat->metadata == (ChannelMetadata*) Q_NULLPTR) {
+        stat->metadata = ChannelMetadata::intern(Knob(index)->pluginName, Knob(index)->pv);
+    }
+    return stat->metadata;
+}
+
+/**
+ * mark a slot whose monitor was suspended or slowed down because its widget can not be seen
+ */
+void MutexKnobData::SetMutexKnobDataSuspended(int index, bool suspended, int savedRepRate)
+{
+    GlobalLocker locker(this);
+    if((index < 0) || (index >= KnobDataArraySize)) return;
+    Statistics(index)->suspended = suspended;
+    Statistics(index)->savedRepRate = savedRepRate;
+}
+
+bool MutexKnobData::GetMutexKnobDataSuspended(int index, int *savedRepRate)
+{
+    GlobalLocker locker(this);
+    if((index < 0) || (index >= KnobDataArraySize)) return false;
+    if(savedRepRate != (int*) Q_NULLPTR) *savedRepRate = Statistics(index)->savedRepRate;
+    return Statistics(index)->suspended;
+}
+
+void MutexKnobData::SetMutexKnobDataRepRate(int index, int rate)
+{
+    GlobalLocker locker(this);
+    if((index < 0) || (index >= KnobDataArraySize) || (Knob(index)->index == -1)) return;
+    Knob(index)->edata.repRate = rate;
+}
+
+/**
+ * number of subscriptions actually suspended or slowed down
+ */
+int MutexKnobData::getSuspendedCount()
+{
+    GlobalLocker locker(this);
+    int count = 0;
+    for(int i=0; i < KnobDataArraySize; i++) {
+        if(Knob(i)->index != -1 && Statistics(i)->suspended) count++;
+    }
+    return count;
+}
+
+/**
+ * number of noisy channels actually slowed down because of the display budget
+ */
+int MutexKnobData::getThrottledCount()
+{
+    GlobalLocker locker(this);
+    int count = 0;
+    for(int i=0; i < KnobDataArraySize; i++) {
+        if(Knob(i)->index != -1 && Statistics(i)->throttle > 1) count++;
+    }
+    return count;
+}
+
+/**
+ * escape a string of a slot for the json document
+ */
+static QString jsonString(const char *str)
+{
+    QString escaped;
+    QString in = QString::fromLatin1(str);
+    for(int i=0; i < in.size(); i++) {
+        QChar c = in.at(i);
+        if(c == '"' || c == '\\') {
+            escaped.append('\\');
+            escaped.append(c);
+        } else if(c.unicode() < 0x20) {
+            escaped.append(QString("\\u%1").arg((int) c.unicode(), 4, 16, QChar('0')));
+        } else {
+            escaped.append(c);
+        }
+    }
+    return escaped;
+}
+
+/**
+ * statistics of all slots as json document
+ */
+QString MutexKnobData::getStatisticsJSON()
+{
+    QString json;
+    QTextStream out(&json);
+    struct timeb now;
+    ftime(&now);
+    GlobalLocker locker(this);
+
+    out << "{\n";
+    out << "  \"time\": " << (qint64) now.time << ",\n";
+    out << "  \"monitorsPerSecond\": " << nbMonitorsPerSecond << ",\n";
+    out << "  \"displaysPerSecond\": " << nbDisplayCountPerSecond << ",\n";
+    qint64 stripeAcquired = 0, stripeContended = 0;
+    for(int s=0; s < KNOBSTRIPES; s++) {
+        stripeAcquired += stripeLock[s].acquired;
+        stripeContended += stripeLock[s].contended;
+    }
+    out << "  \"locks\": {\"fieldAccess\": " << (fieldAccess ? "true" : "false")
+        << ", \"globalAcquired\": " << globalLock.acquired << ", \"globalContended\": " << globalLock.contended
+        << ", \"stripeAcquired\": " << stripeAcquired << ", \"stripeContended\": " << stripeContended << "},\n";
+    out << "  \"slots\": {\"size\": " << KnobDataArraySize << ", \"free\": " << freeSlots.size()
+        << ", \"retiring\": " << retiredSlots.size() << ", \"lingering\": " << lingerUntil.size() << "},\n";
+    out << "  \"channels\": [";
+    bool first = true;
+    for(int i=0; i < KnobDataArraySize; i++) {
+        knobData *kPtr = Knob(i);
+        if(kPtr->index == -1) continue;
+        knobStatistics *sPtr = Statistics(i);
+        double latencyAvg = (sPtr->latencyCount > 0) ? sPtr->latencySum / (double) sPtr->latencyCount : 0.0;
+        out << (first ? "\n" : ",\n");
+        out << "    {\"index\": " << i
+            << ", \"pv\": \"" << jsonString(kPtr->pv) << "\""
+            << ", \"class\": \"" << jsonString(kPtr->clasName) << "\""
+            << ", \"object\": \"" << jsonString(kPtr->dispName) << "\""
+            << ", \"plugin\": \"" << jsonString(kPtr->pluginName) << "\""
+            << ", \"file\": \"" << jsonString(kPtr->fileName) << "\""
+            << ", \"window\": \"" << QString::number((quintptr) kPtr->thisW, 16) << "\""
+            << ", \"connected\": " << (kPtr->edata.connected ? "true" : "false")
+            << ", \"monitors\": " << sPtr->monitorsReceived
+            << ", \"displays\": " << sPtr->displaysDone
+            << ", \"coalesced\": " << sPtr->coalesced
+            << ", \"bytes\": " << sPtr->bytesReceived
+            << ", \"monitorsPerSecond\": " << sPtr->monitorsPerSecond
+            << ", \"displaysPerSecond\": " << sPtr->displaysPerSecond
+            << ", \"suspended\": " << (sPtr->suspended ? "true" : "false")
+            << ", \"throttle\": " << qMax(1, sPtr->throttle)
+            << ", \"latencyAvgMs\": " << latencyAvg
+            << ", \"latencyMaxMs\": " << sPtr->latencyMax << "}";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+    out.flush();
+    return json;
+}
+
+/**
+ * write the statistics to a file, a temporary file is renamed so that readers never see a partial document
+ */
+bool MutexKnobData::dumpStatistics(const QString &fileName)
+{
+    QString json = getStatisticsJSON();
+    QString tmpName = fileName + ".tmp";
+    QFile file(tmpName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+    file.write(json.toUtf8());
+    file.close();
+    QFile::remove(fileName);
+    return QFile::rename(tmpName, fileName);
+}
+
 extern "C" MutexKnobData* C_SetMutexKnobDataReceived(MutexKnobData* p, knobData *kData)
 {
     p->SetMutexKnobDataReceived(kData);
@@ -669,6 +1406,11 @@ extern "C" MutexKnobData* C_SetMutexKnobDataReceived(MutexKnobData* p, knobData
   */
 void MutexKnobData::timerEvent(QTimerEvent *)
 {
+    // slots of closed windows
+    timerEpoch++;
+    if(!lingerUntil.isEmpty()) ExpireLingeringSlots();
+    if(!retiredSlots.isEmpty()) ReclaimRetiredSlots();
+
     if (suppressUpdates) {
         return;
     }
@@ -681,36 +1423,41 @@ void MutexKnobData::timerEvent(QTimerEvent *)
 
     ftime(&now);
 
-    // do we have something that should go faster then 5 Hz, then change timer, but change back when nothing fast requested
-    for(int i=0; i < GetMutexKnobDataSize(); i++) {
-        knobData *kPtr = (knobData*) &KnobData[i];
-        if(kPtr->index != -1) {
-          if(kPtr->edata.repRate > repetitionRate) repetitionRate = kPtr->edata.repRate;
-          if(repetitionRate > 50) repetitionRate = 50;  // not more than 50Hz
-        }
-    }
-    if(repetitionRate != prvRepetitionRate) {
-        killTimer(timerId);
-        timerId = startTimer(1000/repetitionRate);
-        //qDebug() << repetitionRate << prvRepetitionRate << 1000/repetitionRate << "ms";
-        prvRepetitionRate = repetitionRate;
-    }
+    // with a display budget the widgets to update are first collected, the widget under the mouse gets priority
+    bool useBudget = (displayBudgetMs > 0.0) || (windowBudget > 0);
+    QVector<displayCandidate> candidates;
+    QWidget *hovered = (QWidget*) Q_NULLPTR;
+    if(useBudget) hovered = QApplication::widgetAt(QCursor::pos());
 
     //int number = 0;
     //qDebug() << "============================================";
     for(int i=0; i < GetMutexKnobDataSize(); i++) {
-        knobData *kPtr = (knobData*) &KnobData[i];
+        knobData *kPtr = (knobData*) Knob(i);
+        if(kPtr->index == -1) continue;
 
-        if(kPtr->index != -1) {
-            diff = ((double) now.time + (double) now.millitm / (double)1000) -
-                    ((double) kPtr->edata.lastTime.time + (double) kPtr->edata.lastTime.millitm / (double)1000);
-            if(kPtr->edata.repRate < 1) repRate = 1;
-            else repRate = kPtr->edata.repRate;
-        }
+        // the counters, the rate and the connection are written by the plugins holding only the stripe lock
+        QMutex *stripe = LockStripe(i);
+        int slotRate = kPtr->edata.repRate;
+        struct timeb lastTime = kPtr->edata.lastTime;
+        int monitors = kPtr->edata.monitorCount;
+        int displays = kPtr->edata.displayCount;
+        bool connected = kPtr->edata.connected;
+        stripe->unlock();
+
+        // do we have something that should go faster then 5 Hz, then change timer, but change back when nothing fast requested
+        if(slotRate > repetitionRate) repetitionRate = qMin(slotRate, 50);  // not more than 50Hz
+
+        // a lingering channel has no widget
+        if(kPtr->dispW == (void*) Q_NULLPTR) continue;
+
+        diff = ((double) now.time + (double) now.millitm / (double)1000) -
+                ((double) lastTime.time + (double) lastTime.millitm / (double)1000);
+        if(slotRate < 1) repRate = 1;
+        else repRate = slotRate;
 
         // update all graphical items for this soft pv when a value changes
 
-        if(kPtr->index != -1 && kPtr->soft && (diff >= (2.0/(double)repRate))) {
+        if(kPtr->soft && (diff >= (2.0/(double)repRate))) {
 
             int indx;
 
@@ -722,9 +1469,10 @@ void MutexKnobData::timerEvent(QTimerEvent *)
                 bool update = false;
                 bool treatit = false;
                 QWidget *w1 =  (QWidget*) kPtr->dispW;
-                QString className = w1->metaObject()->className();
-                if(className.contains("caStripPlot") || className.contains("caWaterfallPlot")) treatit = true;
-                else if(w1->property("hidden").value<bool>()) treatit = false;
+                WidgetBinding *binding = WidgetBinding::get(w1);
+                if(binding == (WidgetBinding *) Q_NULLPTR) treatit = true;
+                else if(binding->keepsHistory) treatit = true;
+                else if(binding->hidden) treatit = false;
                 else treatit = true;
                 if(caCalc* calcWidget = qobject_cast<caCalc *>(w1)) {
                    if(calcWidget->getEventSignal() != caCalc::Never) treatit = true;
@@ -732,7 +1480,7 @@ void MutexKnobData::timerEvent(QTimerEvent *)
 
                 if(treatit) {
                     // get value from (updated) QMap variable list
-                    knobData *ptr = (knobData*) &KnobData[indx];
+                    knobData *ptr = (knobData*) Knob(indx);
                     kPtr->edata.fieldtype = caDOUBLE;
                     kPtr->edata.accessW = true;
                     kPtr->edata.accessR = true;
@@ -755,17 +1503,12 @@ void MutexKnobData::timerEvent(QTimerEvent *)
                     kPtr->edata.connected = true;
 
                     // when no update then when any monitors for calculation increase monitorcount when underlying pv changes or when its calculates on itsself
-                    QWidget *w1 =  (QWidget*) kPtr->dispW;
                     if((!update) && (ptr->edata.valueCount) == 0) {
-                        QVariant var = w1->property("MonitorList");
-                        QVariantList list = var.toList();
-                        if((list.size() > 0)) {
-                            int nbMonitors = list.at(0).toInt();
-                            if(nbMonitors > 0)  update = true;
-                        }
+                        if((binding != (WidgetBinding *) Q_NULLPTR) && (binding->monitors.size() > 0)) update = true;
                     }
 
                     if(update) kPtr->edata.monitorCount++;
+                    monitors = kPtr->edata.monitorCount;
                     kPtr->edata.oldsoftvalue = ptr->edata.rvalue;
                     QWidget *ww = (QWidget *)kPtr->dispW;
                     if (caTextEntry *widget = qobject_cast<caTextEntry *>(ww)) {
@@ -776,42 +1519,43 @@ void MutexKnobData::timerEvent(QTimerEvent *)
         }
 
         // use specified repetition rate (normally 5Hz)
-        if( ((kPtr->index != -1) && (kPtr->edata.monitorCount > kPtr->edata.displayCount) && (diff >= (1.0/(double)repRate)))){
+        if((monitors > displays) && (diff >= (1.0/(double)repRate))) {
 /*
             printf("<%s> index=%d mcount=%d dcount=%d value=%f ivalue=%d datasize=%d valuecount=%d\n", kPtr->pv, kPtr->index, kPtr->edata.monitorCount,
                                                                       kPtr->edata.displayCount, kPtr->edata.rvalue, kPtr->edata.ivalue,
                                                                       kPtr->edata.dataSize, kPtr->edata.valueCount);
 */
             if((myUpdateType == UpdateTimed) || kPtr->soft) {
-                QMutexLocker locker(&mutex);
-                int index = kPtr->index;
-                QWidget *dispW = (QWidget*) kPtr->dispW;
-                dataString[0] = '\0';
-                qstrncpy(units, kPtr->edata.units,caqtdm_string_t_length);
-                qstrncpy(fec, kPtr->edata.fec,caqtdm_string_t_length);
-                int caFieldType= kPtr->edata.fieldtype;
-
-                if((caFieldType == DBF_STRING || caFieldType == DBF_ENUM || caFieldType == DBF_CHAR) && kPtr->edata.dataB != (void*) Q_NULLPTR) {
-                    if(kPtr->edata.dataSize < STRING_EXCHANGE_SIZE) {
-                        memcpy(dataString, (char*) kPtr->edata.dataB, (size_t) kPtr->edata.dataSize);
-                        dataString[kPtr->edata.dataSize] = '\0';
-                    } else {
-                        memcpy(dataString, (char*) kPtr->edata.dataB, STRING_EXCHANGE_SIZE);
-                        dataString[STRING_EXCHANGE_SIZE-1] = '\0';
+                if(!useBudget) {
+                    DisplayKnobData(i, now);
+                } else {
+                    knobStatistics *sPtr = Statistics(i);
+                    QWidget *dispW = (QWidget*) kPtr->dispW;
+                    displayCandidate candidate;
+                    candidate.index = i;
+                    candidate.waiting = diff;
+                    candidate.priority = DISPLAY_PRIORITY_NORMAL;
+                    if(kPtr->edata.severity != sPtr->lastSeverity) {
+                        candidate.priority = DISPLAY_PRIORITY_HIGH;
+                    } else if(hovered != (QWidget*) Q_NULLPTR && dispW != (QWidget*) Q_NULLPTR && (dispW == hovered || dispW->isAncestorOf(hovered))) {
+                        candidate.priority = DISPLAY_PRIORITY_HIGH;
+                    } else if(sPtr->monitorsPerSecond > NOISY_MONITOR_FACTOR * repRate) {
+                        candidate.priority = DISPLAY_PRIORITY_LOW;
+                    }
+                    // only low priority channels stay throttled, a promoted channel starts again at full rate
+                    if(candidate.priority != DISPLAY_PRIORITY_LOW) sPtr->throttle = 0;
+                    // a throttled noisy channel is displayed at a fraction of its rate
+                    if(candidate.priority != DISPLAY_PRIORITY_LOW || sPtr->throttle < 2 || diff >= ((double) sPtr->throttle / repRate)) {
+                        candidates.append(candidate);
                     }
                 }
-
-                kPtr->edata.displayCount = kPtr->edata.monitorCount;
-                locker.unlock();
-                UpdateWidget(index, dispW, units, fec, dataString, KnobData[index]);
-                kPtr->edata.lastTime = now;
-                kPtr->edata.initialize = false;
-                displayCount++;
             }
 
-        } else if ((kPtr->index != -1)  && (diff >= (1.0/(double)repRate))) {
-            if( (!kPtr->edata.connected)) {
-                QMutexLocker locker(&mutex);
+        } else if (diff >= (1.0/(double)repRate)) {
+            if(!connected) {
+                knobData kData;
+                GlobalLocker locker(this);
+                stripe = LockStripe(i);
                 bool displayIt = false;
                 units[0] = '\0';
                 fec[0] = '\0';
@@ -825,10 +1569,115 @@ void MutexKnobData::timerEvent(QTimerEvent *)
                 }
                 kPtr->edata.unconnectCount++;
                 if(kPtr->edata.unconnectCount == 10) kPtr->edata.unconnectCount=0;
+                if(displayIt) memcpy(&kData, kPtr, sizeof(knobData));
+                stripe->unlock();
                 locker.unlock();
-                if(displayIt) UpdateWidget(index, (QWidget*) kPtr->dispW, units, fec, dataString, KnobData[index]);
+                if(displayIt) UpdateWidget(index, (QWidget*) kData.dispW, units, fec, dataString, kData);
+            }
+        }
+    }
+
+    if(repetitionRate != prvRepetitionRate) {
+        killTimer(timerId);
+        timerId = startTimer(1000/repetitionRate);
+        //qDebug() << repetitionRate << prvRepetitionRate << 1000/repetitionRate << "ms";
+        prvRepetitionRate = repetitionRate;
+    }
+    if(displayBudgetDefault) displayBudgetMs = 500.0 / repetitionRate;
+
+    if(candidates.size() > 0) DisplayWithinBudget(candidates, now);
+}
+
+/**
+ * display the data of a slot
+ */
+void MutexKnobData::DisplayKnobData(int i, struct timeb &now)
+{
+    char units[40];
+    char fec[40];
+    char dataString[STRING_EXCHANGE_SIZE];
+    knobData kData;
+    knobData *kPtr = (knobData*) Knob(i);
+    GlobalLocker locker(this);
+    QMutex *stripe = LockStripe(i);
+    int index = kPtr->index;
+    QWidget *dispW = (QWidget*) kPtr->dispW;
+    dataString[0] = '\0';
+    qstrncpy(units, kPtr->edata.units,caqtdm_string_t_length);
+    qstrncpy(fec, kPtr->edata.fec,caqtdm_string_t_length);
+    int caFieldType= kPtr->edata.fieldtype;
+
+    if((caFieldType == DBF_STRING || caFieldType == DBF_ENUM || caFieldType == DBF_CHAR) && kPtr->edata.dataB != (void*) Q_NULLPTR) {
+        if(kPtr->edata.dataSize < STRING_EXCHANGE_SIZE) {
+            memcpy(dataString, (char*) kPtr->edata.dataB, (size_t) kPtr->edata.dataSize);
+            dataString[kPtr->edata.dataSize] = '\0';
+        } else {
+            memcpy(dataString, (char*) kPtr->edata.dataB, STRING_EXCHANGE_SIZE);
+            dataString[STRING_EXCHANGE_SIZE-1] = '\0';
+        }
+    }
+
+    kPtr->edata.displayCount = kPtr->edata.monitorCount;
+    Statistics(i)->lastSeverity = kPtr->edata.severity;
+    memcpy(&kData, kPtr, sizeof(knobData));
+    stripe->unlock();
+    locker.unlock();
+    UpdateWidget(index, dispW, units, fec, dataString, kData);
+    kPtr->edata.lastTime = now;
+    kPtr->edata.initialize = false;
+    displayCount++;
+}
+
+bool MutexKnobData::displayCandidateLessThan(const displayCandidate &c1, const displayCandidate &c2)
+{
+    if(c1.priority != c2.priority) return c1.priority > c2.priority;
+    return c1.waiting > c2.waiting;
+}
+
+/**
+ * display the collected slots, highest priority and longest waiting first, until the budget of gui time for
+ * this period or the budget of updates per second of a window is used; the others stay pending for the next period.
+ * noisy channels come last and are slowed down while we can not display everything, sped up again when there is room.
+ */
+void MutexKnobData::DisplayWithinBudget(QVector<displayCandidate> &candidates, struct timeb &now)
+{
+    QElapsedTimer budgetTimer;
+    int deferred = 0;
+    bool overBudget = false;
+
+    std::sort(candidates.begin(), candidates.end(), displayCandidateLessThan);
+
+    // the updates of the windows are counted per second
+    if(now.time != windowUpdatesTime) {
+        windowUpdates.clear();
+        windowUpdatesTime = now.time;
+    }
+
+    budgetTimer.start();
+    for(int i=0; i < candidates.size(); i++) {
+        knobData *kPtr = (knobData*) Knob(candidates.at(i).index);
+        if(candidates.at(i).priority != DISPLAY_PRIORITY_HIGH) {
+            if(displayBudgetMs > 0.0 && (double) budgetTimer.elapsed() >= displayBudgetMs) overBudget = true;
+            if(overBudget || (windowBudget > 0 && windowUpdates.value(kPtr->thisW) >= windowBudget)) {
+                deferred++;
+                continue;
             }
         }
+        windowUpdates[kPtr->thisW]++;
+        DisplayKnobData(candidates.at(i).index, now);
+    }
+
+    budgetUsed = (displayBudgetMs > 0.0) ? (float) ((double) budgetTimer.elapsed() / displayBudgetMs) : 0.0;
+    nbDeferred += deferred;
+
+    for(int i=0; i < candidates.size(); i++) {
+        if(candidates.at(i).priority != DISPLAY_PRIORITY_LOW) continue;
+        knobStatistics *sPtr = Statistics(candidates.at(i).index);
+        if(deferred > 0) {
+            sPtr->throttle = qMin(MAX_DISPLAY_THROTTLE, qMax(1, sPtr->throttle) * 2);
+        } else if(budgetUsed < 0.5 && sPtr->throttle > 1) {
+            sPtr->throttle = sPtr->throttle / 2;
+        }
     }
 }
 
@@ -839,19 +1688,25 @@ void MutexKnobData::timerEvent(QTimerEvent *)
  */
 void MutexKnobData::SetMutexKnobDataConnected(int index, int connected)
 {
-    QMutexLocker locker(&mutex);
+    GlobalLocker locker(this);
 
-    if( KnobData[index].index == -1) return;
+    if( Knob(index)->index == -1) return;
 
-    KnobData[index].edata.connected = connected;
+    // the value fields are also written by the plugins holding only the stripe lock
+    knobData kData;
+    QMutex *stripe = LockStripe(index);
+    Knob(index)->edata.connected = connected;
 
 #ifdef epics4
-    connectInfoShort *tmp = (connectInfoShort *) KnobData[index].edata.info;
+    connectInfoShort *tmp = (connectInfoShort *) Knob(index)->edata.info;
     if (tmp != (connectInfoShort *) Q_NULLPTR) tmp->connected = connected;
 #endif
 
+    if(!connected) memcpy(&kData, Knob(index), sizeof(knobData));
+    stripe->unlock();
+
     if(!connected) {
-        UpdateWidget(index, (QWidget*)KnobData[index].dispW, (char*) " ", (char*) " ",  (char*) " ", KnobData[index]);
+        UpdateWidget(index, (QWidget*) kData.dispW, (char*) " ", (char*) " ",  (char*) " ", kData);
     }
 
 }
@@ -876,6 +1731,10 @@ QString getBufferAsHexStr(char* buf, int buffsize) {
 void MutexKnobData::UpdateWidget(int index, QWidget* w, char *units, char *fec, char *dataString, knobData knb)
 {
     QString unitsString;
+    ChannelMetadata *metadata = (ChannelMetadata*) Q_NULLPTR;
+
+    // lingering channel
+    if(w == (QWidget*) Q_NULLPTR) return;
 
     // Check whether this is specifically accessing the .EGU epics field
     bool isEguField = QString(knb.pv).endsWith(".EGU");
@@ -883,7 +1742,12 @@ void MutexKnobData::UpdateWidget(int index, QWidget* w, char *units, char *fec,
         // If it is, the unit is stored in the dataString
         unitsString = QString::fromLatin1(dataString);
     } else {
-        // If not, it is stored in the units string
+        // If not, it is stored in the units string, formatted already when the pv delivered the same units before
+        metadata = GetMutexKnobDataMetadata(index);
+        if(metadata != (ChannelMetadata*) Q_NULLPTR && metadata->cachedUnits(units, unitsString)) {
+            emit Signal_UpdateWidget(index, w, unitsString, fec, dataString, knb);
+            return;
+        }
         unitsString = QString::fromLatin1(units);
     }
 
@@ -908,6 +1772,7 @@ void MutexKnobData::UpdateWidget(int index, QWidget* w, char *units, char *fec,
 
     // This just reinterprets it as utf8
     unitsString = QString::fromUtf8(qasc(unitsString));
+    if(metadata != (ChannelMetadata*) Q_NULLPTR) metadata->setUnits(units, unitsString);
 
     // Send updated data to main thread
     if (isEguField) {
@@ -928,5 +1793,19 @@ extern "C" MutexKnobData* C_UpdateTextLine(MutexKnobData* p, char *message, char
     return p;
 }
 
+/**
+ * an asynchronous put was processed by the device, called from the thread of the plugin
+ */
+void MutexKnobData::PutCompleted(int token, bool ok)
+{
+    emit Signal_PutCompleted(token, ok);
+}
+
+extern "C" MutexKnobData* C_PutCompleted(MutexKnobData* p, int token, int ok) // wrapper function
+{
+    p->PutCompleted(token, ok != 0);
+    return p;
+}
+
 
 
@@ -41,6 +41,8 @@
 #include <QObject>
 #include <QVector>
 #include <QMap>
+#include <QHash>
+#include <QSet>
 #include <QPair>
 #include <QWaitCondition>
 #include "knobData.h"
@@ -48,6 +50,38 @@
 
 #define DEFAULTRATE 10
 
+class ControlsInterface;
+class ChannelMetadata;
+
+// per slot statistics, kept beside the knobData array in order not to change the structure shared with the plugins
+typedef struct _knobStatistics {
+    qint64 monitorsReceived;           /* number of monitors received */
+    qint64 displaysDone;               /* number of widget updates done */
+    qint64 coalesced;                  /* monitors overwritten before being displayed */
+    qint64 bytesReceived;              /* bytes of vector data received */
+    qint64 monitorsPrev;               /* monitors received at last statistics */
+    qint64 displaysPrev;               /* displays done at last statistics */
+    float  monitorsPerSecond;
+    float  displaysPerSecond;
+    double latencySum;                 /* sum of callback to paint latencies in ms */
+    double latencyMax;                 /* highest callback to paint latency in ms */
+    qint64 latencyCount;
+    double pendingSince;               /* receive time of the oldest not yet displayed monitor in ms */
+    int    suspended;                  /* monitor suspended or slowed down while the widget can not be seen */
+    int    savedRepRate;               /* repetition rate to restore when slowed down */
+    int    throttle;                   /* display rate divisor of a noisy channel while over the display budget */
+    short  lastSeverity;               /* severity at the last display, a change gets priority */
+    int    readers;                    /* data callbacks holding the value fields of the slot */
+    ChannelMetadata *metadata;         /* decoded metadata shared with the other slots of the pv */
+} knobStatistics;
+
+// the value fields of the slots are protected by one of these locks, so that data callbacks of different channels do not wait on each other
+#define KNOBSTRIPES 64
+
+// the slots are kept in chunks that never move, the number of chunks doubles when all slots are used
+#define KNOBCHUNKSIZE 512
+#define KNOBCHUNKS 1024
+
 class CAQTDM_LIBSHARED_EXPORT MutexKnobData: public QObject {
     Q_OBJECT
 
@@ -69,7 +103,17 @@ public:
     void SetMutexKnobData(int indx, knobData data);
     int GetMutexKnobDataIndex();
     int GetMutexKnobDataSize();
+    QList<int> GetMutexKnobDataWindowSlots(void *thisW);
+    void RetireMutexKnobDataSlot(int indx, ControlsInterface *plugin);
+    bool LingerMutexKnobDataSlot(int indx);
+    int TakeLingeringMutexKnobDataSlot(knobData *kData, int rate);
+    bool HasLingeringMutexKnobDataSlot(const knobData *kData);
+    double getLingerSeconds() const { return lingerSeconds; }
+    qint64 getLingerTaken() const { return lingerTaken; }
     void SetMutexKnobDataReceived(knobData *kData);
+    bool GetMutexKnobDataValue(int indx, knobValue *value);
+    void SetMutexKnobDataValue(int indx, knobValue *value);
+    void ReleaseMutexKnobDataValue(int indx);
     knobData *getMutexKnobDataPV(QWidget *widget, QString pv);
 
     void timerEvent(QTimerEvent *);
@@ -78,6 +122,7 @@ public:
 
     void UpdateWidget(int indx, QWidget* w,  char* units, char* fec, char* statusString, knobData knb);
     void UpdateTextLine(char *message, char *name);
+    void PutCompleted(int token, bool ok);
 
     void InsertSoftPV(QString pv, int num, QWidget* w);
     void RemoveSoftPV(QString pv, QWidget *w, int indx);
@@ -90,6 +135,22 @@ public:
     float getHighestCountPV(QString &pv);
     void initHighestCountPV();
 
+    void SetMutexKnobDataDisplayed(int indx);
+    void setDisplayStatistics(bool on);
+    bool getDisplayStatistics() const { return displayStatistics; }
+    bool GetMutexKnobStatistics(int indx, knobStatistics &stat);
+    ChannelMetadata *GetMutexKnobDataMetadata(int indx);
+    QString getStatisticsJSON();
+    void SetMutexKnobDataSuspended(int indx, bool suspended, int savedRepRate = 0);
+    bool GetMutexKnobDataSuspended(int indx, int *savedRepRate = 0);
+    void SetMutexKnobDataRepRate(int indx, int rate);
+    int getSuspendedCount();
+    int getThrottledCount();
+    int getDeferredPerSecond() const { return nbDeferredPerSecond; }
+    float getBudgetUsed() const { return budgetUsed; }
+    bool dumpStatistics(const QString &fileName);
+    void getLockStatistics(qint64 &globalAcquired, qint64 &globalContended, qint64 &stripeAcquired, qint64 &stripeContended);
+
     void UpdateMechanism(UpdateType Type);
     QString SoftPV_Name(QString pv, QWidget *w);
 
@@ -100,6 +161,7 @@ signals:
 
     void Signal_UpdateWidget(int, QWidget*, const QString&, const QString&, const QString&, const knobData&);
     void Signal_QLineEdit(const QString&, const QString&);
+    void Signal_PutCompleted(int, bool);
 
 private:
 
@@ -109,9 +171,66 @@ private:
        QWidget *w;
     } softlist;
 
+    typedef struct _lockStatistics {
+        qint64 acquired;
+        qint64 contended;
+    } lockStatistics;
+
     QMutex mutex;
-    knobData *KnobData;
+    lockStatistics globalLock;
+    QMutex stripeMutex[KNOBSTRIPES];
+    lockStatistics stripeLock[KNOBSTRIPES];
+    int stripeMonitors[KNOBSTRIPES];
+    bool fieldAccess;
+    bool displayStatistics;
+    QMutex *LockStripe(int index);
+    void LockGlobal();
+
+    // scoped global lock, counted like LockGlobal
+    class GlobalLocker {
+    public:
+        GlobalLocker(MutexKnobData *data) : knobs(data), locked(true) { knobs->LockGlobal(); }
+        ~GlobalLocker() { unlock(); }
+        void unlock() { if(locked) knobs->mutex.unlock(); locked = false; }
+    private:
+        MutexKnobData *knobs;
+        bool locked;
+    };
+    void UpdateMonitorStatistics(struct timeb &now);
+
+    knobData *KnobChunks[KNOBCHUNKS];
+    knobStatistics *StatisticsChunks[KNOBCHUNKS];
+    int nbChunks;
     int KnobDataArraySize;
+    inline knobData *Knob(int index) { return &KnobChunks[index / KNOBCHUNKSIZE][index % KNOBCHUNKSIZE]; }
+    inline knobStatistics *Statistics(int index) { return &StatisticsChunks[index / KNOBCHUNKSIZE][index % KNOBCHUNKSIZE]; }
+    void AllocateChunks(int count);
+    void SetWindowSlot(int index, void *oldW, void *newW);
+
+    // released slots ready for reuse and the slots used by every window
+    QVector<int> freeSlots;
+    QHash<void*, QSet<int> > windowSlots;
+
+    // slots of closed windows, reclaimed by the timer when no data callback can touch them anymore
+    typedef struct _retiredSlot {
+        int index;
+        ControlsInterface *plugin;
+        qint64 epoch;
+        double since;
+    } retiredSlot;
+    QVector<retiredSlot> retiredSlots;
+    qint64 timerEpoch;
+    void RetireSlot(int index, ControlsInterface *plugin);
+    void ReclaimRetiredSlots();
+
+    // channels of closed windows kept alive for some time, by plugin and pv, with the time they expire
+    double lingerSeconds;
+    QMultiHash<QString, int> lingerSlots;
+    QHash<int, double> lingerUntil;
+    qint64 lingerTaken;
+    static QString LingerKey(const knobData *kPtr);
+    void ExpireLingeringSlots();
+
     int timerId, prvRepetitionRate;
     QMap<QString, int> softPV_WidgetList;
     QMap<QString, softlist> softPV_List;
@@ -127,6 +246,23 @@ private:
     bool suppressUpdates;
     UpdateType myUpdateType;
 
+    // display budget, slots ready for display are sorted by priority and displayed until the budget is used
+    typedef struct _displayCandidate {
+        int index;
+        int priority;
+        double waiting;
+    } displayCandidate;
+    static bool displayCandidateLessThan(const displayCandidate &c1, const displayCandidate &c2);
+    void DisplayKnobData(int index, struct timeb &now);
+    void DisplayWithinBudget(QVector<displayCandidate> &candidates, struct timeb &now);
+    double displayBudgetMs;
+    bool displayBudgetDefault;
+    int windowBudget;
+    QMap<void*, int> windowUpdates;
+    time_t windowUpdatesTime;
+    int nbDeferred, nbDeferredPerSecond;
+    float budgetUsed;
+
     bool doDefaultUnitReplacements;
     QList<QPair<QString,QString> > createUnitReplacementPairList(QStringList replaceUnitsList);
     QList<QPair<QString,QString> > defaultReplaceUnitsPairList;
@@ -37,9 +37,15 @@ extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_SetMutexKnobData(MutexKnobData*
 extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_GetMutexKnobData(MutexKnobData* p, int indx, knobData *data);
 extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_SetMutexKnobDataConnected(MutexKnobData* p, int indx, int connected);
 extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_SetMutexKnobDataReceived(MutexKnobData* p, knobData *kData);
+extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_GetMutexKnobDataValue(MutexKnobData* p, int indx, knobValue *value);
+extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_SetMutexKnobDataValue(MutexKnobData* p, int indx, knobValue *value);
+extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_ReleaseMutexKnobDataValue(MutexKnobData* p, int indx);
 extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_UpdateTextLine(MutexKnobData* p, char *message, char *name);
+extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_PutCompleted(MutexKnobData* p, int token, int ok);
 extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_DataLock(MutexKnobData* p, knobData *kData);
 extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_DataUnlock(MutexKnobData* p, knobData *kData);
+extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_DataLockValue(MutexKnobData* p, knobValue *value);
+extern CAQTDM_LIBSHARED_EXPORT MutexKnobData* C_DataUnlockValue(MutexKnobData* p, knobValue *value);
 
 #ifdef __cplusplus
 }
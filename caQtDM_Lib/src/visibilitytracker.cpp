@@ -0,0 +1,215 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include <QAbstractScrollArea>
+#include <QScrollBar>
+#include <QStackedWidget>
+#include <QHash>
+#include <QSet>
+#include <QEvent>
+#include <QDebug>
+#if QT_VERSION > QT_VERSION_CHECK(5, 0, 0)
+#include <QWindow>
+#endif
+
+#include "visibilitytracker.h"
+#include "controlsinterface.h"
+#include "widgetbinding.h"
+
+// scrolling and resizing produce bursts of events, evaluate them together
+#define VISIBILITY_UPDATE_DELAY 100
+
+VisibilityTracker::HiddenMode VisibilityTracker::hiddenMode()
+{
+    QString mode = ((QString) qgetenv("CAQTDM_HIDDEN_IO")).toLower();
+    if(mode == "rate") return Rate;
+    if(mode == "suspend") return Suspend;
+    return Tabs;
+}
+
+VisibilityTracker::VisibilityTracker(QWidget *window, QWidget *displayWidget, MutexKnobData *mutexKnobData, QObject *parent) : QObject(parent)
+{
+    windowP = window;
+    displayWidgetP = displayWidget;
+    mutexKnobDataP = mutexKnobData;
+    mode = hiddenMode();
+    tracked = hidden = 0;
+    windowHandleWatched = false;
+
+    bool ok;
+    hiddenRate = ((QString) qgetenv("CAQTDM_HIDDEN_RATE")).toInt(&ok);
+    if(!ok || hiddenRate < 1) hiddenRate = 1;
+
+    updateTimer = new QTimer(this);
+    updateTimer->setSingleShot(true);
+    updateTimer->setInterval(VISIBILITY_UPDATE_DELAY);
+    connect(updateTimer, SIGNAL(timeout()), this, SLOT(updateVisibility()));
+
+    windowP->installEventFilter(this);
+    watchScrollAreas();
+    scheduleUpdate();
+}
+
+VisibilityTracker::~VisibilityTracker()
+{
+}
+
+void VisibilityTracker::scheduleUpdate()
+{
+    if(!updateTimer->isActive()) updateTimer->start();
+}
+
+/**
+ * scrollbar moves and viewport resizes of all scroll areas in the display
+ */
+void VisibilityTracker::watchScrollAreas()
+{
+    QList<QAbstractScrollArea *> areas = displayWidgetP->findChildren<QAbstractScrollArea *>();
+    foreach(QAbstractScrollArea *area, areas) {
+        connect(area->horizontalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(scheduleUpdate()));
+        connect(area->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(scheduleUpdate()));
+        area->viewport()->installEventFilter(this);
+    }
+}
+
+bool VisibilityTracker::eventFilter(QObject *obj, QEvent *event)
+{
+    switch(event->type()) {
+    case QEvent::Show:
+#if QT_VERSION > QT_VERSION_CHECK(5, 0, 0)
+        // the native window exists only once shown, its expose events tell us when it gets covered
+        if(obj == windowP && !windowHandleWatched && windowP->windowHandle() != (QWindow*) Q_NULLPTR) {
+            windowP->windowHandle()->installEventFilter(this);
+            windowHandleWatched = true;
+        }
+#endif
+        scheduleUpdate();
+        break;
+    case QEvent::Hide:
+    case QEvent::WindowStateChange:
+    case QEvent::Resize:
+#if QT_VERSION > QT_VERSION_CHECK(5, 0, 0)
+    case QEvent::Expose:
+#endif
+        scheduleUpdate();
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(obj, event);
+}
+
+/**
+ * same choice as for the tab pages: strip and waterfall plots need their history
+ */
+bool VisibilityTracker::isTreated(QWidget *w)
+{
+    QString className = w->metaObject()->className();
+    return className.contains("ca") && !className.contains("caStripPlot") && !className.contains("caWaterfallPlot");
+}
+
+/**
+ * only the containers are looked at, a widget made invisible by its visibility channel must keep its monitors;
+ * with pagesOnly only the pages of tab and stacked widgets count
+ */
+bool VisibilityTracker::isWidgetVisible(QWidget *w, bool pagesOnly)
+{
+    QWidget *child = w;
+    QWidget *parent = w->parentWidget();
+    while(parent != (QWidget*) Q_NULLPTR && child != displayWidgetP) {
+        // hidden page of a tab or stacked widget
+        if(QStackedWidget *stack = qobject_cast<QStackedWidget *>(parent)) {
+            if(stack->currentWidget() != child) return false;
+        }
+        // scrolled out of a viewport
+        QAbstractScrollArea *area = pagesOnly ? (QAbstractScrollArea*) Q_NULLPTR : qobject_cast<QAbstractScrollArea *>(parent->parentWidget());
+        if(area != (QAbstractScrollArea*) Q_NULLPTR && area->viewport() == parent) {
+            QRect rect(w->mapTo(parent, QPoint(0, 0)), w->size());
+            if(!rect.isEmpty() && !parent->rect().intersects(rect)) return false;
+        }
+        child = parent;
+        parent = parent->parentWidget();
+    }
+    return true;
+}
+
+/**
+ * go through the monitors of this display and suspend or resume them where the visibility changed
+ */
+void VisibilityTracker::updateVisibility()
+{
+    bool windowVisible = windowP->isVisible() && !windowP->isMinimized();
+#if QT_VERSION > QT_VERSION_CHECK(5, 0, 0)
+    if(windowVisible && windowP->windowHandle() != (QWindow*) Q_NULLPTR && !windowP->windowHandle()->isExposed()) windowVisible = false;
+#endif
+
+    QHash<QWidget*, bool> visibility;
+    QSet<ControlsInterface*> interfaces;
+    tracked = hidden = 0;
+
+    foreach(int i, mutexKnobDataP->GetMutexKnobDataWindowSlots(displayWidgetP)) {
+        knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(i);
+        if(kPtr->index == -1 || kPtr->soft || (QWidget*) kPtr->thisW != displayWidgetP) continue;
+        QWidget *w = (QWidget*) kPtr->dispW;
+        if(w == (QWidget*) Q_NULLPTR || !isTreated(w)) continue;
+
+        bool visible;
+        QHash<QWidget*, bool>::const_iterator it = visibility.constFind(w);
+        if(it == visibility.constEnd()) {
+            visible = windowVisible && isWidgetVisible(w);
+            visibility.insert(w, visible);
+            // a hidden page keeps its meaning for the soft channels, a minimized window does not stop the calculations
+            WidgetBinding *binding = WidgetBinding::attach(w);
+            binding->hidden = !isWidgetVisible(w, true);
+            binding->suspended = !visible;
+        } else {
+            visible = it.value();
+        }
+
+        tracked++;
+        int savedRepRate;
+        bool suspended = mutexKnobDataP->GetMutexKnobDataSuspended(i, &savedRepRate);
+        if(!visible) hidden++;
+        if(visible != suspended) continue;
+
+        ControlsInterface *plugininterface = (ControlsInterface *) kPtr->pluginInterface;
+        if(mode == Rate) {
+            if(!visible) {
+                mutexKnobDataP->SetMutexKnobDataSuspended(i, true, kPtr->edata.repRate);
+                mutexKnobDataP->SetMutexKnobDataRepRate(i, qMin(hiddenRate, kPtr->edata.repRate));
+            } else {
+                mutexKnobDataP->SetMutexKnobDataRepRate(i, savedRepRate);
+                mutexKnobDataP->SetMutexKnobDataSuspended(i, false);
+            }
+        } else if(plugininterface != (ControlsInterface *) Q_NULLPTR && kPtr->edata.info != (void*) Q_NULLPTR) {
+            if(!visible) plugininterface->pvClearEvent(kPtr->edata.info);
+            else plugininterface->pvAddEvent(kPtr->edata.info);
+            mutexKnobDataP->SetMutexKnobDataSuspended(i, !visible);
+            interfaces.insert(plugininterface);
+        }
+    }
+
+    foreach(ControlsInterface *plugininterface, interfaces) plugininterface->FlushIO();
+}
@@ -0,0 +1,79 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef VISIBILITYTRACKER_H
+#define VISIBILITYTRACKER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QWidget>
+#include "mutexKnobData.h"
+
+/**
+ * keeps track of which monitored widgets of a display can be seen; a widget can not be seen when its window
+ * is minimized, hidden or fully covered, when it sits on a hidden page of a QTabWidget or QStackedWidget
+ * or when it has been scrolled out of the viewport of a scroll area.
+ * with CAQTDM_HIDDEN_IO=suspend the monitors of such widgets are suspended, with CAQTDM_HIDDEN_IO=rate they are
+ * displayed at CAQTDM_HIDDEN_RATE Hz. the tracker is driven by events only; by default (tabs) it is not used and
+ * the tab pages are polled as before.
+ */
+class VisibilityTracker : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum HiddenMode {Tabs = 0, Suspend, Rate};
+
+    static HiddenMode hiddenMode();
+
+    VisibilityTracker(QWidget *window, QWidget *displayWidget, MutexKnobData *mutexKnobData, QObject *parent = 0);
+    ~VisibilityTracker();
+
+    int trackedCount() const { return tracked; }
+    int hiddenCount() const { return hidden; }
+
+public slots:
+    void scheduleUpdate();
+    void updateVisibility();
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event);
+
+private:
+    bool isTreated(QWidget *w);
+    bool isWidgetVisible(QWidget *w, bool pagesOnly = false);
+    void watchScrollAreas();
+
+    QWidget *windowP;
+    QWidget *displayWidgetP;
+    MutexKnobData *mutexKnobDataP;
+    QTimer *updateTimer;
+    HiddenMode mode;
+    int hiddenRate;
+    int tracked, hidden;
+    bool windowHandleWatched;
+};
+
+#endif
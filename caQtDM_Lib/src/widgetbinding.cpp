@@ -0,0 +1,106 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include <QHash>
+#include <QStyle>
+#include "widgetbinding.h"
+
+// the bindings are only used from the gui thread
+static QHash<const QWidget*, WidgetBinding*> bindings;
+
+/**
+ * the binding of a widget, created when the widget has none yet
+ */
+WidgetBinding *WidgetBinding::attach(QWidget *w)
+{
+    QHash<const QWidget*, WidgetBinding*>::const_iterator it = bindings.constFind(w);
+    if(it != bindings.constEnd()) return it.value();
+    return new WidgetBinding(w);
+}
+
+/**
+ * the binding of a widget, Q_NULLPTR when the widget has no channels nor state
+ */
+WidgetBinding *WidgetBinding::get(const QWidget *w)
+{
+    return bindings.value(w, (WidgetBinding *) Q_NULLPTR);
+}
+
+bool WidgetBinding::isConnected(const QWidget *w)
+{
+    WidgetBinding *binding = get(w);
+    return (binding != (WidgetBinding *) Q_NULLPTR) && binding->connected;
+}
+
+WidgetBinding::WidgetBinding(QWidget *w) : QObject(w)
+{
+    widget = w;
+    connected = false;
+    hidden = false;
+    suspended = false;
+    pendingPuts = 0;
+    QString className = w->metaObject()->className();
+    keepsHistory = className.contains("caStripPlot") || className.contains("caWaterfallPlot");
+    bindings.insert(w, this);
+}
+
+WidgetBinding::~WidgetBinding()
+{
+    bindings.remove(widget);
+}
+
+/**
+ * takes the list built with the monitors, its first element is the number of channels
+ */
+void WidgetBinding::setMonitors(const QList<QVariant> &monitorList)
+{
+    int count = monitorList.isEmpty() ? 0 : qMin(monitorList.at(0).toInt(), monitorList.size() - 1);
+    monitors.resize(qMax(count, 0));
+    for(int i=0; i < monitors.size(); i++) monitors[i] = monitorList.at(i+1).toInt();
+}
+
+void WidgetBinding::setMonitors(const QList<QVariant> &monitorList, const QList<QVariant> &indexList)
+{
+    setMonitors(monitorList);
+    inputs.fill(0, monitors.size());
+    for(int i=0; i < inputs.size() && i+1 < indexList.size(); i++) inputs[i] = indexList.at(i+1).toInt();
+}
+
+/**
+ * counts the puts of the widget waiting for their confirmation; while there are, the widget has the
+ * property putPending, which a style sheet can show, e.g. caSlider[putPending="true"]
+ */
+void WidgetBinding::setPutPending(bool started)
+{
+    bool wasPending = (pendingPuts > 0);
+    pendingPuts = qMax(pendingPuts + (started ? 1 : -1), 0);
+    if(wasPending == (pendingPuts > 0)) return;
+
+    QWidget *w = qobject_cast<QWidget *>(parent());
+    if(w == (QWidget *) Q_NULLPTR) return;
+    w->setProperty("putPending", pendingPuts > 0);
+    w->style()->unpolish(w);
+    w->style()->polish(w);
+}
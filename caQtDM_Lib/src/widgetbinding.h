@@ -0,0 +1,65 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef WIDGETBINDING_H
+#define WIDGETBINDING_H
+
+#include <QObject>
+#include <QWidget>
+#include <QVector>
+#include <QVariant>
+#include "caQtDM_Lib_global.h"
+
+/**
+ * the channels and the state of a caQtDM widget, attached to the widget when the display is built,
+ * so that the update routines do not have to look up and convert dynamic properties of the widget.
+ * the binding is a child of the widget and goes away with it
+ */
+class CAQTDM_LIBSHARED_EXPORT WidgetBinding : public QObject
+{
+public:
+    static WidgetBinding *attach(QWidget *w);
+    static WidgetBinding *get(const QWidget *w);
+    static bool isConnected(const QWidget *w);
+
+    void setMonitors(const QList<QVariant> &monitorList);
+    void setMonitors(const QList<QVariant> &monitorList, const QList<QVariant> &indexList);
+    void setPutPending(bool started);
+
+    QVector<int> monitors;     // data indexes of the channels
+    QVector<int> inputs;       // calc input (a, b, c, ...) of each channel
+    bool connected;            // the widget shows its channels connected
+    bool hidden;               // the widget sits on a hidden page of a tab or stacked widget
+    bool suspended;            // the monitors of the widget are suspended, as it can not be seen
+    bool keepsHistory;         // strip and waterfall plots accumulate their data also when hidden
+    int pendingPuts;           // puts of the widget not yet confirmed by the device
+
+private:
+    WidgetBinding(QWidget *w);
+    ~WidgetBinding();
+    const QWidget *widget;
+};
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include <QApplication>
+#include <QList>
+#include <string.h>
+#include "writepipeline.h"
+#include "widgetbinding.h"
+#include "mutexKnobData.h"
+#include "controlsinterface.h"
+#include "qtdefinitions.h"
+
+// upper bounds in ms of the latency histogram, the last bucket takes the longer ones
+static const int latencyBounds[PUT_BUCKETS] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+
+WritePipeline *WritePipeline::instance()
+{
+    static WritePipeline *pipeline = (WritePipeline *) Q_NULLPTR;
+    if(pipeline == (WritePipeline *) Q_NULLPTR) pipeline = new WritePipeline(qApp);
+    return pipeline;
+}
+
+WritePipeline::WritePipeline(QObject *parent) : QObject(parent)
+{
+    bool ok;
+    interval = ((QString) qgetenv("CAQTDM_PUT_INTERVAL")).toInt(&ok);
+    if(!ok || interval < 0) interval = PUT_INTERVAL;
+    confirm = ((QString) qgetenv("CAQTDM_PUT_CALLBACK")).toLower().replace("\"","") == "true";
+    lastToken = 0;
+    nbRequested = nbSent = 0;
+    nbConfirmed = nbFailed = nbTimedOut = 0;
+    for(int i=0; i <= PUT_BUCKETS; i++) latency[i] = 0;
+
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
+    connect(timer, SIGNAL(timeout()), this, SLOT(Callback_SendPending()));
+    expireTimer = new QTimer(this);
+    connect(expireTimer, SIGNAL(timeout()), this, SLOT(Callback_ExpirePuts()));
+}
+
+/**
+ * writes the value or, when the channel was written less than the interval ago or still waits for the
+ * confirmation of its last put and the put may be coalesced, keeps it as the value to write later.
+ * a put written at once replaces a value waiting. returns the token of a put to be confirmed, else 0
+ */
+int WritePipeline::put(MutexKnobData *mutexKnobData, ControlsInterface *plugininterface, knobData *kPtr, char *pv,
+                       double rdata, int32_t idata, char *sdata, char *object, int forceType, Mode mode)
+{
+    nbRequested++;
+
+    QString key = QString(kPtr->pluginName) + ":" + QString(pv);
+    QHash<QString, channelPut>::iterator it = channels.find(key);
+    if(it == channels.end()) {
+        channelPut entry;
+        entry.pending = false;
+        entry.token = 0;
+        it = channels.insert(key, entry);
+    }
+    channelPut &entry = it.value();
+    entry.mutexKnobData = mutexKnobData;
+    entry.plugininterface = plugininterface;
+    entry.index = kPtr->index;
+    entry.slotPv = QByteArray(kPtr->pv);
+    entry.pv = QByteArray(pv);
+    entry.sdata = QByteArray(sdata);
+    entry.object = QByteArray(object);
+    entry.rdata = rdata;
+    entry.idata = idata;
+    entry.forceType = forceType;
+    entry.widget = (QWidget *) kPtr->dispW;
+
+    if(mode == Coalesce) {
+        bool early = (interval > 0 && entry.lastSent.isValid() && entry.lastSent.elapsed() < interval);
+        if(early || entry.token != 0) {
+            entry.pending = true;
+            if(early && !timer->isActive()) timer->start(qMax((int) (interval - entry.lastSent.elapsed()), 0));
+            return 0;
+        }
+    }
+    entry.pending = false;
+    int token = send(key, entry);
+    // nothing waits on a put written at once, unless its confirmation holds back the next ones
+    if((mode == NoCoalesce || interval == 0) && token == 0) channels.erase(it);
+    return token;
+}
+
+/**
+ * writes the values waiting for their interval, the puts are flushed once per plugin for all channels
+ */
+void WritePipeline::Callback_SendPending()
+{
+    QList<ControlsInterface *> plugins;
+    qint64 wait = -1;
+
+    QHash<QString, channelPut>::iterator it = channels.begin();
+    while(it != channels.end()) {
+        channelPut &entry = it.value();
+        qint64 remaining = interval - entry.lastSent.elapsed();
+        if(!entry.pending) {
+            // nothing written since the interval, the next put goes out at once anyway
+            if(remaining <= 0 && entry.token == 0) it = channels.erase(it);
+            else ++it;
+            continue;
+        }
+        // the confirmation of the last put starts this again
+        if(entry.token != 0) {
+            ++it;
+            continue;
+        }
+        if(remaining > 0) {
+            if(wait < 0 || remaining < wait) wait = remaining;
+            ++it;
+            continue;
+        }
+        if(!plugins.contains(entry.plugininterface)) {
+            plugins.append(entry.plugininterface);
+            entry.plugininterface->pvDeferFlush(true);
+        }
+        entry.pending = false;
+        send(it.key(), entry);
+        ++it;
+    }
+
+    foreach(ControlsInterface *plugininterface, plugins) {
+        plugininterface->pvDeferFlush(false);
+        plugininterface->FlushIO();
+    }
+    if(wait >= 0) timer->start((int) wait);
+}
+
+int WritePipeline::send(const QString &key, channelPut &entry)
+{
+    char errmess[SMALL_STRING_LENGTH];
+    int token = 0;
+
+    // the slot could have been released since the put was requested, then the put goes by name
+    knobData *kPtr = entry.mutexKnobData->GetMutexKnobDataPtr(entry.index);
+    if(kPtr != (knobData *) Q_NULLPTR && (kPtr->index != entry.index || strcmp(kPtr->pv, entry.slotPv.constData()) != 0)) {
+        kPtr = (knobData *) Q_NULLPTR;
+    }
+
+    if(confirm && kPtr != (knobData *) Q_NULLPTR) {
+        // completions are delivered through the event loop, also when a plugin confirms at once
+        if(!completionSources.contains(entry.mutexKnobData)) {
+            completionSources.append(entry.mutexKnobData);
+            connect(entry.mutexKnobData, SIGNAL(Signal_PutCompleted(int,bool)), this, SLOT(Callback_PutCompleted(int,bool)), Qt::QueuedConnection);
+        }
+        if(++lastToken <= 0) lastToken = 1;
+        token = lastToken;
+        if(entry.plugininterface->pvSetValueAsync(kPtr, entry.rdata, entry.idata, entry.sdata.data(), entry.object.data(), errmess, entry.forceType, token)) {
+            outstandingPut put;
+            put.channel = key;
+            put.widget = entry.widget;
+            put.started.start();
+            outstanding.insert(token, put);
+            entry.token = token;
+            if(!put.widget.isNull()) WidgetBinding::attach(put.widget)->setPutPending(true);
+            if(!expireTimer->isActive()) expireTimer->start(1000);
+        } else {
+            token = 0;
+        }
+    }
+
+    if(token == 0) {
+        if(kPtr == (knobData *) Q_NULLPTR ||
+           !entry.plugininterface->pvSetValue(kPtr, entry.rdata, entry.idata, entry.sdata.data(), entry.object.data(), errmess, entry.forceType)) {
+            entry.plugininterface->pvSetValue(entry.pv.data(), entry.rdata, entry.idata, entry.sdata.data(), entry.object.data(), errmess, entry.forceType);
+        }
+    }
+    entry.lastSent.start();
+    nbSent++;
+    return token;
+}
+
+/**
+ * a put confirmed by the device, a value of the channel held back meanwhile can go now
+ */
+void WritePipeline::Callback_PutCompleted(int token, bool ok)
+{
+    finish(token, ok ? Confirmed : Failed);
+}
+
+/**
+ * puts without confirmation after PUT_TIMEOUT seconds, e.g. of a channel that disconnected
+ */
+void WritePipeline::Callback_ExpirePuts()
+{
+    QList<int> expired;
+    QHash<int, outstandingPut>::const_iterator it;
+    for(it = outstanding.constBegin(); it != outstanding.constEnd(); ++it) {
+        if(it.value().started.elapsed() > PUT_TIMEOUT * 1000) expired.append(it.key());
+    }
+    foreach(int token, expired) finish(token, TimedOut);
+    if(outstanding.isEmpty()) expireTimer->stop();
+}
+
+void WritePipeline::finish(int token, Result result)
+{
+    QHash<int, outstandingPut>::iterator it = outstanding.find(token);
+    if(it == outstanding.end()) return;   // expired before
+
+    if(result == TimedOut) {
+        nbTimedOut++;
+    } else {
+        qint64 ms = it.value().started.elapsed();
+        int bucket = 0;
+        while(bucket < PUT_BUCKETS && ms >= latencyBounds[bucket]) bucket++;
+        latency[bucket]++;
+        if(result == Confirmed) nbConfirmed++;
+        else nbFailed++;
+    }
+
+    if(!it.value().widget.isNull()) WidgetBinding::attach(it.value().widget)->setPutPending(false);
+
+    QHash<QString, channelPut>::iterator channel = channels.find(it.value().channel);
+    if(channel != channels.end() && channel.value().token == token) {
+        channel.value().token = 0;
+        if(channel.value().pending) {
+            if(!timer->isActive()) timer->start(0);
+        } else if(channel.value().lastSent.elapsed() >= interval) {
+            // nothing waiting and the interval is over, the next put goes out at once anyway
+            channels.erase(channel);
+        }
+    }
+    outstanding.erase(it);
+}
+
+QString WritePipeline::statisticsString()
+{
+    QString statistics;
+    if(nbRequested != nbSent) statistics = QString("puts %1 requested, %2 sent").arg(nbRequested).arg(nbSent);
+    qint64 total = nbConfirmed + nbFailed;
+    if(!confirm || total == 0) return statistics;
+
+    // median and 99th percentile of the confirmed puts, given by the upper bound of their bucket
+    QString bounds[2];
+    double fractions[2] = {0.5, 0.99};
+    for(int j=0; j < 2; j++) {
+        qint64 count = 0;
+        for(int i=0; i <= PUT_BUCKETS; i++) {
+            count += latency[i];
+            if(count >= fractions[j] * total) {
+                bounds[j] = (i < PUT_BUCKETS) ? QString("<%1").arg(latencyBounds[i]) : QString(">%1").arg(latencyBounds[PUT_BUCKETS-1]);
+                break;
+            }
+        }
+    }
+    if(!statistics.isEmpty()) statistics.append(", ");
+    statistics.append(QString("put latency p50 %1 ms p99 %2 ms, %3 pending").arg(bounds[0]).arg(bounds[1]).arg(outstanding.size()));
+    if(nbFailed + nbTimedOut > 0) statistics.append(QString(", %1 failed").arg(nbFailed + nbTimedOut));
+    return statistics;
+}
+
+/**
+ * the whole latency histogram of the confirmed puts
+ */
+QString WritePipeline::latencyString()
+{
+    QString histogram = QString("put latency (ms), %1 confirmed, %2 failed, %3 timed out:").arg(nbConfirmed).arg(nbFailed).arg(nbTimedOut);
+    for(int i=0; i < PUT_BUCKETS; i++) histogram.append(QString("\n  <%1\t%2").arg(latencyBounds[i]).arg(latency[i]));
+    histogram.append(QString("\n  >%1\t%2").arg(latencyBounds[PUT_BUCKETS-1]).arg(latency[PUT_BUCKETS]));
+    return histogram;
+}
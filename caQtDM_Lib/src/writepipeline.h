@@ -0,0 +1,128 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef WRITEPIPELINE_H
+#define WRITEPIPELINE_H
+
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QByteArray>
+#include <QPointer>
+#include <QWidget>
+#include <stdint.h>
+#include "caQtDM_Lib_global.h"
+#include "knobData.h"
+
+class ControlsInterface;
+class MutexKnobData;
+
+#define PUT_INTERVAL 0      // ms between two puts to the same channel, 0: no coalescing
+#define PUT_TIMEOUT 60      // seconds a confirmed put may take
+#define PUT_BUCKETS 12      // latency histogram buckets
+
+/**
+ * all puts of the displays go through here. with CAQTDM_PUT_INTERVAL set, puts of continuous input (slider drags,
+ * spinbox and wheel steps) are coalesced per channel: a put following the previous one to the same channel within CAQTDM_PUT_INTERVAL ms
+ * is held back and replaced by a later one, the last value is written when the interval has passed.
+ * the held back puts of all channels are written together and flushed once per plugin.
+ * puts that must reach the device one by one (message buttons, toggles, text entries) are written at once.
+ *
+ * with CAQTDM_PUT_CALLBACK=true the puts are confirmed by the device when the plugin supports it: every put
+ * gets a token, which comes back when the device has processed it. the widget is marked pending meanwhile,
+ * a coalesced put waits for the previous one of its channel and the round trip goes into a latency histogram.
+ */
+class CAQTDM_LIBSHARED_EXPORT WritePipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Mode {Coalesce, NoCoalesce};
+
+    static WritePipeline *instance();
+
+    int put(MutexKnobData *mutexKnobData, ControlsInterface *plugininterface, knobData *kPtr, char *pv,
+            double rdata, int32_t idata, char *sdata, char *object, int forceType, Mode mode);
+
+    int getInterval() const { return interval; }
+    bool isConfirmed() const { return confirm; }
+    qint64 getRequested() const { return nbRequested; }
+    qint64 getSent() const { return nbSent; }
+    int getOutstanding() const { return outstanding.size(); }
+    QString statisticsString();
+    QString latencyString();
+
+private slots:
+    void Callback_SendPending();
+    void Callback_PutCompleted(int token, bool ok);
+    void Callback_ExpirePuts();
+
+private:
+    WritePipeline(QObject *parent);
+
+    typedef struct _channelPut {
+        MutexKnobData *mutexKnobData;
+        ControlsInterface *plugininterface;
+        int index;
+        QByteArray slotPv;                 // pv of the slot when the put was requested
+        QByteArray pv;
+        QByteArray sdata;
+        QByteArray object;
+        double rdata;
+        int32_t idata;
+        int forceType;
+        QPointer<QWidget> widget;
+        bool pending;
+        int token;                         // confirmation the channel waits for
+        QElapsedTimer lastSent;
+    } channelPut;
+
+    typedef struct _outstandingPut {
+        QString channel;
+        QPointer<QWidget> widget;
+        QElapsedTimer started;
+    } outstandingPut;
+
+    enum Result {Confirmed, Failed, TimedOut};
+
+    int send(const QString &key, channelPut &entry);
+    void finish(int token, Result result);
+
+    int interval;
+    bool confirm;
+    QTimer *timer;
+    QTimer *expireTimer;
+    QHash<QString, channelPut> channels;   // by plugin and pv
+    QHash<int, outstandingPut> outstanding;
+    QList<MutexKnobData *> completionSources;
+    int lastToken;
+
+    qint64 nbRequested, nbSent;
+    qint64 nbConfirmed, nbFailed, nbTimedOut;
+    qint64 latency[PUT_BUCKETS + 1];
+};
+
+#endif
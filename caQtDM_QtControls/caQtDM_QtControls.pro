@@ -102,6 +102,7 @@ SOURCES	+= \
     src/cabitnames.cpp \
     src/eflag.cpp \
     src/catable.cpp \
+    src/catablemodel.cpp \
     src/cabyte.cpp \
     src/rectangle.cpp \
     src/cagauge.cpp \
@@ -119,11 +120,14 @@ SOURCES	+= \
     src/cascriptbutton.cpp \
     src/cadoubletabwidget.cpp \
     src/stripplotthread.cpp \
+    src/stripplotrenderer.cpp \
+    src/stripplothistory.cpp \
     src/cawaterfallplot.cpp \
     src/snumeric.cpp \
     src/caspinbox.cpp \
     src/qwtplotcurvenan.cpp \
     src/cawavetable.cpp \
+    src/cawavetablemodel.cpp \
     src/specialFunctions.cpp \
     src/caclock.cpp \
     src/cameter.cpp \
@@ -216,6 +220,7 @@ HEADERS	+= \
     src/cabitnames.h \
     src/eflag.h \
     src/catable.h \
+    src/catablemodel.h \
     src/cabyte.h \
     src/rectangle.h \
     src/cagauge.h \
@@ -235,11 +240,14 @@ HEADERS	+= \
     src/cascriptbutton.h \
     src/cadoubletabwidget.h \
     src/stripplotthread.h \
+    src/stripplotrenderer.h \
+    src/stripplothistory.h \
     src/cawaterfallplot.h \
     src/snumeric.h \
     src/caspinbox.h \
     src/qwtplotcurvenan.h \
     src/cawavetable.h \
+    src/cawavetablemodel.h \
     src/capolylinedialog.h \
     src/specialFunctions.h \
     src/caclock.h \
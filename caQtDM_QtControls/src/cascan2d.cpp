@@ -624,7 +624,7 @@ void caScan2D::setYNEWDATA(int ynewdata)
         // Get all data from file
         if (m_savedata_pathDefined && m_savedata_subdirDefined && m_savedata_filenameDefined && m_ycptDefined) {
             QString dataFile = m_savedata_path + QString("/") + m_savedata_subdir + QString("/") + m_savedata_filename;
-            status = mdaReader_gimmeYerData(dataFile, thisPV_Data, xdata, m_width, m_height, m_ycpt);
+            status = m_mdaReader.gimmeYerData(dataFile, thisPV_Data, xdata, m_width, m_height, m_ycpt);
         }
     }
     // Don't call showImage() on m_init, because xdata may not have been initialized from the data file
@@ -655,7 +655,7 @@ void caScan2D::setSAVEDATA_FILENAME(const QString &savedata_filename)
 void caScan2D::attemptInitialPlot() {
     if (m_init && m_widthDefined && m_heightDefined && m_savedata_pathDefined && m_savedata_subdirDefined && m_savedata_filenameDefined && m_ycptDefined) {
         QString dataFile = m_savedata_path + QString("/") + m_savedata_subdir + QString("/") + m_savedata_filename;
-        mdaReader_gimmeYerData(dataFile, thisPV_Data, xdata, m_width, m_height, m_ycpt);
+        m_mdaReader.gimmeYerData(dataFile, thisPV_Data, xdata, m_width, m_height, m_ycpt);
         showImage(m_width, m_height);
     }
 }
@@ -305,6 +305,7 @@ private:
     bool m_savedata_pathDefined, m_savedata_subdirDefined, m_savedata_filenameDefined;
     int m_xcpt, m_ycpt, m_xnewdata, m_ynewdata;
     QString m_savedata_path, m_savedata_subdir, m_savedata_filename;
+    mdaReader m_mdaReader;
 
     QHBoxLayout  *valuesLayout;
     QGridLayout  *mainLayout;
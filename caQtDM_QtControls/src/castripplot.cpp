@@ -62,6 +62,13 @@
 
 caStripPlot::~caStripPlot() {
 
+    if(renderer != (stripplotrenderer *) Q_NULLPTR) {
+        renderer->stop();
+        renderer->wait();
+        delete renderer;
+    }
+    if(guiPainter != (stripplotpainter *) Q_NULLPTR) delete guiPainter;
+
     emit timerThreadStop();
     timerThread->wait(200);
     timerThread->deleteLater();
@@ -70,6 +77,17 @@ caStripPlot::~caStripPlot() {
 caStripPlot::caStripPlot(QWidget *parent): QwtPlot(parent)
 {
     // initialisations
+    renderer = (stripplotrenderer *) Q_NULLPTR;
+    guiPainter = (stripplotpainter *) Q_NULLPTR;
+    incremental = false;
+    singlePrecision = false;
+    backfillPending = false;
+    pyramid.reset(MAXCURVES);
+    qRegisterMetaType<QVector<double> >("QVector<double>");
+    renderCurveType = TimeCurv;
+    renderInterval = 0.0;
+    guiFrames = 0;
+    guiNs = 0;
     initCurves = true;
     timerID = false;
     thisXaxisType = TimeScale;
@@ -198,6 +216,93 @@ caStripPlot::caStripPlot(QWidget *parent): QwtPlot(parent)
     timerThread->setPriority(QThread::HighPriority);
     connect(this, SIGNAL(timerThreadStop()), timerThread, SLOT(runStop()));
     connect(timerThread, SIGNAL(update()), this, SLOT(TimeOutThread()),  Qt::DirectConnection);
+
+    // optional render thread, the canvas is then drawn offscreen and the gui thread only blits the frame
+    QString renderThread = ((QString) qgetenv("CAQTDM_STRIPPLOT_RENDER_THREAD")).toLower();
+    if(renderThread == "true" || renderThread == "1") {
+        renderer = new stripplotrenderer();
+        connect(renderer, SIGNAL(frameReady()), this, SLOT(frameReady()), Qt::QueuedConnection);
+        renderer->start();
+    }
+
+    // optional incremental drawing for the time scales, the curves are kept in an image that is scrolled
+    // and only the newest columns are drawn
+    QString incrementalDraw = ((QString) qgetenv("CAQTDM_STRIPPLOT_INCREMENTAL")).toLower();
+    if(incrementalDraw == "true" || incrementalDraw == "1") {
+        incremental = true;
+        if(renderer == (stripplotrenderer *) Q_NULLPTR) guiPainter = new stripplotpainter();
+    }
+
+    // optional single precision history, halves the memory of the raw values
+    QString float32 = ((QString) qgetenv("CAQTDM_STRIPPLOT_FLOAT32")).toLower();
+    if(float32 == "true" || float32 == "1") singlePrecision = true;
+}
+
+/**
+ * empty history and curves
+ */
+void caStripPlot::initHistory()
+{
+    history.reset(MAXCURVES, MAXIMUMSIZE, singlePrecision);
+    for(int i=0; i < MAXCURVES; i++) {
+        derived[i] = stripplotderived();
+        rangeData[i].clear();
+        rangeData[i].append(QwtIntervalSample(0, QwtInterval(NAN, NAN)));
+        fillData[i].clear();
+        fillData[i].append(QPointF(NAN,NAN));
+    }
+
+    // set the data to the curves
+    for(int i=0; i < NumberOfCurves; i++) {
+        if(thisStyle[i] == FillUnder) {
+            fillcurve[i]->setSamplesList(fillData[i]);
+            fillcurve[i]->setSamples(fillData[i]);
+        }
+        errorcurve[i]->setSamplesList(rangeData[i]);
+        errorcurve[i]->setSamples(rangeData[i]);
+    }
+}
+
+/**
+ * conversion of the raw values to the displayed ones, with fixed scales all curves are remapped to the first one
+ */
+stripplotmapping caStripPlot::curveMapping(int curvIndex) const
+{
+    stripplotmapping mapping;
+    mapping.log = (thisYaxisType == log10);
+    if(thisYaxisScaling != fixedScale) return mapping;
+
+    mapping.fromMin = thisYaxisLimitsMin[curvIndex];
+    mapping.fromMax = thisYaxisLimitsMax[curvIndex];
+    mapping.toMin = thisYaxisLimitsMin[0];
+    mapping.toMax = thisYaxisLimitsMax[0];
+    if(mapping.log) {
+        mapping.fromMin = qMax(mapping.fromMin, 1e-20);
+        mapping.fromMax = qMax(mapping.fromMax, 1e-19);
+        mapping.toMin = qMax(mapping.toMin, 1e-20);
+        mapping.toMax = qMax(mapping.toMax, 1e-19);
+    }
+    mapping.identity = (mapping.fromMin == mapping.toMin && mapping.fromMax == mapping.toMax);
+    return mapping;
+}
+
+/**
+ * derive the samples of a curve from the history, to be called with the mutex held; the buffers are
+ * swapped first, the ones given to the curves and the render job last time are no longer referenced
+ * when they are written again, so that they are not detached (copied). The samples of last time are
+ * in the spare buffer now, their mapped values are taken over and only the new samples are mapped
+ */
+void caStripPlot::updateSamples(int curvIndex, const stripplotmapping &mapping)
+{
+    rangeData[curvIndex].swap(rangeSpare[curvIndex]);
+    if(thisStyle[curvIndex] == FillUnder) {
+        fillData[curvIndex].swap(fillSpare[curvIndex]);
+        history.samples(curvIndex, mapping, thisXaxisType == ValueScale, rangeData[curvIndex], &fillData[curvIndex],
+                        &derived[curvIndex], &rangeSpare[curvIndex]);
+    } else {
+        history.samples(curvIndex, mapping, thisXaxisType == ValueScale, rangeData[curvIndex], (QVector<QPointF> *) Q_NULLPTR,
+                        &derived[curvIndex], &rangeSpare[curvIndex]);
+    }
 }
 
 
@@ -220,41 +325,9 @@ void caStripPlot::resumePlot(){
 void caStripPlot::restartPlot()
 {
     plotIsPaused = false;
-    for(int i=0; i < MAXCURVES; i++) {
-        // reset interval data for error and fill curves
-        rangeData[i].clear();
-        rangeData[i].reserve(MAXIMUMSIZE+5);
-        fillData[i].clear();
-        fillData[i].reserve(MAXIMUMSIZE+5);
-
-        //reset interval data for raw data curves
-        rangeDataRaw[i].clear();
-        rangeDataRaw[i].reserve(MAXIMUMSIZE+5);
-        fillDataRaw[i].clear();
-        fillDataRaw[i].reserve(MAXIMUMSIZE+5);
-
-        if(i==0)  {
-            base.clear();
-            base.reserve(MAXIMUMSIZE+5);
-        }
-        for ( int j = 0; j <  MAXIMUMSIZE; j++ ) {
-            rangeData[i].append(QwtIntervalSample(0, QwtInterval(NAN, NAN)));
-            fillData[i].append(QPointF(NAN,NAN));
-            if(i==0) base.append(QwtIntervalSample(0, QwtInterval(NAN, NAN)));
-
-            rangeDataRaw[i].append(QwtIntervalSample(0, QwtInterval(NAN, NAN)));
-            fillDataRaw[i].append(QPointF(NAN,NAN));
-        }
-    }
-    // set the data to the curves
-    for(int i=0; i < NumberOfCurves; i++) {
-        if(thisStyle[i] == FillUnder) {
-            fillcurve[i]->setSamplesList(fillData[i]);
-            fillcurve[i]->setSamples(fillData[i]);
-        }
-        errorcurve[i]->setSamplesList(rangeData[i]);
-        errorcurve[i]->setSamples(rangeData[i]);
-    }
+    mutex.lock();
+    initHistory();
+    mutex.unlock();
     replot();
 }
 
@@ -393,6 +466,63 @@ void caStripPlot::defineXaxis(units unit, double period)
     replot();
 }
 
+/**
+ * a running chart is restarted with the new period, the history is then filled again from the pyramid
+ */
+void caStripPlot::setPeriod(double const &newP)
+{
+    bool changed = (newP != thisPeriod);
+    thisPeriod = newP;
+    defineXaxis(thisUnits, thisPeriod);
+    if(!changed || !timerID) return;
+
+    mutex.lock();
+    initCurves = true;
+    backfillPending = true;
+    mutex.unlock();
+    RescaleCurves(canvas()->size().width(), thisUnits, thisPeriod);
+    RescaleAxis();
+}
+
+/**
+ * time as kept in the history for an absolute time in seconds, relative to the start of the plot
+ */
+double caStripPlot::historyTime(double seconds) const
+{
+    double start = (double) timeStart.time + (double) timeStart.millitm / (double)1000;
+    double value = INTERVAL + seconds - start;
+    if(thisXaxisType == ValueScale) {
+        if(thisUnits == Millisecond) value = value * 1000.0;
+        else if(thisUnits == Minute) value = value / 60.0;
+    }
+    return value;
+}
+
+/**
+ * fill the empty history with one sample per pixel from the pyramid, what the pyramid does not cover
+ * is requested from the archive when an archive plugin is defined for this chart; to be called with the mutex held
+ */
+void caStripPlot::backfillHistory(double now)
+{
+    int slots = qMax(HISTORY, 1);
+    double step = INTERVAL / (double) slots;
+    double localStart = pyramid.oldestTime();
+    double missing = 0.0;
+
+    for(int k = 0; k < slots; k++) {
+        double from = now - INTERVAL + (double) k * step;
+        history.push(historyTime(from));
+        for(int c = 0; c < NumberOfCurves; c++) {
+            double minY = 0.0, maxY = 0.0;
+            if(pyramid.range(c, from, from + step, minY, maxY)) history.setNewest(c, minY, maxY);
+        }
+        if(from < localStart && missing == 0.0) missing = now - from;
+    }
+    dataCount = history.size();
+
+    if(missing > 0.0) emit backfillRequest(missing);
+}
+
 void caStripPlot::setXaxis(double interval, double period)
 {
     // set axis and in case of a time scale define the time axis
@@ -453,82 +583,26 @@ void caStripPlot::setYaxisType(yAxisType s)
  * */
 void caStripPlot::remapCurve(double newMin, double newMax,  quint8 curvIndex, bool isNewLog = false)
 {
-    //qDebug() << "remapping Curve: " << curvIndex << "min/max:" << newMin << newMax << "isNewLog:"<< isNewLog;
-    // Start timer to measure performance:
-    //QElapsedTimer timer;
-    //timer.start();
-
-    // Variables
-    // Because the values are calculated from the raw data, old min and old max are always given.
-    double oldMin = thisYaxisLimitsMin[curvIndex];
-    double oldMax = thisYaxisLimitsMax[curvIndex];
+    // the raw data are kept in the history, only the mapping changes
+    stripplotmapping mapping;
+    mapping.log = isNewLog;
+    mapping.fromMin = thisYaxisLimitsMin[curvIndex];
+    mapping.fromMax = thisYaxisLimitsMax[curvIndex];
+    mapping.toMin = newMin;
+    mapping.toMax = newMax;
 
     // Make sure no bad values are used for logarithmic conversions.
     if (isNewLog) {
-        newMin = qMax(newMin, 1e-20);
-        newMax = qMax(newMax, 1e-19);
-        oldMin = qMax(oldMin, 1e-20);
-        oldMax = qMax(oldMax, 1e-19);
+        mapping.toMin = qMax(newMin, 1e-20);
+        mapping.toMax = qMax(newMax, 1e-19);
+        mapping.fromMin = qMax(mapping.fromMin, 1e-20);
+        mapping.fromMax = qMax(mapping.fromMax, 1e-19);
     }
+    mapping.identity = (mapping.fromMin == mapping.toMin && mapping.fromMax == mapping.toMax);
 
-    double percentMin;
-    double percentMax;
-    double percentFillY;
-
-    double oldMaxMinDiff = oldMax - oldMin;
-    double oldLogMaxMinDiv = std::log10(oldMax/oldMin);
-    double newLogMaxMinDiv = std::log10(newMax/newMin);
-    double newMaxMinDiff = newMax - newMin;
-    double log10NewMin = std::log10(newMin);
-    double log10OldMin = std::log10(oldMin);
-
-    // efficiently do default conversion to original values
-    if (oldMin == newMin && oldMax == newMax) {
-        if (isNewLog){ // treat incorrect values
-           mutex.lock();
-           for (quint32 j = 0; rangeDataRaw[curvIndex][j].value > (rangeDataRaw[curvIndex][0].value - thisPeriod) && rangeDataRaw[curvIndex][j].interval.isValid() && rangeDataRaw[curvIndex][j].value != 0; j++){
-                rangeData[curvIndex][j].interval.setMinValue(qMax(rangeDataRaw[curvIndex][j].interval.minValue(), 1e-20));
-                rangeData[curvIndex][j].interval.setMaxValue(qMax(rangeDataRaw[curvIndex][j].interval.maxValue(), 1e-20));
-                fillData[curvIndex][j].setY(qMax(fillDataRaw[curvIndex][j].y(), 1e-20));
-           }
-           mutex.unlock();
-        } else {
-           mutex.lock();
-           rangeData[curvIndex] = rangeDataRaw[curvIndex];
-           fillData[curvIndex] = fillDataRaw[curvIndex];
-           mutex.unlock();
-        }
-    } else { // remap the curves for any arbitrary conversion
-        // Different equations are used because the logarithmic conversion is most performant the way it is (least amount of log10() calls)
-        // but the linear conversion needs to be different due to division by zero errors which can't happen on a log scale (are prevented by setting minimum values to 1e-20).
-        if (isNewLog) {
-           mutex.lock();
-           for (quint32 j = 0; rangeDataRaw[curvIndex][j].value > (rangeDataRaw[curvIndex][0].value - thisPeriod) && rangeDataRaw[curvIndex][j].interval.isValid() && rangeDataRaw[curvIndex][j].value != 0; j++){
-                double minPositive = qMax(rangeDataRaw[curvIndex][j].interval.minValue(), 1e-20);
-                double maxPositive = qMax(rangeDataRaw[curvIndex][j].interval.maxValue(), 1e-20);
-                double fillYPositive = qMax(fillDataRaw[curvIndex][j].y(), 1e-20);
-
-                percentMin = (std::log10(minPositive) - log10OldMin)/oldLogMaxMinDiv;
-                percentMax = (std::log10(maxPositive) - log10OldMin)/oldLogMaxMinDiv;
-                percentFillY = (std::log10(fillYPositive) - log10OldMin)/oldLogMaxMinDiv;
-                rangeData[curvIndex][j].interval.setMinValue(pow(10, ((percentMin * newLogMaxMinDiv) + log10NewMin)));
-                rangeData[curvIndex][j].interval.setMaxValue(pow(10, ((percentMax * newLogMaxMinDiv) + log10NewMin)));
-                fillData[curvIndex][j].setY(pow(10, ((percentFillY * newLogMaxMinDiv) + log10NewMin)));
-           }
-           mutex.unlock();
-        } else {
-           mutex.lock();
-           for (quint32 j = 0; rangeDataRaw[curvIndex][j].value > (rangeDataRaw[curvIndex][0].value - thisPeriod) && rangeDataRaw[curvIndex][j].interval.isValid() && rangeDataRaw[curvIndex][j].value != 0; j++){
-                percentMin = (rangeDataRaw[curvIndex][j].interval.minValue() - oldMin)/(oldMaxMinDiff);
-                percentMax = (rangeDataRaw[curvIndex][j].interval.maxValue() - oldMin)/(oldMaxMinDiff);
-                percentFillY = (fillDataRaw[curvIndex][j].y() - oldMin)/(oldMaxMinDiff);
-                rangeData[curvIndex][j].interval.setMinValue((percentMin * newMaxMinDiff) + newMin);
-                rangeData[curvIndex][j].interval.setMaxValue((percentMax * newMaxMinDiff) + newMin);
-                fillData[curvIndex][j].setY((percentFillY * newMaxMinDiff) + newMin);
-           }
-           mutex.unlock();
-        }
-    }
+    mutex.lock();
+    updateSamples(curvIndex, mapping);
+    mutex.unlock();
 
     // Set the data to the curves
     if(thisStyle[curvIndex] == FillUnder) {
@@ -539,9 +613,6 @@ void caStripPlot::remapCurve(double newMin, double newMax,  quint8 curvIndex, bo
     errorcurve[curvIndex]->setSamples(rangeData[curvIndex]);
 
     replot();
-
-    // Print time it took to do conversions
-    //qDebug() << "Conversion took ms: " << timer.nsecsElapsed()/1000000.0;
 }
 
 void caStripPlot::RescaleCurves(int width, units unit, double period)
@@ -586,41 +657,8 @@ void caStripPlot::RescaleCurves(int width, units unit, double period)
 
     mutex.lock();
 
-    // initialize the arrays, with nan data
-    for(int i=0; i < MAXCURVES; i++) {
-        // define interval data for error and fill curves
-        rangeData[i].clear();
-        rangeData[i].reserve(MAXIMUMSIZE+5);
-        fillData[i].clear();
-        fillData[i].reserve(MAXIMUMSIZE+5);
-
-        //reset interval data for raw data curves
-        rangeDataRaw[i].clear();
-        rangeDataRaw[i].reserve(MAXIMUMSIZE+5);
-        fillDataRaw[i].clear();
-        fillDataRaw[i].reserve(MAXIMUMSIZE+5);
-        if(i==0)  {
-            base.clear();
-            base.reserve(MAXIMUMSIZE+5);
-        }
-        for ( int j = 0; j <  MAXIMUMSIZE; j++ ) {
-            rangeData[i].append(QwtIntervalSample(0, QwtInterval(NAN, NAN)));
-            fillData[i].append(QPointF(NAN,NAN));
-            rangeDataRaw[i].append(QwtIntervalSample(0, QwtInterval(NAN, NAN)));
-            fillDataRaw[i].append(QPointF(NAN,NAN));
-            if(i==0) base.append(QwtIntervalSample(0, QwtInterval(NAN, NAN)));
-        }
-    }
-
-    // set the data to the curves
-    for(int i=0; i < NumberOfCurves; i++) {
-        if(thisStyle[i] == FillUnder) {
-            fillcurve[i]->setSamplesList(fillData[i]);
-            fillcurve[i]->setSamples(fillData[i]);
-        }
-        errorcurve[i]->setSamplesList(rangeData[i]);
-        errorcurve[i]->setSamples(rangeData[i]);
-    }
+    // empty history
+    initHistory();
 
     mutex.unlock();
 
@@ -789,9 +827,9 @@ void caStripPlot::defineCurves(QStringList titles, units unit, double period, in
 
             showCurve(i, false);
 
-            realMax[i] = maxVal[i] = -1000000;
-            realMin[i] = minVal[i] =  1000000;
-            actVal[i] = realVal[i] = NAN;
+            realMax[i] = -1000000;
+            realMin[i] =  1000000;
+            realVal[i] = NAN;
         }
     }
 
@@ -842,11 +880,8 @@ void caStripPlot::addText(double x, double y, char* text, QColor c, int fontsize
 // data collection done by timerthread
 void caStripPlot::TimeOutThread()
 {
-    int c, i;
+    int c;
     double elapsedTime = 0.0;
-    QwtIntervalSample tmp;
-    QPointF tmpP;
-    double value = 0.0;
     double interval=0.0;
 
     if(!timerID) return;
@@ -861,9 +896,16 @@ void caStripPlot::TimeOutThread()
         static_cast<DynamicPlotPicker*>(plotPicker)->setStartTime(timeStart.time, thisPeriod);
         RestartPlot1 = false;
         RestartPlot2 = true;
+        if(backfillPending) {
+            backfillPending = false;
+            backfillHistory((double) timeStart.time + (double) timeStart.millitm / (double)1000);
+        }
     }
     ftime(&timeNow);
 
+    // everything goes also into the pyramid
+    pyramid.add((double) timeNow.time + (double) timeNow.millitm / (double)1000, realMin, realMax);
+
     elapsedTime = ((double) timeNow.time + (double) timeNow.millitm / (double)1000) -
                   ((double) timeStart.time + (double) timeStart.millitm / (double)1000);
 
@@ -887,6 +929,8 @@ void caStripPlot::TimeOutThread()
     }
 
     // tell interval to base class nan
+    renderCurveType = (thisXaxisType == ValueScale) ? ValueCurv : TimeCurv;
+    renderInterval = interval;
     for (c = 0; c < NumberOfCurves; c++ ) {
         if(thisXaxisType == ValueScale) {
             fillcurve[c]->setInterval(ValueCurv, interval);
@@ -897,93 +941,21 @@ void caStripPlot::TimeOutThread()
         }
     }
 
-    // shift data back
-    if(dataCount > 1) {
-        // shift data and our timebase for the fixed scale
-        if(thisXaxisType == ValueScale) {
-            for (c = 0; c < NumberOfCurves; c++ ) {
-                // shift left and cur last
-                rangeData[c].prepend(tmp);
-                rangeData[c].erase(rangeData[c].end() - 1);
-                rangeDataRaw[c].prepend(tmp);
-                rangeDataRaw[c].erase(rangeDataRaw[c].end() - 1);
-                if(thisStyle[c] == FillUnder) {
-                    fillData[c].prepend(tmpP);
-                    fillData[c].erase(fillData[c].end() - 1);
-                    fillDataRaw[c].prepend(tmpP);
-                    fillDataRaw[c].erase(fillDataRaw[c].end() - 1);
-                }
-            }
-
-            base.prepend(tmp);
-            base.erase(base.end() - 1);
-
-            for (i = dataCount; i > 0; i-- ) {
-                value = base[i].value - timeData;
-                for (c = 0; c < NumberOfCurves; c++ ) {
-                    rangeData[c][i].value = value;
-                    fillData[c][i].setX(value);
-                    rangeDataRaw[c][i].value = value;
-                    fillDataRaw[c][i].setX(value);
-                }
-            }
-
-            // shift data
-        } else {
-            for (c = 0; c < NumberOfCurves; c++ ) {
-                rangeData[c].prepend(tmp);
-                rangeDataRaw[c].prepend(tmp);
-                if(thisStyle[c] == FillUnder) {
-                    fillData[c].prepend(tmpP);
-                    fillDataRaw[c].prepend(tmpP);
-                }
-                rangeData[c].erase(rangeData[c].end() - 1);
-                rangeDataRaw[c].erase(rangeDataRaw[c].end() - 1);
-                if(thisStyle[c] == FillUnder) {
-                    fillData[c].erase(fillData[c].end() - 1);
-                    fillDataRaw[c].erase(fillDataRaw[c].end() - 1);
-                }
-            }
-        }
-
-    }
+    // new sample in front, the first two periods go into the same sample
+    history.setCapacity(qMin(dataCountLimit + 1, MAXIMUMSIZE));
+    if(dataCount > 1 || history.size() == 0) history.push(timeData);
+    else history.setNewestTime(timeData);
 
     // update last point
     for (c = 0; c < NumberOfCurves; c++ ) {
-        double valueMin = minVal[c];
-        double valueMax = maxVal[c];
-        double valueMinRaw = realMin[c];
-        double valueMaxRaw = realMax[c];
-
-        if(thisYaxisType == log10) {
-            if(valueMin < 1e-20) valueMin=1e-20;
-            if(valueMax < 1e-20) valueMax=1e-20;
-        }
-
-        QwtInterval newInterval;
-        newInterval.setMaxValue( valueMax);
-        newInterval.setMinValue( valueMin);
-
-        QwtInterval newIntervalRaw;
-        newIntervalRaw.setMaxValue(valueMaxRaw);
-        newIntervalRaw.setMinValue(valueMinRaw);
-
-        rangeData[c][0] = QwtIntervalSample( timeData, newInterval);
-        rangeDataRaw[c][0] = QwtIntervalSample( timeData, newIntervalRaw);
-        if(thisXaxisType == ValueScale) {
-            base[0] = QwtIntervalSample(timeData, newInterval);
-        }
-        if(thisStyle[c] == FillUnder) {
-            fillData[c][0] = QPointF(timeData, (valueMax+valueMin)/2);
-            fillDataRaw[c][0] = QPointF(timeData, (valueMaxRaw+valueMinRaw)/2);
-        }
+        history.setNewest(c, realMin[c], realMax[c]);
     }
 
     // advance data points
     if (dataCount < 2 && dataCount < dataCountLimit) dataCount++;
     else if(dataCount < dataCountLimit) {
         if(thisXaxisType == ValueScale) {
-            if(fillData[0][dataCount-1].x() > -interval) dataCount++;
+            if(dataCount > history.size() || (history.time(dataCount-1) - history.time(0)) > -interval) dataCount++;
         } else {
             if(elapsedTime < interval) dataCount++;
         }
@@ -991,7 +963,6 @@ void caStripPlot::TimeOutThread()
 
     // keep max and min of every curve
     for (c = 0; c < NumberOfCurves; c++ ) {
-        maxVal[c] = minVal[c] = actVal[c];
         realMax[c] = realMin[c] = realVal[c];
     }
 
@@ -1001,11 +972,7 @@ void caStripPlot::TimeOutThread()
         AutoscaleMinY = INFINITY;
 
         for (c = 0; c < NumberOfCurves; c++ ) {
-            for (int counter = 0; counter < dataCount; counter++) {
-                QwtIntervalSample P = rangeData[c].at(counter);
-                if(!qIsNaN(P.interval.maxValue()) && P.interval.maxValue() > AutoscaleMaxY) AutoscaleMaxY = P.interval.maxValue();
-                if(!qIsNaN(P.interval.minValue()) && P.interval.minValue() < AutoscaleMinY) AutoscaleMinY = P.interval.minValue();
-            }
+            history.displayRange(c, dataCount, curveMapping(c), AutoscaleMinY, AutoscaleMaxY);
         }
 
         if(AutoscaleMaxY == AutoscaleMinY) {
@@ -1029,11 +996,7 @@ void caStripPlot::TimeOutThread()
 
         for (c = 0; c < NumberOfCurves; c++ ) {
             if (!sAutoScaleCurves[c]) continue;
-            for (int counter = 0; counter < dataCount; counter++) {
-                QwtIntervalSample P = rangeData[c].at(counter);
-                if(!qIsNaN(P.interval.maxValue()) && P.interval.maxValue() > AutoscaleMaxY) AutoscaleMaxY = P.interval.maxValue();
-                if(!qIsNaN(P.interval.minValue()) && P.interval.minValue() < AutoscaleMinY) AutoscaleMinY = P.interval.minValue();
-            }
+            history.displayRange(c, dataCount, curveMapping(c), AutoscaleMinY, AutoscaleMaxY);
         }
 
         if(AutoscaleMaxY == AutoscaleMinY) {
@@ -1075,6 +1038,9 @@ void caStripPlot::TimeOut()
 
     //printf("timeout for numberofcurves=%d\n", NumberOfCurves);
 
+    QElapsedTimer guiTimer;
+    guiTimer.start();
+
     mutex.lock();
 
     // in case of restart plot, get start time and for the running time scale the new scale
@@ -1116,8 +1082,9 @@ void caStripPlot::TimeOut()
         setAxisScale(QwtPlot::xBottom, timeData - INTERVAL, timeData, INTERVAL/nbTicks);
     }
 
-    // set data into the curves
+    // derive the samples from the history and set them into the curves
     for (int c = 0; c < NumberOfCurves; c++ ) {
+        updateSamples(c, curveMapping(c));
         if(thisStyle[c] == FillUnder) {
             fillcurve[c]->setSamplesList(fillData[c]);
             fillcurve[c]->setSamples(fillData[c]);
@@ -1153,10 +1120,172 @@ void caStripPlot::TimeOut()
         oldResizeFactorY = ResizeFactorY;
     }
 
-    // replot
-    replot();
+    // replot, with the render thread the canvas is drawn outside of the mutex
+    if(renderer == (stripplotrenderer *) Q_NULLPTR) {
+        replot();
+        mutex.unlock();
+    } else {
+        mutex.unlock();
+        replot();
+    }
+
+    guiNs += guiTimer.nsecsElapsed();
+    guiFrames++;
+}
+
+/**
+ * with the render thread the axes and the layout are still done here, the canvas comes from the thread
+ */
+void caStripPlot::replot()
+{
+    if(renderer == (stripplotrenderer *) Q_NULLPTR) {
+        QwtPlot::replot();
+        return;
+    }
+
+    updateAxes();
+    QApplication::sendPostedEvents(this, QEvent::LayoutRequest);
+
+    stripRenderJob job;
+    fillJob(job);
+    renderer->render(job);
+}
+
+/**
+ * snapshot of the curves, taken from the plot items that are only changed in the gui thread
+ */
+void caStripPlot::fillJob(stripRenderJob &job)
+{
+    job.canvasRect = canvas()->contentsRect();
+    job.xMap = canvasMap(QwtPlot::xBottom);
+    job.yMap = canvasMap(QwtPlot::yLeft);
+    job.type = renderCurveType;
+    job.interval = renderInterval;
+    job.yType = thisYaxisType;
+    job.incremental = incremental && (thisXaxisType != ValueScale);
+    job.grid = plotGrid->isVisible();
+    job.gridPen = penGrid;
+#if QWT_VERSION >= 0x060100
+    job.xDiv = axisScaleDiv(QwtPlot::xBottom);
+    job.yDiv = axisScaleDiv(QwtPlot::yLeft);
+#else
+    job.xDiv = *axisScaleDiv(QwtPlot::xBottom);
+    job.yDiv = *axisScaleDiv(QwtPlot::yLeft);
+#endif
+
+    for (int c = 0; c < NumberOfCurves; c++ ) {
+        stripRenderCurve curv;
+        curv.visible = (errorcurve[c] != (QwtPlotIntervalCurveNaN *) Q_NULLPTR) && errorcurve[c]->isVisible();
+        if(!curv.visible) {
+            curv.fill = false;
+            job.curves.append(curv);
+            continue;
+        }
+        curv.fill = (thisStyle[c] == FillUnder);
+        curv.rangePen = errorcurve[c]->pen();
+        curv.rangeBrush = errorcurve[c]->brush();
+        curv.rangeData = errorcurve[c]->samplesList();
+        if(curv.fill) {
+            curv.fillPen = fillcurve[c]->pen();
+            curv.fillBrush = fillcurve[c]->brush();
+            curv.fillData = fillcurve[c]->samplesList();
+        }
+        job.curves.append(curv);
+    }
+}
 
+void caStripPlot::frameReady()
+{
+    const bool ok = QMetaObject::invokeMethod(canvas(), "replot", Qt::DirectConnection);
+    if(!ok) canvas()->update(canvas()->contentsRect());
+}
+
+/**
+ * without render thread the items are drawn as usual, otherwise the finished frame is blitted (or with
+ * incremental drawing the scrolled image) and only the remaining items (markers) are drawn here
+ */
+void caStripPlot::drawCanvas(QPainter *painter)
+{
+    QElapsedTimer guiTimer;
+    guiTimer.start();
+
+    bool incrementalDraw = (guiPainter != (stripplotpainter *) Q_NULLPTR) && (thisXaxisType != ValueScale);
+
+    if(renderer == (stripplotrenderer *) Q_NULLPTR && !incrementalDraw) {
+        QwtPlot::drawCanvas(painter);
+    } else {
+        QRect rect = canvas()->contentsRect();
+        if(renderer != (stripplotrenderer *) Q_NULLPTR) {
+            QImage frame = renderer->frame();
+            if(!frame.isNull()) {
+                if(frame.size() == rect.size()) painter->drawImage(rect.topLeft(), frame);
+                else painter->drawImage(rect, frame);
+            }
+        } else {
+            stripRenderJob job;
+            fillJob(job);
+            painter->save();
+            guiPainter->paint(painter, job);
+            painter->restore();
+        }
+
+        const QwtPlotItemList &items = itemList();
+        for(QwtPlotItemIterator it = items.begin(); it != items.end(); ++it) {
+            QwtPlotItem *item = *it;
+            if(!item->isVisible()) continue;
+            int rtti = item->rtti();
+            if(rtti == QwtPlotItem::Rtti_PlotCurve || rtti == QwtPlotItem::Rtti_PlotIntervalCurve || rtti == QwtPlotItem::Rtti_PlotGrid) continue;
+            painter->save();
+            painter->setRenderHint(QPainter::Antialiasing, item->testRenderHint(QwtPlotItem::RenderAntialiased));
+            item->draw(painter, canvasMap(item->xAxis()), canvasMap(item->yAxis()), QRectF(rect));
+            painter->restore();
+        }
+    }
+
+    guiNs += guiTimer.nsecsElapsed();
+}
+
+/**
+ * time spent in the gui thread for the display timer and the canvas paints, and in the render thread
+ */
+void caStripPlot::getFrameTimes(int &frames, double &guiUs, int &renderFrames, double &renderUs)
+{
+    frames = guiFrames;
+    guiUs = (double) guiNs / 1000.0;
+    renderFrames = 0;
+    renderUs = 0.0;
+    if(renderer != (stripplotrenderer *) Q_NULLPTR) renderer->getRenderTime(renderFrames, renderUs);
+}
+
+void caStripPlot::resetFrameTimes()
+{
+    guiFrames = 0;
+    guiNs = 0;
+    if(renderer != (stripplotrenderer *) Q_NULLPTR) renderer->resetRenderTime();
+}
+
+/**
+ * data from the archive (times in milliseconds since epoch) for the part of the history not covered by the pyramid
+ */
+void caStripPlot::archiveData(int curvIndex, const QVector<double> &times, const QVector<double> &minValues, const QVector<double> &maxValues)
+{
+    if(curvIndex < 0 || curvIndex >= NumberOfCurves) return;
+    int count = qMin(times.size(), qMin(minValues.size(), maxValues.size()));
+
+    mutex.lock();
+    double localStart = historyTime(pyramid.oldestTime());
+    for(int i = 0; i < count; i++) {
+        double t = historyTime(times.at(i) / 1000.0);
+        if(t >= localStart) continue;
+        int slot = history.find(t);
+        if(slot < 0) continue;
+        history.merge(curvIndex, slot, minValues.at(i), maxValues.at(i));
+    }
     mutex.unlock();
+
+    // older samples changed, the scrolled image of the incremental drawing has to be drawn again
+    if(renderer != (stripplotrenderer *) Q_NULLPTR) renderer->invalidate();
+    if(guiPainter != (stripplotpainter *) Q_NULLPTR) guiPainter->invalidate();
 }
 
 void caStripPlot::setYscale(double ymin, double ymax) {
@@ -1283,64 +1412,20 @@ void caStripPlot::setData(struct timeb now, double Y, int curvIndex)
 
     mutex.lock();
 
-    static std::vector<double> bmvec;
-    static std::vector<double> bmvece;
-
     realVal[curvIndex] = Y;
     realTim[curvIndex] = now;
     if(Y> realMax[curvIndex]) realMax[curvIndex]  = Y;
     if(Y< realMin[curvIndex]) realMin[curvIndex]  = Y;
 
-    // in case of fixed scales, remap the data to the first curve
+    // in case of fixed scales, the data will be remapped to the first curve when the samples are derived
     if(thisYaxisScaling == fixedScale) {
-        // We need a different Algorithm for remapping linear vs logarithmic data
-        if (thisYaxisType == linear) {
-            double y0min = thisYaxisLimitsMin[0];
-            double y0max = thisYaxisLimitsMax[0];
-            double ymin =  thisYaxisLimitsMin[curvIndex];
-            double ymax =  thisYaxisLimitsMax[curvIndex];
-            actVal[curvIndex] = (y0max - y0min) / (ymax -ymin) * (realVal[curvIndex] - ymin) + y0min;
-            minVal[curvIndex] = (y0max - y0min) / (ymax -ymin) * (realMin[curvIndex] - ymin) + y0min;
-            maxVal[curvIndex] = (y0max - y0min) / (ymax -ymin) * (realMax[curvIndex] - ymin) + y0min;
-        } else {
-            double ymin =  thisYaxisLimitsMin[curvIndex];
-            double ymax =  thisYaxisLimitsMax[curvIndex];
-            if (ymin < 1e-20) setYaxisLimitsMin(curvIndex, 1e-20);
-            if (ymax < 1e-19) setYaxisLimitsMax(curvIndex, 1e-19);
-            double y0min = thisYaxisLimitsMin[0];
-            double y0max = thisYaxisLimitsMax[0];
-            if (y0min < 1e-20) setYaxisLimitsMin(0, 1e-20);
-            if (y0max < 1e-19) setYaxisLimitsMax(0, 1e-19);
-
-            double realValPositive = qMax(realVal[curvIndex], 1e-20);
-            double realMinPositive = qMax(realMin[curvIndex], 1e-20);
-            double realMaxPositive = qMax(realMax[curvIndex], 1e-20);
-            actVal[curvIndex] = y0min*(pow((y0max/y0min),(std::log10(realValPositive/ymin)/std::log10(ymax/ymin))));
-            minVal[curvIndex] = y0min*(pow((y0max/y0min),(std::log10(realMinPositive/ymin)/std::log10(ymax/ymin))));
-            maxVal[curvIndex] = y0min*(pow((y0max/y0min),(std::log10(realMaxPositive/ymin)/std::log10(ymax/ymin))));
-            /*qDebug() << "start";
-            QElapsedTimer timer;
-            timer.start();
-            double timer1result = y0min*(pow((y0max/y0min),(std::log10(realVal[curvIndex]/ymin)/std::log10(ymax/ymin))));
-            qDebug() << timer.nsecsElapsed() << timer1result;
-            bmvec.insert(bmvec.end(), timer.nsecsElapsed());
-            timer.invalidate();
-            QElapsedTimer timer2;
-            timer2.start();
-            double timer2result = y0min*(pow((y0max/y0min),(log(realVal[curvIndex]/ymin)/log(ymax/ymin))));
-            qDebug() << timer2.nsecsElapsed() << timer2result;
-            bmvece.insert(bmvece.end(), timer2.nsecsElapsed());
-            timer2.invalidate();
-            qDebug() << "avg log10: " << std::reduce(bmvec.begin(), bmvec.end()) / bmvec.size();
-            qDebug() << "avg loge: " << std::reduce(bmvece.begin(), bmvece.end()) / bmvece.size();
-            qDebug() << "stop";*/
+        if (thisYaxisType == log10) {
+            if (thisYaxisLimitsMin[curvIndex] < 1e-20) setYaxisLimitsMin(curvIndex, 1e-20);
+            if (thisYaxisLimitsMax[curvIndex] < 1e-19) setYaxisLimitsMax(curvIndex, 1e-19);
+            if (thisYaxisLimitsMin[0] < 1e-20) setYaxisLimitsMin(0, 1e-20);
+            if (thisYaxisLimitsMax[0] < 1e-19) setYaxisLimitsMax(0, 1e-19);
         }
         setYscale(getYaxisLimitsMin(0),getYaxisLimitsMax(0));
-        // otherwise keep the data
-    } else {
-        actVal[curvIndex] = realVal[curvIndex];
-        minVal[curvIndex] = realMin[curvIndex];
-        maxVal[curvIndex] = realMax[curvIndex];
     }
 
     mutex.unlock();
@@ -65,6 +65,8 @@
 #include <qwt_date_scale_engine.h>
 
 #include <stripplotthread.h>
+#include <stripplotrenderer.h>
+#include <stripplothistory.h>
 
 class QwtPlotCurve;
 
@@ -264,7 +266,7 @@ public:
     void setUnits(units const &newU) {thisUnits = newU; defineXaxis(thisUnits, thisPeriod);}
 
     double getPeriod() const { return thisPeriod; }
-    void setPeriod(double const &newP) {thisPeriod = newP; defineXaxis(thisUnits, thisPeriod);}
+    void setPeriod(double const &newP);
 
     xAxisType getXaxisType() const {return thisXaxisType;}
     void setXaxisType(xAxisType s) {thisXaxisType=s; defineXaxis(thisUnits, thisPeriod);}
@@ -471,6 +473,12 @@ public:
 
     void setTicksResizeFactor(float factX, float factY);
 
+    bool getRenderThread() const {return (renderer != (stripplotrenderer *) Q_NULLPTR);}
+    void getFrameTimes(int &frames, double &guiUs, int &renderFrames, double &renderUs);
+    void resetFrameTimes();
+
+    virtual void drawCanvas(QPainter *painter);
+
 public slots:
     void animation(QRect p) {
 #include "animationcode.h"
@@ -489,6 +497,10 @@ public slots:
 
     void setPlotPickerMode(int mode);
 
+    virtual void replot();
+
+    void archiveData(int curvIndex, const QVector<double> &times, const QVector<double> &minValues, const QVector<double> &maxValues);
+
     void setIterableCurves(bool itCurvs) {thisIterableCurves = itCurvs;};
     void setSelectableCurves(bool selectCurvs) {thisSelectableCurves = selectCurvs;};
 
@@ -499,10 +511,12 @@ signals:
     void ShowContextMenu(const QPoint&);
     void update();
     void timerThreadStop();
+    void backfillRequest(double seconds);
 
 private slots:
      void TimeOut();
      void TimeOutThread();
+     void frameReady();
      void onSelected(const QPointF& point);
 
 private:
@@ -525,6 +539,12 @@ private:
     void TimersStart();
     void selectYAxis(quint8 newYAxisIndex);
     void remapCurve(double newMin, double newMax, quint8 curvIndex, bool isNewLog);
+    void fillJob(stripRenderJob &job);
+    void initHistory();
+    stripplotmapping curveMapping(int curvIndex) const;
+    void updateSamples(int curvIndex, const stripplotmapping &mapping);
+    void backfillHistory(double now);
+    double historyTime(double seconds) const;
 
     // curve only used to define nicely the legend
     QwtPlotCurve *curve[MAXCURVES];
@@ -532,14 +552,18 @@ private:
     QwtPlotIntervalCurveNaN *errorcurve[MAXCURVES];
     QwtPlotCurveNaN *fillcurve[MAXCURVES];
 
-    // y data for error curve
-    QVector<QwtIntervalSample> base;
+    // raw history of all curves, the samples of the error and fill curves are derived from it
+    stripplothistory history;
+    bool singlePrecision;
+    // everything seen since the display was opened, used when the period changes
+    stripplotpyramid pyramid;
+    bool backfillPending;
     QVector<QwtIntervalSample> rangeData[MAXCURVES];
     QVector<QPointF> fillData[MAXCURVES];
-
-    // original, raw y data for conversions
-    QVector<QwtIntervalSample> rangeDataRaw[MAXCURVES];
-    QVector<QPointF> fillDataRaw[MAXCURVES];
+    // second buffer of the samples, written while the curves and the render thread still use the other one
+    QVector<QwtIntervalSample> rangeSpare[MAXCURVES];
+    QVector<QPointF> fillSpare[MAXCURVES];
+    stripplotderived derived[MAXCURVES];
 
     DynamicPlotPicker * plotPicker;
 
@@ -584,7 +608,6 @@ private:
 
     void ReplaceTrailingZerosByBlancs(char *asc);
 
-    double maxVal[MAXCURVES], minVal[MAXCURVES], actVal[MAXCURVES];
     double realVal[MAXCURVES], realMax[MAXCURVES], realMin[MAXCURVES];
     struct timeb realTim[MAXCURVES];
 
@@ -593,6 +616,13 @@ private:
     QString legendText(int i);
 
     stripplotthread *timerThread;
+    stripplotrenderer *renderer;
+    stripplotpainter *guiPainter;
+    bool incremental;
+    curvType renderCurveType;
+    double renderInterval;
+    int guiFrames;
+    qint64 guiNs;
 
     QMutex mutex;
 
@@ -28,6 +28,7 @@
 #include <QApplication>
 #include <QClipboard>
 #include "catable.h"
+#include "catablemodel.h"
 #include "alarmdefs.h"
 
 #if defined(_MSC_VER)
@@ -36,25 +37,25 @@
     #endif
 #endif
 
-caTable::caTable(QWidget *parent) : QTableWidget(parent)
+caTable::caTable(QWidget *parent) : QTableView(parent)
 
 {
+    tableModel = new caTableModel(this);
+    setModel(tableModel);
+
     setPrecisionMode(Channel);
     setLimitsMode(Channel);
     setPrecision(0);
     setMinValue(0.0);
     setMaxValue(1.0);
-    for(int i=0; i< MaxRows; i++) {
-        setFormat(i, 1);
-        for(int j=0; j< MaxCols; j++) tableItem[i][j] = (QTableWidgetItem*) Q_NULLPTR;
-    }
 
     thisItemFont = this->font();
+    tableModel->setFont(thisItemFont);
 
     setColorMode(Static);
     setAlternatingRowColors(true);
     setSizePolicy(QSizePolicy::Expanding,QSizePolicy::Expanding);
-    setEditTriggers(QTableWidget::NoEditTriggers);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
     verticalHeader()->setDefaultSectionSize(20);
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
     horizontalHeader()->setResizeMode(QHeaderView::Interactive);
@@ -97,20 +98,39 @@ caTable::caTable(QWidget *parent) : QTableWidget(parent)
     createActions();
     addAction(copyAct);
 
-    connect(this, SIGNAL( cellDoubleClicked (int, int) ), this, SLOT(celldoubleclicked( int, int ) ) );
+    connect(this, SIGNAL(doubleClicked(QModelIndex)), this, SLOT(celldoubleclicked(QModelIndex)));
     setFocusPolicy(Qt::ClickFocus);
 }
 
-void caTable::cellclicked(int row, int col)
+void caTable::cellclicked(const QModelIndex &index)
+{
+    Q_UNUSED(index);
+}
+
+void caTable::celldoubleclicked(const QModelIndex &index)
+{
+     if(index.column()==1) emit TableDoubleClickedSignal(tableModel->text(index.row(), 0));
+     selectionModel()->select(index, QItemSelectionModel::Deselect);
+}
+
+int caTable::rowCount() const
 {
-    Q_UNUSED(row);
-    Q_UNUSED(col);
+    return tableModel->rowCount();
 }
 
-void caTable::celldoubleclicked(int row, int col)
+void caTable::setRowCount(int rows)
 {
-     if(col==1) emit TableDoubleClickedSignal(this->item(row, 0)->text());
-     if(tableItem[row][col] != (QTableWidgetItem*) Q_NULLPTR)  this->item(row,col)->setSelected(false);
+    tableModel->setDimensions(rows, tableModel->columnCount());
+}
+
+int caTable::columnCount() const
+{
+    return tableModel->columnCount();
+}
+
+void caTable::setColumnCount(int columns)
+{
+    tableModel->setDimensions(tableModel->rowCount(), columns);
 }
 
 void caTable::createActions() {
@@ -158,8 +178,7 @@ void caTable::copy()
             if (i > 0) str += "\n";
             for(int j = 0; j < columnCount(); ++j) {
                 if (j > 0) str += "\t";
-                QTableWidgetItem* pWidget = item(Row.row(), j);
-                str += pWidget->text();
+                str += tableModel->text(Row.row(), j);
             }
             i++;
         }
@@ -171,8 +190,7 @@ void caTable::copy()
                 if (i > 0) str += "\n";
                 for(int j = 0; j < rowCount(); ++j) {
                     if (j > 0) str += "\t";
-                    QTableWidgetItem* pWidget = item(j, Col.column());
-                    str += pWidget->text();
+                    str += tableModel->text(j, Col.column());
                 }
                 i++;
             }
@@ -187,7 +205,8 @@ void caTable::copy()
 void caTable::setFormat(int row, int prec)
 {
     int precision;
-    if(row < 0 || row > MaxRows-1) return;
+    string40 format;
+    if(row < 0 || row >= rowCount()) return;
     if(thisPrecMode == User) {
         precision = getPrecision();
     } else {
@@ -195,69 +214,70 @@ void caTable::setFormat(int row, int prec)
     }
     if(precision > 17) precision = 17;
     if(precision >= 0) {
-        sprintf(thisFormat[row], "%s.%dlf", "%", precision);
+        sprintf(format, "%s.%dlf", "%", precision);
     } else {
-        sprintf(thisFormat[row], "%s.%dle", "%", -precision);
+        sprintf(format, "%s.%dle", "%", -precision);
     }
+    tableModel->setFormat(row, format, rowVisible(row));
 }
 
-void caTable::displayText(int row, int col, short status, QString const &text)
+/**
+ * rows outside the viewport are formatted when they are scrolled into the view
+ */
+bool caTable::rowVisible(int row)
 {
-    if(row < 0 || row > MaxRows-1) return;
-    if(col < 0 || col > MaxCols-1) return;
+    if(!isVisible()) return false;
+    int top = rowAt(0);
+    int bottom = rowAt(viewport()->height() - 1);
+    if(bottom < 0) bottom = rowCount() - 1;
+    return (row >= top && row <= bottom);
+}
 
-    if(row >= rowCount() || col >= columnCount()) return;
+/**
+ * an invalid color keeps the color the cell has
+ */
+QColor caTable::statusColor(short status)
+{
+    if(thisColorMode != Alarm) return defaultForeColor;
 
-    if(tableItem[row][col] != (QTableWidgetItem*) Q_NULLPTR) {
-        tableItem[row][col]->setText(text);
-    } else {
-        tableItem[row][col] = new QTableWidgetItem(text);
-        tableItem[row][col]->setFont(thisItemFont);
-        if(col==0) tableItem[row][col]->setTextAlignment(Qt::AlignAbsolute | Qt:: AlignLeft);
-        else tableItem[row][col]->setTextAlignment(Qt::AlignAbsolute | Qt:: AlignRight);
-        setItem(row, col, tableItem[row][col]);
+    switch (status) {
+    case -1:
+        return QColor();
+    case NO_ALARM:
+        return AL_GREEN;
+    case MINOR_ALARM:
+        return AL_YELLOW;
+    case MAJOR_ALARM:
+        return AL_RED;
+    case INVALID_ALARM:
+    case NOTCONNECTED:
+        return AL_WHITE;
+    default:
+        return AL_DEFAULT;
     }
+}
 
-    if(thisColorMode == Alarm) {
+void caTable::displayText(int row, int col, short status, QString const &text)
+{
+    if(row < 0 || row >= rowCount()) return;
+    if(col < 0 || col >= columnCount()) return;
 
-        switch (status) {
-        case -1:
-            break;
-        case NO_ALARM:
-            tableItem[row][col]->setForeground(AL_GREEN);
-            break;
-        case MINOR_ALARM:
-            tableItem[row][col]->setForeground(AL_YELLOW);
-            break;
-        case MAJOR_ALARM:
-            tableItem[row][col]->setForeground(AL_RED);
-            break;
-        case INVALID_ALARM:
-        case NOTCONNECTED:
-            tableItem[row][col]->setForeground(AL_WHITE);
-            break;
-        default:
-            tableItem[row][col]->setForeground(AL_DEFAULT);
-            break;
-        }
-    }   else {
-        tableItem[row][col]->setForeground(defaultForeColor);
-    }
+    tableModel->setText(row, col, statusColor(status), text, rowVisible(row));
 }
 
 void caTable::setValueFont(QFont font)
 {
    thisItemFont = font;
+   tableModel->setFont(font);
 }
 
 
 void caTable::setValue(int row, int col, short status, double value, QString const &unit)
 {
-    string40 text = {'\0'};
     short Alarm = -1;
 
-    if(row < 0 || row > MaxRows-1) return;
-    if(col < 0 || col > MaxCols-1) return;
+    if(row < 0 || row >= rowCount()) return;
+    if(col < 0 || col >= columnCount()) return;
 
     if(thisLimitsMode == Channel) {
         Alarm = status;
@@ -268,10 +288,12 @@ void caTable::setValue(int row, int col, short status, double value, QString con
             Alarm = NO_ALARM;
         }
     }
-    //sprintf(text, thisFormat[row], value);
-    snprintf(text, 40, thisFormat[row], value);
-    displayText(row, col, Alarm, text);
-    displayText(row, col+1, Alarm, unit);
+
+    // formatting is left to the model, only when the row can be seen
+    bool visible = rowVisible(row);
+    QColor color = statusColor(Alarm);
+    tableModel->setValue(row, col, color, value, visible);
+    tableModel->setText(row, col+1, color, unit, visible);
 }
 
 
@@ -26,7 +26,7 @@
 #ifndef CATABLE_H
 #define CATABLE_H
 
-#include <QTableWidget>
+#include <QTableView>
 #include <QAction>
 #include <QFont>
 #include <qtcontrols_global.h>
@@ -35,7 +35,9 @@
 
 typedef char string40[40];
 
-class QTCON_EXPORT caTable : public QTableWidget
+class caTableModel;
+
+class QTCON_EXPORT caTable : public QTableView
 {
     Q_OBJECT
 
@@ -110,6 +112,11 @@ public:
 
     void setValueFont(QFont font);
 
+    int rowCount() const;
+    void setRowCount(int rows);
+    int columnCount() const;
+    void setColumnCount(int columns);
+
 public slots:
     void animation(QRect p) {
 #include "animationcode.h"
@@ -124,19 +131,19 @@ signals:
 
 private slots:
     void copy();
-    void celldoubleclicked(int, int);
-    void cellclicked(int, int);
+    void celldoubleclicked(const QModelIndex &index);
+    void cellclicked(const QModelIndex &index);
 
 private:
-    enum { MaxRows = 500 };
-    enum { MaxCols = 5  };
+    bool rowVisible(int row);
+    QColor statusColor(short status);
+
     QStringList	thisPVS;
     QStringList	thisColumnSizes;
     double thisMaximum, thisMinimum;
     QString thisStyle;
     QString oldStyle;
-    string40 thisFormat[MaxRows];
-    QTableWidgetItem* tableItem[MaxRows][MaxCols];
+    caTableModel *tableModel;
 
     colMode thisColorMode;
     int thisPrecision;
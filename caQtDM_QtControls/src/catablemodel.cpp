@@ -0,0 +1,179 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <QBrush>
+#include "catablemodel.h"
+
+#if defined(_MSC_VER)
+    #ifndef snprintf
+     #define snprintf _snprintf
+    #endif
+#endif
+
+caTableModel::caTableModel(QObject *parent) : QAbstractTableModel(parent)
+{
+    columns = 0;
+}
+
+int caTableModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid()) return 0;
+    return rows.size();
+}
+
+int caTableModel::columnCount(const QModelIndex &parent) const
+{
+    if(parent.isValid()) return 0;
+    return columns;
+}
+
+void caTableModel::setDimensions(int nbRows, int nbCols)
+{
+    beginResetModel();
+    int oldRows = rows.size();
+    rows.resize(qMax(0, nbRows));
+    for(int i = oldRows; i < rows.size(); i++) {
+        strcpy(rows[i].format, "%.1lf");
+        for(int j = 0; j < MaxCols; j++) {
+            rows[i].cells[j].value = 0.0;
+            rows[i].cells[j].numeric = false;
+            rows[i].cells[j].formatted = true;
+        }
+    }
+    columns = qBound(0, nbCols, (int) MaxCols);
+    endResetModel();
+}
+
+void caTableModel::setFont(const QFont &newFont)
+{
+    font = newFont;
+    if(rows.size() > 0 && columns > 0) emit dataChanged(index(0, 0), index(rows.size() - 1, columns - 1));
+}
+
+/**
+ * a new format invalidates the numeric cells of the row
+ */
+void caTableModel::setFormat(int row, const char *newFormat, bool visible)
+{
+    if(row < 0 || row >= rows.size()) return;
+    if(strcmp(rows[row].format, newFormat) == 0) return;
+    strncpy(rows[row].format, newFormat, sizeof(rows[row].format) - 1);
+    rows[row].format[sizeof(rows[row].format) - 1] = '\0';
+
+    for(int j = 0; j < columns; j++) {
+        Cell &cell = rows[row].cells[j];
+        if(!cell.numeric) continue;
+        QString oldText = cell.text;
+        cell.formatted = false;
+        if(visible) {
+            format(row, j);
+            cellChanged(row, j, oldText, cell.color);
+        }
+    }
+}
+
+void caTableModel::setText(int row, int col, const QColor &color, const QString &text, bool visible)
+{
+    if(row < 0 || row >= rows.size() || col < 0 || col >= columns) return;
+    Cell &cell = rows[row].cells[col];
+    QString oldText = cell.text;
+    QColor oldColor = cell.color;
+
+    cell.text = text;
+    cell.numeric = false;
+    cell.formatted = true;
+    if(color.isValid()) cell.color = color;
+    if(visible) cellChanged(row, col, oldText, oldColor);
+}
+
+/**
+ * the value is only formatted when the row can be seen, otherwise when it is painted
+ */
+void caTableModel::setValue(int row, int col, const QColor &color, double value, bool visible)
+{
+    if(row < 0 || row >= rows.size() || col < 0 || col >= columns) return;
+    Cell &cell = rows[row].cells[col];
+    QString oldText = cell.text;
+    QColor oldColor = cell.color;
+
+    cell.value = value;
+    cell.numeric = true;
+    cell.formatted = false;
+    if(color.isValid()) cell.color = color;
+    if(visible) {
+        format(row, col);
+        cellChanged(row, col, oldText, oldColor);
+    }
+}
+
+QString caTableModel::text(int row, int col) const
+{
+    if(row < 0 || row >= rows.size() || col < 0 || col >= columns) return QString();
+    format(row, col);
+    return rows.at(row).cells[col].text;
+}
+
+void caTableModel::format(int row, int col) const
+{
+    Cell &cell = rows[row].cells[col];
+    if(cell.formatted) return;
+    char asc[40];
+    snprintf(asc, sizeof(asc), rows.at(row).format, cell.value);
+    cell.text = QString(asc);
+    cell.formatted = true;
+}
+
+void caTableModel::cellChanged(int row, int col, const QString &oldText, const QColor &oldColor)
+{
+    const Cell &cell = rows.at(row).cells[col];
+    if(cell.text == oldText && cell.color == oldColor) return;
+    QModelIndex cellIndex = index(row, col);
+    emit dataChanged(cellIndex, cellIndex);
+}
+
+QVariant caTableModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid() || index.row() >= rows.size() || index.column() >= columns) return QVariant();
+    int row = index.row();
+    int col = index.column();
+
+    switch (role) {
+    case Qt::DisplayRole:
+        format(row, col);
+        return rows.at(row).cells[col].text;
+    case Qt::ForegroundRole:
+        if(!rows.at(row).cells[col].color.isValid()) return QVariant();
+        return QBrush(rows.at(row).cells[col].color);
+    case Qt::FontRole:
+        return font;
+    case Qt::TextAlignmentRole:
+        if(col == 0) return (int) (Qt::AlignAbsolute | Qt::AlignLeft);
+        return (int) (Qt::AlignAbsolute | Qt::AlignRight);
+    default:
+        return QVariant();
+    }
+}
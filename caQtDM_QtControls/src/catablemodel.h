@@ -0,0 +1,80 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef CATABLEMODEL_H
+#define CATABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+#include <QColor>
+#include <QFont>
+
+/**
+ * model behind caTable, keeps per cell the raw value or text and the alarm color;
+ * numeric values are formatted when the cell is painted or when its row can be seen,
+ * and the view is only told about cells whose text or color really changed
+ */
+class caTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum { MaxCols = 5 };
+
+    caTableModel(QObject *parent);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+    void setDimensions(int nbRows, int nbCols);
+    void setFont(const QFont &font);
+    void setFormat(int row, const char *newFormat, bool visible);
+    void setText(int row, int col, const QColor &color, const QString &text, bool visible);
+    void setValue(int row, int col, const QColor &color, double value, bool visible);
+    QString text(int row, int col) const;
+
+private:
+    struct Cell {
+        QString text;
+        QColor color;
+        double value;
+        bool numeric;
+        bool formatted;
+    };
+    struct Row {
+        char format[40];
+        Cell cells[MaxCols];
+    };
+
+    void format(int row, int col) const;
+    void cellChanged(int row, int col, const QString &oldText, const QColor &oldColor);
+
+    mutable QVector<Row> rows;
+    int columns;
+    QFont font;
+};
+
+#endif
@@ -35,6 +35,7 @@
 #include <QClipboard>
 #include <qnumeric.h>
 #include "cawavetable.h"
+#include "cawavetablemodel.h"
 #include "alarmdefs.h"
 
 #if defined(_MSC_VER)
@@ -44,8 +45,13 @@
 #endif
 
 
-caWaveTable::caWaveTable(QWidget *parent) : QTableWidget(parent)
+caWaveTable::caWaveTable(QWidget *parent) : QTableView(parent)
 {
+    blockIndex = -1;
+    tableModel = new caWaveTableModel(this);
+    setModel(tableModel);
+    connect(tableModel, SIGNAL(entryEdited(QString, int)), this, SLOT(dataInput(QString, int)));
+
     thisFormatC[0] = '\0';
     thisFormat[0] = '\0';
     thisUnsigned = false;
@@ -59,6 +65,9 @@ caWaveTable::caWaveTable(QWidget *parent) : QTableWidget(parent)
     colSaved = rowSaved = colcount = rowcount = 1;
     sizeSaved = -1;
     dataPresent = false;
+    keepDatatype = doubles;
+    keepDatasize = 0;
+    keepStatus = -1;
     thisItemFont = this->font();
 
     setAlternatingRowColors(true);
@@ -108,11 +117,10 @@ caWaveTable::caWaveTable(QWidget *parent) : QTableWidget(parent)
     clearFocus();
     setAccessW(true);
 
-    connect(this, SIGNAL(cellDoubleClicked (int, int) ), this, SLOT(cellDoubleclicked( int, int ) ) );
-    connect(this, SIGNAL(cellChanged(int, int)), this, SLOT(dataInput(int, int)));
-    connect(this, SIGNAL(cellClicked(int, int)), this, SLOT(cellClicked(int, int)));
+    connect(this, SIGNAL(doubleClicked(QModelIndex)), this, SLOT(cellDoubleclicked(QModelIndex)));
+    connect(this, SIGNAL(clicked(QModelIndex)), this, SLOT(cellClicked(QModelIndex)));
 
-    connect(this, SIGNAL(currentCellChanged(int, int, int, int)), this,  SLOT(cellChange(int,int, int, int)));
+    connect(selectionModel(), SIGNAL(currentChanged(QModelIndex, QModelIndex)), this,  SLOT(cellChange(QModelIndex, QModelIndex)));
 
     createActions();
     addAction(copyAct);
@@ -122,8 +130,7 @@ caWaveTable::caWaveTable(QWidget *parent) : QTableWidget(parent)
 #else
     defaultForeColor = this->palette().brush(QPalette::Text).color();
 #endif
-
-    blockIndex = -1;
+    keepColor = defaultForeColor;
 
     installEventFilter(this);
 
@@ -166,105 +173,64 @@ void caWaveTable::setNumberOfColumns(int nbCols) {
     setupItems(rowcount, colcount);
 }
 
+/**
+ * the model only needs the dimensions, the cells are formatted when they are painted
+ */
 void caWaveTable::setupItems(int nbRows, int nbCols)
 {
-    // get rid of old items and clear table
-    for(int i=0; i<rowCount(); i++) {
-        for(int j=0; j<columnCount(); j++) {
-            QTableWidgetItem *Item = item(i,j);
-            if(Item != (QTableWidgetItem *) Q_NULLPTR) {
-                delete Item;
-            }
-        }
-    }
-    clear();
-
-    // setup table with alignment of items
-    setColumnCount(nbCols);
-    setRowCount(nbRows);
-    for(int i=0; i<nbRows; i++) {
-        for(int j=0; j<nbCols; j++) {
-
-            setItem(i,j, new QTableWidgetItem());
-            item(i,j)->setFont(thisItemFont);
-            switch (thisAlignment) {
-            case Left:
-                item(i,j)->setTextAlignment(Qt::AlignLeft);
-                break;
-            case Center:
-                item(i,j)->setTextAlignment(Qt::AlignCenter);
-                break;
-            case Right:
-            default:
-                item(i,j)->setTextAlignment(Qt::AlignRight);
-                break;
-            }
-        }
-    }
+    tableModel->setDimensions(nbRows, nbCols);
+}
 
-    keepText.clear();
-    keepData.clear();
-    keepText.resize(rowcount*colcount+1);
-    keepData.resize(rowcount*colcount+1);
+int caWaveTable::rowCount() const
+{
+    return tableModel->rowCount();
 }
 
-void caWaveTable::cellChange(int currentRow, int currentColumn, int previousRow, int previousColumn) {
-    Q_UNUSED(currentRow);
-    Q_UNUSED(currentColumn);
-    Q_UNUSED(previousRow);
-    Q_UNUSED(previousColumn);
-    blockIndex = -1;
+void caWaveTable::setRowCount(int rows)
+{
+    setupItems(rows, tableModel->columnCount());
+}
+
+int caWaveTable::columnCount() const
+{
+    return tableModel->columnCount();
 }
 
-void caWaveTable::enableEdit(QTableWidgetItem* pItem)
+void caWaveTable::setColumnCount(int columns)
 {
-    Qt::ItemFlags eFlags = pItem->flags();
-    eFlags |= Qt::ItemIsEditable | Qt::ItemIsEnabled | Qt::ItemIsSelectable;
-    pItem->setFlags(eFlags);
+    setupItems(tableModel->rowCount(), columns);
 }
 
-void caWaveTable::disableEdit(QTableWidgetItem* pItem)
+void caWaveTable::cellChange(const QModelIndex &current, const QModelIndex &previous)
 {
-    Qt::ItemFlags eFlags = pItem->flags();
-    eFlags &= ~Qt::ItemIsEditable;
-    pItem->setFlags(eFlags);
+    Q_UNUSED(current);
+    Q_UNUSED(previous);
+    blockIndex = -1;
 }
 
-void caWaveTable::dataInput(int row, int col)
+void caWaveTable::dataInput(const QString &text, int index)
 {
-    int index = toIndex(row,col);
     if(!dataPresent) return;
 
     if(index == blockIndex) {
         blockIndex = -1;
-        QString valueText =  item(row, col)->text();
-
         clearSelection();
 
-        // set the value back (dataInput is now blocked again
-        if(item(row,col) != (QTableWidgetItem*) Q_NULLPTR) {
-            item(row,col)->setText(keepText[index]);
-        }
-
-        // and write it to the control system
-        emit WaveEntryChanged(valueText, index);
+        // the model keeps the monitored value, write the new one to the control system
+        emit WaveEntryChanged(text, index);
     }
 }
 
-void caWaveTable::cellClicked(int row, int col)
+void caWaveTable::cellClicked(const QModelIndex &index)
 {
-    Q_UNUSED(row)
-    Q_UNUSED(col)
-    disableEdit(item(row, col));
+    Q_UNUSED(index);
     QTimer::singleShot(2000, this, SLOT(clearSelection()));
 }
 
-void caWaveTable::cellDoubleclicked(int row, int col)
+void caWaveTable::cellDoubleclicked(const QModelIndex &index)
 {
-    enableEdit(item(row,col));
-
-    // prevent monitoring change of this item until focus is lost again
-    blockIndex = toIndex(row, col);
+    // the model allows editing of this cell only, monitoring continues underneath the editor
+    blockIndex = toIndex(index.row(), index.column());
 }
 
 bool caWaveTable::eventFilter(QObject *obj, QEvent *event)
@@ -388,7 +354,7 @@ void caWaveTable::setFormat(DataType dataType)
 
 }
 
-QString caWaveTable::setValue(double value, DataType dataType)
+QString caWaveTable::setValue(double value, DataType dataType) const
 {
     char asc[MAX_STRING_LENGTH];
 
@@ -438,58 +404,137 @@ void caWaveTable::fromIndex(int index, int &row, int &col)
     col = index - row * colcount;
 }
 
-void caWaveTable::displayText(int index, short status, QString const &text)
+/**
+ * formats one element, called by the model for the cells being painted
+ */
+QString caWaveTable::elementText(int index) const
 {
-    int column =0;
-    int row = 0;
-
-    if(index > colcount * rowcount) return;
-    if(keepText[index] == text) return;
-
-    keepText[index] = text;
+    if(!dataPresent || index < 0 || index >= keepDatasize) return QString();
+    if(keepDatatype == strings) {
+        if(index < keepStrings.size()) return keepStrings.at(index);
+        return QString();
+    }
+    return setValue(keepData.at(index), keepDatatype);
+}
 
-    if(index == blockIndex) return;
+/**
+ * returns true when the foreground color of the cells has changed
+ */
+bool caWaveTable::setStatusColor(short status)
+{
+    QColor color = keepColor;
 
-    if(colcount == 0) row = 0;
-    else row = index / colcount;
-    column = index - row * colcount;
-    if(column < 0) column=0;
+    if(thisColorMode == Alarm) {
+        switch (status) {
+        case -1:
+            break;
+        case NO_ALARM:
+            color = AL_GREEN;
+            break;
+        case MINOR_ALARM:
+            color = AL_YELLOW;
+            break;
+        case MAJOR_ALARM:
+            color = AL_RED;
+            break;
+        case INVALID_ALARM:
+        case NOTCONNECTED:
+            color = AL_WHITE;
+            break;
+        default:
+            color = AL_DEFAULT;
+            break;
+        }
+    } else {
+        color = defaultForeColor;
+    }
 
-    if(this->item(row, column) != 0)  {
+    if(color == keepColor) return false;
+    keepColor = color;
+    return true;
+}
 
-        this->item(row,column)->setText(text);
+/**
+ * tell the view which elements changed; only the visible part is repainted,
+ * the other cells are formatted when they are scrolled into the view
+ */
+void caWaveTable::refreshElements(int first, int last)
+{
+    int nbRows = rowCount();
+    int nbCols = columnCount();
+    if(first < 0 || last < first || nbRows == 0 || nbCols == 0 || !isVisible()) return;
+
+    int topRow = rowAt(0);
+    int bottomRow = rowAt(viewport()->height() - 1);
+    int leftColumn = columnAt(0);
+    int rightColumn = columnAt(viewport()->width() - 1);
+    if(topRow < 0) topRow = 0;
+    if(bottomRow < 0) bottomRow = nbRows - 1;
+    if(leftColumn < 0) leftColumn = 0;
+    if(rightColumn < 0) rightColumn = nbCols - 1;
+
+    // within one row only the changed columns
+    if(first / nbCols == last / nbCols) {
+        leftColumn = qMax(leftColumn, first % nbCols);
+        rightColumn = qMin(rightColumn, last % nbCols);
+    }
 
-        if(thisColorMode == Alarm) {
+    // the cell being edited is left alone, otherwise the view would overwrite the text typed in its editor
+    int editing = (state() == QAbstractItemView::EditingState) ? blockIndex : -1;
+    tableModel->cellsChanged(qMax(first / nbCols, topRow), leftColumn, qMin(last / nbCols, bottomRow), rightColumn, editing);
+}
 
-            switch (status) {
-            case -1:
-                break;
-            case NO_ALARM:
-                this->item(row, column)->setForeground(AL_GREEN);
-                break;
-            case MINOR_ALARM:
-                this->item(row, column)->setForeground(AL_YELLOW);
-                break;
-            case MAJOR_ALARM:
-                this->item(row, column)->setForeground(AL_RED);
-                break;
-            case INVALID_ALARM:
-            case NOTCONNECTED:
-                this->item(row, column)->setForeground(AL_WHITE);
-                break;
-            default:
-                this->item(row, column)->setForeground(AL_DEFAULT);
-                break;
-            }
-        }   else {
-            this->item(row, column)->setForeground(defaultForeColor);
+/**
+ * take over the new values into the kept ones and find the range of elements where value, format or color changed;
+ * the values are converted and compared in place, the kept vector is reused and not copied
+ */
+template <typename T> void caWaveTable::updateData(const T *array, int size, DataType dataType, short status)
+{
+    char formatSaved[20], formatCSaved[20];
+    strcpy(formatSaved, thisFormat);
+    strcpy(formatCSaved, thisFormatC);
+    setFormat(dataType);
+
+    bool colorChanged = setStatusColor(status);
+    bool all = !dataPresent || dataType != keepDatatype || colorChanged || strcmp(formatSaved, thisFormat) || strcmp(formatCSaved, thisFormatC);
+    int first = -1, last = -1;
+
+    size = qMax(0, size);
+    int keptSize = keepData.size();
+    keepData.resize(size);
+    double *values = keepData.data();
+    for(int i=0; i < size; i++) {
+        double newValue = (double) array[i];
+        if(!all && i < keptSize) {
+            double oldValue = values[i];
+            if(newValue == oldValue || (qIsNaN(newValue) && qIsNaN(oldValue))) continue;
         }
+        values[i] = newValue;
+        if(first < 0) first = i;
+        last = i;
     }
+
+    if(all) {
+        first = 0;
+        last = qMax(size, keepDatasize) - 1;
+    } else if(keptSize > size) {
+        if(first < 0) first = size;
+        last = keptSize - 1;
+    }
+
+    keepStrings.clear();
+    dataPresent = true;
+    keepDatatype = dataType;
+    keepDatasize = size;
+    keepStatus = status;
+
+    refreshElements(first, last);
 }
 
 void caWaveTable::setValueFont(QFont font)
 {
     thisItemFont = font;
+    refreshElements(0, rowCount() * columnCount() - 1);
 }
 
 QString caWaveTable::getPV() const
@@ -505,101 +550,67 @@ void caWaveTable::setPV(QString const &newPV)
 void caWaveTable::setStringList(QStringList list, short status, int size)
 {
     if(size != sizeSaved) RedefineRowColumns(rowSaved, colSaved, size, rowcount, colcount);
-    int maxSize = rowcount * colcount;
+    int maxSize = qMin(qMin(size, list.size()), rowcount * colcount);
     sizeSaved = size;
 
-    for(int i=0; i< qMin(size, maxSize); i++) {
-        displayText(i, status, list.at(i));
+    bool colorChanged = setStatusColor(status);
+    int first = -1, last = -1;
+
+    if(!dataPresent || keepDatatype != strings || colorChanged) {
+        first = 0;
+        last = qMax(maxSize, keepDatasize) - 1;
+    } else {
+        for(int i=0; i < qMax(maxSize, keepDatasize); i++) {
+            if(i < maxSize && i < keepStrings.size() && list.at(i) == keepStrings.at(i)) continue;
+            if(first < 0) first = i;
+            last = i;
+        }
     }
+
+    if(maxSize < list.size()) keepStrings = list.mid(0, maxSize);
+    else keepStrings = list;
+    keepData.clear();
     dataPresent = true;
     keepDatatype = strings;
-    keepDatasize = qMin(size, maxSize);
+    keepDatasize = maxSize;
     keepStatus = status;
+
+    refreshElements(first, last);
 }
 
 void caWaveTable::setData(double *array, short status, int size)
 {
     if(size != sizeSaved) RedefineRowColumns(rowSaved, colSaved, size, rowcount, colcount);
-    int maxSize = rowcount * colcount;
     sizeSaved = size;
-
-    setFormat(doubles);
-    for(int i=0; i< qMin(size, maxSize); i++) {
-        displayText(i, status, setValue(array[i], doubles));
-        keepData[i] = array[i];
-    }
-    dataPresent = true;
-    keepDatatype = doubles;
-    keepDatasize = qMin(size, maxSize);
-    keepStatus = status;
+    updateData(array, qMin(size, rowcount * colcount), doubles, status);
 }
 
 void caWaveTable::setData(float *array, short status, int size)
 {
     if(size != sizeSaved) RedefineRowColumns(rowSaved, colSaved, size, rowcount, colcount);
-    int maxSize = rowcount * colcount;
     sizeSaved = size;
-
-    setFormat(doubles);
-    for(int i=0; i< qMin(size, maxSize); i++) {
-        displayText(i, status, setValue(array[i], doubles));
-        keepData[i] = (double) array[i];
-    }
-    dataPresent = true;
-    keepDatatype = doubles;
-    keepDatasize = qMin(size, maxSize);
-    keepStatus = status;
+    updateData(array, qMin(size, rowcount * colcount), doubles, status);
 }
 
 void caWaveTable::setData(int16_t *array, short status, int size)
 {
     if(size != sizeSaved) RedefineRowColumns(rowSaved, colSaved, size, rowcount, colcount);
-    int maxSize = rowcount * colcount;
     sizeSaved = size;
-
-    setFormat(longs);
-    for(int i=0; i< qMin(size, maxSize); i++) {
-        displayText(i, status, setValue(array[i], longs));
-        keepData[i] = (double) array[i];
-    }
-    dataPresent = true;
-    keepDatatype = longs;
-    keepDatasize = qMin(size, maxSize);
-    keepStatus = status;
+    updateData(array, qMin(size, rowcount * colcount), longs, status);
 }
 
 void caWaveTable::setData(int32_t *array, short status, int size)
 {
     if(size != sizeSaved) RedefineRowColumns(rowSaved, colSaved, size, rowcount, colcount);
-    int maxSize = rowcount * colcount;
     sizeSaved = size;
-
-    setFormat(longs);
-    for(int i=0; i< qMin(size, maxSize); i++) {
-        displayText(i, status, setValue(array[i], longs));
-        keepData[i] = (double) array[i];
-    }
-    dataPresent = true;
-    keepDatatype = longs;
-    keepDatasize = qMin(size, maxSize);
-    keepStatus = status;
+    updateData(array, qMin(size, rowcount * colcount), longs, status);
 }
 
 void caWaveTable::setData(char *array, short status, int size)
 {
     if(size != sizeSaved) RedefineRowColumns(rowSaved, colSaved, size, rowcount, colcount);
-    int maxSize = rowcount * colcount;
     sizeSaved = size;
-
-    setFormat(characters);
-    for(int i=0; i< qMin(size, maxSize); i++) {
-        displayText(i, status, setValue((double) ((int) array[i]), characters));
-        keepData[i] =  (double) ((int) array[i]);
-    }
-    dataPresent = true;
-    keepDatatype = characters;
-    keepDatasize = qMin(size, maxSize);
-    keepStatus = status;
+    updateData(array, qMin(size, rowcount * colcount), characters, status);
 }
 
 void caWaveTable::setDataType(QString const &datatype)
@@ -608,11 +619,7 @@ void caWaveTable::setDataType(QString const &datatype)
     else thisUnsigned = false;
 
     if(keepDatatype == strings) return;
-    if(dataPresent) {
-        for(int i=0; i< keepDatasize; i++) {
-            displayText(i, keepStatus, setValue(keepData[i], keepDatatype));
-        }
-    }
+    if(dataPresent) refreshElements(0, keepDatasize - 1);
 }
 
 
@@ -634,8 +641,7 @@ void caWaveTable::copy()
             if (i > 0) str += "\n";
             for(int j = 0; j < columnCount(); ++j) {
                 if (j > 0) str += "\t";
-                QTableWidgetItem* pWidget = item(Row.row(), j);
-                str += pWidget->text();
+                str += tableModel->data(tableModel->index(Row.row(), j)).toString();
             }
             i++;
         }
@@ -647,8 +653,7 @@ void caWaveTable::copy()
                 if (i > 0) str += "\n";
                 for(int j = 0; j < rowCount(); ++j) {
                     if (j > 0) str += "\t";
-                    QTableWidgetItem* pWidget = item(j, Col.column());
-                    str += pWidget->text();
+                    str += tableModel->data(tableModel->index(j, Col.column())).toString();
                 }
                 i++;
             }
@@ -26,7 +26,10 @@
 #ifndef CAWAVETABLE_H
 #define CAWAVETABLE_H
 
-#include <QTableWidget>
+#include <QTableView>
+#include <QVector>
+#include <QStringList>
+#include <QColor>
 #include <QAction>
 #include <QFont>
 #include <QEvent>
@@ -37,7 +40,9 @@
 
 typedef char string40[40];
 
-class QTCON_EXPORT caWaveTable : public QTableWidget
+class caWaveTableModel;
+
+class QTCON_EXPORT caWaveTable : public QTableView
 {
     Q_OBJECT
     Q_PROPERTY(int rowCount READ rowCount WRITE setRowCount DESIGNABLE false)
@@ -94,7 +99,6 @@ public:
     void setDataType(QString const &datatype);
 
     void setActualPrecision(int prec);
-    void displayText(int index, short status, QString const &text);
 
     void setValueFont(QFont font);
 
@@ -121,6 +125,11 @@ public:
                                                   }
     Alignment getAlignment() const {return thisAlignment;}
 
+    int rowCount() const;
+    void setRowCount(int rows);
+    int columnCount() const;
+    void setColumnCount(int columns);
+
 public slots:
     void animation(QRect p) {
 #include "animationcode.h"
@@ -132,24 +141,28 @@ public slots:
 
 private slots:
     void copy();
-    void dataInput(int, int);
-    void cellDoubleclicked(int, int);
-    void cellClicked(int, int);
-    void cellChange(int, int, int, int);
+    void dataInput(const QString &text, int index);
+    void cellDoubleclicked(const QModelIndex &index);
+    void cellClicked(const QModelIndex &index);
+    void cellChange(const QModelIndex &current, const QModelIndex &previous);
 
 signals:
     void WaveEntryChanged(const QString &text, int index);
 
 private:
+    friend class caWaveTableModel;
+
     bool eventFilter(QObject *obj, QEvent *event);
     void createActions();
-    void enableEdit(QTableWidgetItem* pItem);
-    void disableEdit(QTableWidgetItem* pItem);
     void setupItems(int nbRows, int nbCols);
     int toIndex(int row, int col);
     void fromIndex(int index, int &row, int &col);
     void setFormat(DataType dataType);
-    QString setValue(double value, DataType dataType);
+    QString setValue(double value, DataType dataType) const;
+    QString elementText(int index) const;
+    template <typename T> void updateData(const T *array, int size, DataType dataType, short status);
+    bool setStatusColor(short status);
+    void refreshElements(int first, int last);
     void RedefineRowColumns(int xsav, int ysav, int z, int &x, int &y);
 
     bool _AccessW;
@@ -167,8 +180,11 @@ private:
     QFont thisItemFont;
     QAction *copyAct;
 
-    QVector<QString> keepText;
+    caWaveTableModel *tableModel;
+
     QVector<double> keepData;
+    QStringList keepStrings;
+    QColor keepColor;
     DataType keepDatatype;
     int keepDatasize;
     short keepStatus;
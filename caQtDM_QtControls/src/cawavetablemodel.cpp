@@ -0,0 +1,125 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include <QBrush>
+#include "cawavetablemodel.h"
+#include "cawavetable.h"
+
+caWaveTableModel::caWaveTableModel(caWaveTable *table) : QAbstractTableModel(table)
+{
+    tableP = table;
+    rows = columns = 0;
+}
+
+int caWaveTableModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid()) return 0;
+    return rows;
+}
+
+int caWaveTableModel::columnCount(const QModelIndex &parent) const
+{
+    if(parent.isValid()) return 0;
+    return columns;
+}
+
+void caWaveTableModel::setDimensions(int nbRows, int nbCols)
+{
+    beginResetModel();
+    rows = qMax(0, nbRows);
+    columns = qMax(0, nbCols);
+    endResetModel();
+}
+
+/**
+ * the table tells us which cells changed, it has already clipped them to the visible part;
+ * the element with an open editor is not signalled, the range is split around it
+ */
+void caWaveTableModel::cellsChanged(int firstRow, int firstColumn, int lastRow, int lastColumn, int skipElement)
+{
+    if(lastRow < firstRow || lastColumn < firstColumn) return;
+
+    int skipRow = (skipElement >= 0 && columns > 0) ? skipElement / columns : -1;
+    int skipColumn = (skipElement >= 0 && columns > 0) ? skipElement % columns : -1;
+    if(skipRow < firstRow || skipRow > lastRow || skipColumn < firstColumn || skipColumn > lastColumn) {
+        emit dataChanged(index(firstRow, firstColumn), index(lastRow, lastColumn));
+        return;
+    }
+
+    if(skipRow > firstRow) emit dataChanged(index(firstRow, firstColumn), index(skipRow - 1, lastColumn));
+    if(skipColumn > firstColumn) emit dataChanged(index(skipRow, firstColumn), index(skipRow, skipColumn - 1));
+    if(skipColumn < lastColumn) emit dataChanged(index(skipRow, skipColumn + 1), index(skipRow, lastColumn));
+    if(skipRow < lastRow) emit dataChanged(index(skipRow + 1, firstColumn), index(lastRow, lastColumn));
+}
+
+QVariant caWaveTableModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid()) return QVariant();
+    int element = index.row() * columns + index.column();
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return tableP->elementText(element);
+    case Qt::ForegroundRole:
+        return QBrush(tableP->keepColor);
+    case Qt::FontRole:
+        return tableP->thisItemFont;
+    case Qt::TextAlignmentRole:
+        switch (tableP->thisAlignment) {
+        case caWaveTable::Left:
+            return (int) Qt::AlignLeft;
+        case caWaveTable::Center:
+            return (int) Qt::AlignCenter;
+        case caWaveTable::Right:
+        default:
+            return (int) Qt::AlignRight;
+        }
+    default:
+        return QVariant();
+    }
+}
+
+/**
+ * a value was edited, the model is not changed, the new value will be written to the control system
+ * and comes back with the next monitor
+ */
+bool caWaveTableModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if(!index.isValid() || role != Qt::EditRole) return false;
+    emit entryEdited(value.toString(), index.row() * columns + index.column());
+    return true;
+}
+
+/**
+ * only the cell that was double clicked may be edited
+ */
+Qt::ItemFlags caWaveTableModel::flags(const QModelIndex &index) const
+{
+    if(!index.isValid()) return Qt::NoItemFlags;
+    Qt::ItemFlags eFlags = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+    if(tableP->blockIndex >= 0 && tableP->blockIndex == index.row() * columns + index.column()) eFlags |= Qt::ItemIsEditable;
+    return eFlags;
+}
@@ -0,0 +1,62 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef CAWAVETABLEMODEL_H
+#define CAWAVETABLEMODEL_H
+
+#include <QAbstractTableModel>
+
+class caWaveTable;
+
+/**
+ * model behind caWaveTable, the values are kept only once in the table
+ * and are formatted lazily in data(), i.e. only for the cells the view is really painting
+ */
+class caWaveTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    caWaveTableModel(caWaveTable *table);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole);
+    Qt::ItemFlags flags(const QModelIndex &index) const;
+
+    void setDimensions(int nbRows, int nbCols);
+    void cellsChanged(int firstRow, int firstColumn, int lastRow, int lastColumn, int skipElement = -1);
+
+signals:
+    void entryEdited(const QString &text, int index);
+
+private:
+    caWaveTable *tableP;
+    int rows;
+    int columns;
+};
+
+#endif
@@ -5,27 +5,142 @@
 * found in file mdaLICENSE that is included with this distribution. 
 \*************************************************************************/
 #include <stdlib.h>
-#include "mda-load.h"
+#include <string.h>
+#include <QtEndian>
 #include "mdaReader.h"
 #include "qtdefinitions.h"
 
 #define PRINT(x)
 
-void mdaReaderThread(const char *dataFile, int y_cpy);
-struct mda_file *mdaData = NULL;
-
 void mdaReader_RegisterPV(QString pvName) {
     Q_UNUSED(pvName); // not clean but not well solvable with preprocessor
     PRINT(printf("Somebody registered %s\n", qasc(pvName)));
 	return;
 }
 
-int mdaReader_gimmeYerData(QString QS_dataFile, QString QS_pvName, float *data, int nx, int ny, int y_cpt) {
-	int i, j, index, detNum=0, ycpt, xcpt;
+/**
+ * reads the xdr encoding of mda_loader.c from the mapped file; every read is checked against the end,
+ * as the file of a running scan can be incomplete
+ */
+class mdaCursor
+{
+public:
+    mdaCursor(const uchar *data, qint64 size, qint64 pos) : data(data), size(size), pos(pos), ok(pos >= 0 && pos <= size) {}
+
+    qint32 int32() {
+        if (!ok || pos + 4 > size) {
+            ok = false;
+            return 0;
+        }
+        qint32 value = qFromBigEndian<qint32>(data + pos);
+        pos += 4;
+        return value;
+    }
+    // xdr encodes a 16 bit integer in 4 bytes
+    qint16 int16() { return (qint16) int32(); }
+    void skip(qint64 bytes) {
+        if (!ok || bytes < 0 || pos + bytes > size) ok = false;
+        else pos += bytes;
+    }
+    // a counted string is its length followed, when not empty, by the xdr string (length, bytes padded to 4)
+    QByteArray string() {
+        if (int32() == 0) return QByteArray();
+        qint32 length = int32();
+        if (!ok || length < 0 || pos + length > size) {
+            ok = false;
+            return QByteArray();
+        }
+        QByteArray value((const char *) data + pos, length);
+        skip((length + 3) & ~3);
+        return value;
+    }
+    void skipString() {
+        if (int32() == 0) return;
+        qint32 length = int32();
+        if (length < 0) ok = false;
+        else skip((qint64) ((length + 3) & ~3));
+    }
+
+    const uchar *data;
+    qint64 size;
+    qint64 pos;
+    bool ok;
+};
+
+/**
+ * reads the scan at the cursor up to its data: the number of points, the sub-scan offsets (when asked for)
+ * and where the detector columns are; nothing of the data itself is decoded
+ */
+static bool indexScan(mdaCursor &cursor, mdaRowIndex &row, int *rank, QVector<qint32> *offsets, QByteArray *name)
+{
+    row.offset = cursor.pos;
+    int scanRank = cursor.int16();
+    row.requestedPoints = cursor.int32();
+    row.lastPoint = cursor.int32();
+    if (!cursor.ok || scanRank < 1 || row.requestedPoints < 0) return false;
+    if (rank != Q_NULLPTR) *rank = scanRank;
+
+    if (scanRank > 1) {
+        if (offsets != Q_NULLPTR) {
+            offsets->resize(row.requestedPoints);
+            for (int i = 0; i < row.requestedPoints; i++) (*offsets)[i] = cursor.int32();
+        } else {
+            cursor.skip((qint64) row.requestedPoints * 4);
+        }
+    }
+
+    if (name != Q_NULLPTR) *name = cursor.string();
+    else cursor.skipString();
+    cursor.skipString(); // time
+
+    int positioners = cursor.int16();
+    int detectors = cursor.int16();
+    int triggers = cursor.int16();
+    if (!cursor.ok || positioners < 0 || detectors < 0 || triggers < 0) return false;
+
+    // number, name, description, step mode, unit, readback name, readback description, readback unit
+    for (int i = 0; i < positioners && cursor.ok; i++) {
+        cursor.int16();
+        for (int j = 0; j < 7; j++) cursor.skipString();
+    }
+    // number, name, description, unit
+    row.detectors.resize(detectors);
+    for (int i = 0; i < detectors && cursor.ok; i++) {
+        row.detectors[i] = cursor.int16();
+        for (int j = 0; j < 3; j++) cursor.skipString();
+    }
+    // number, name, command
+    for (int i = 0; i < triggers && cursor.ok; i++) {
+        cursor.int16();
+        cursor.skipString();
+        cursor.int32();
+    }
+    // positioner data are doubles, the detector columns follow
+    cursor.skip((qint64) positioners * row.requestedPoints * 8);
+    row.detectorsData = cursor.pos;
+    return cursor.ok;
+}
+
+mdaReader::mdaReader()
+{
+    savedYcpt = 0;
+    mapped = Q_NULLPTR;
+    mappedSize = 0;
+    valid = false;
+    topRank = 0;
+    topLastPoint = 0;
+}
+
+mdaReader::~mdaReader()
+{
+    unload();
+}
+
+int mdaReader::gimmeYerData(QString QS_dataFile, QString QS_pvName, float *data, int nx, int ny, int y_cpt) {
+	int i, j, detNum=0, ycpt;
 	char pvName[60] = "";
-	struct mda_scan *thisScan = NULL;
 
-    strcpy(pvName, qasc(QS_pvName));
+    qstrncpy(pvName, qasc(QS_pvName), 60);
 	detNum = atol(&(pvName[strlen(pvName)-4]));
 	detNum--; // convert from pvName number 01..70 to array index 0..69
 	if (detNum < 0) {
@@ -33,55 +148,34 @@ int mdaReader_gimmeYerData(QString QS_dataFile, QString QS_pvName, float *data,
 		return(-1);
 	}
 	PRINT(printf("Somebody requested data for %s (detNum=%d), y_cpt=%d\n", pvName, detNum, y_cpt));
-	
-	// This should be a message to a reader thread.  For now, we just read the whole file.
-    mdaReaderThread(qasc(QS_dataFile), y_cpt);
-	if (!mdaData) {
+
+	// the file stays mapped only until the data are read, see unmap() at every return
+	if (!load(QS_dataFile, y_cpt)) {
+		unmap();
 		return(-1);
 	}
 
-	PRINT(printf("top-level scan name %s\n", mdaData->scan->name));
-	if (strncmp(mdaData->scan->name, pvName, strlen(mdaData->scan->name))) {
-		if (mdaData->scan->scan_rank < 2) {
+	PRINT(printf("top-level scan name %s\n", topName.constData()));
+	if (strncmp(topName.constData(), pvName, topName.size())) {
+		if (topRank < 2 || rows.isEmpty()) {
+			unmap();
 			return(-1);
 		}
-		thisScan = mdaData->scan->sub_scans[0]; // 2D data is one rank down in file
-		// Find detector index in file that corresponds to detNum
-		for (index=0; index < thisScan->number_detectors; index++) {
-			if (detNum == thisScan->detectors[index]->number) break;
-		}
-		if (index == thisScan->number_detectors) {
+		// 2D data is one rank down in file
+		if (!rows.at(0).detectors.contains(detNum)) {
 			PRINT(printf("detNum %d does not occur in data file\n", detNum));
 			for (i=0; i<ny; i++) {
 				for (j=0; j<nx; j++) data[i*nx+j] = 0.;
 			}
+			unmap();
 			return(-1);
 		}
-		PRINT(printf("2D data from %s\n", mdaData->scan->sub_scans[0]->name));
 		// last_point is the number of data points acquired
-		ycpt = mdaData->scan->last_point;
-		if (mdaData->scan->sub_scans == NULL) {
-			PRINT(printf("Expected 2D data not found\n"));
-			return(-1);
-		}
+		ycpt = qMin(topLastPoint, ny);
 		for (i=0; i<ycpt; i++) {
-			thisScan = mdaData->scan->sub_scans[i];
-			if (thisScan == NULL) {
+			if (readColumn(i, detNum, &data[i*nx], nx) < 0) {
 				PRINT(printf("Expected 2D data (sub_scans[%d]) not found\n", i));
 				for (j=0; j<nx; j++) data[i*nx+j] = 0.;
-				continue;
-			}
-			xcpt = thisScan->last_point;
-			if (thisScan->detectors_data[index] == NULL) {
-				PRINT(printf("Expected 2D data (detectors_data[%d]) not found\n", index));
-				for (j=0; j<nx; j++) data[i*nx+j] = 0.;
-				continue;
-			}
-			for (j=0; j<xcpt; j++) {
-				data[i*nx+j] = thisScan->detectors_data[index][j];
-			}
-			for(; j<nx; j++) {
-				data[i*nx+j] = 0.;
 			}
 		}
 		for (; i<ny; i++) {
@@ -90,42 +184,141 @@ int mdaReader_gimmeYerData(QString QS_dataFile, QString QS_pvName, float *data,
 			}
 		}
 	}
-	
-	return(0);
-};
 
+	unmap();
+	return(0);
+}
 
-// Should have a thread to read the data file.  For now, just do it in the GUI thread.
+/**
+ * decodes the acquired points of one detector of a sub-scan into data, the rest of data is set to zero;
+ * returns the number of points decoded or -1
+ */
+int mdaReader::readColumn(int row, int detNum, float *data, int n)
+{
+	if (row < 0 || row >= rows.size()) return -1;
+	const mdaRowIndex &index = rows.at(row);
+	int column = index.detectors.indexOf(detNum);
+	if (column < 0) return -1;
 
-#define NAMELEN 100
-void mdaReaderThread(const char *dataFile, int y_cpt) {
-	FILE *fp;
-	static char saved_dataFile[NAMELEN] = "";
-	static int saved_ycpt = 0;
-    char fname[NAMELEN] = "";
+	int count = qMax(qMin(qMin(index.lastPoint, index.requestedPoints), n), 0);
+	qint64 pos = index.detectorsData + (qint64) column * index.requestedPoints * 4;
+	if (pos + (qint64) count * 4 > mappedSize) return -1;
 
-	if ((strncmp(dataFile, saved_dataFile, NAMELEN) == 0) && (y_cpt <= saved_ycpt)) {
-		return;
+	const uchar *src = mapped + pos;
+	for (int j = 0; j < count; j++) {
+		quint32 bits = qFromBigEndian<quint32>(src + j * 4);
+		memcpy(&data[j], &bits, sizeof(float));
 	}
+	for (int j = count; j < n; j++) data[j] = 0.;
+	return count;
+}
 
-    qstrncpy(saved_dataFile, dataFile, NAMELEN);
-	saved_ycpt = y_cpt;
-
-	// for now, because mda_load doesn't know how to add to data structure
-	if (mdaData) mda_unload(mdaData);
+/**
+ * maps the file and reads the outer scan for its number of points and the offsets of its sub-scans;
+ * only the sub-scans that are new are indexed, the last indexed one again, as it could have been completed since.
+ * another file or a scan starting again is read from the beginning.
+ */
+bool mdaReader::load(const QString &dataFile, int y_cpt)
+{
+	QString fname;
 
-	if (strncmp(dataFile, "//", strlen("//")) == 0) {
+	if (dataFile.startsWith("//")) {
 		// a vxWorks IOC has a filepath specification that's different from that of
 		// a linux soft ioc.  The form is "//server/dir1/dir2/file", and I assume
 		// a valid path to file is "/net/server/dir1/dir2/file".  I don't know how
 		// portable this is, but sysadmins here suggest it's common for an automounter.
 		// I'm out of my league here.
-        qstrncpy(fname, "/net",NAMELEN);
-        strncat(fname, dataFile,NAMELEN-1);
+		fname = "/net" + dataFile;
+	} else {
+		fname = dataFile;
+	}
+
+	// nothing new, the index is still valid and only the columns are read again
+	if ((dataFile == savedDataFile) && (y_cpt == savedYcpt)) {
+		return valid && map(fname);
+	}
+	if ((dataFile != savedDataFile) || (y_cpt < savedYcpt)) unload();
+	savedDataFile = dataFile;
+	savedYcpt = y_cpt;
+
+	if (!map(fname)) return false;
+
+	// header: version, scan number, data rank, dimensions, regular, extra pvs offset
+	mdaCursor cursor(mapped, mappedSize, 0);
+	cursor.skip(8);
+	int dataRank = cursor.int16();
+	cursor.skip((qint64) qMax(dataRank, 0) * 4 + 8);
+
+	mdaRowIndex top;
+	QVector<qint32> offsets;
+	QByteArray name;
+	int rank;
+	if (!cursor.ok || dataRank < 1 || !indexScan(cursor, top, &rank, &offsets, &name)) {
+		return valid;
+	}
+	valid = true;
+	topName = name;
+	topRank = rank;
+	topLastPoint = top.lastPoint;
+
+	if (topRank > 1) {
+		int last = qMin(top.lastPoint, top.requestedPoints);
+		int first = qMax(rows.size() - 1, 0);
+		// a sub-scan that is not anymore where it was indexed from
+		for (int i = 0; i < first; i++) {
+			if (i >= last || rows.at(i).offset != offsets.at(i)) {
+				first = i;
+				break;
+			}
+		}
+		rows.resize(qMin(first, rows.size()));
+		for (int i = first; i < last; i++) {
+			mdaRowIndex row;
+			mdaCursor rowCursor(mapped, mappedSize, offsets.at(i));
+			if (offsets.at(i) <= 0 || !indexScan(rowCursor, row, Q_NULLPTR, Q_NULLPTR, Q_NULLPTR)) break;
+			rows.append(row);
+		}
 	} else {
-        strncat(fname, dataFile,NAMELEN-1);
+		rows.clear();
+	}
+	PRINT(printf("mdaReader: indexed '%s', %d sub-scans\n", qasc(fname), rows.size()));
+	return true;
+}
+
+/**
+ * maps the whole file read only; where mapping is not possible the file is read into memory
+ */
+bool mdaReader::map(const QString &fileName)
+{
+	unmap();
+	if (!QFile::exists(fileName)) return false;
+	file.setFileName(fileName);
+	if (!file.open(QIODevice::ReadOnly)) return false;
+	mappedSize = file.size();
+	if (mappedSize > 0) mapped = file.map(0, mappedSize);
+	if (mapped == Q_NULLPTR) {
+		buffer = file.readAll();
+		mappedSize = buffer.size();
+		if (mappedSize > 0) mapped = (const uchar *) buffer.constData();
 	}
-	fp = fopen(fname, "rb");
-	if (fp) mdaData = mda_load(fp);
-	PRINT(printf("mdaReaderThread: read '%s'\n", fname));
+	return (mappedSize > 0);
+}
+
+void mdaReader::unmap()
+{
+	if (mapped != Q_NULLPTR && mapped != (const uchar *) buffer.constData()) file.unmap((uchar *) mapped);
+	if (file.isOpen()) file.close();
+	buffer.clear();
+	mapped = Q_NULLPTR;
+	mappedSize = 0;
+}
+
+void mdaReader::unload()
+{
+	unmap();
+	rows.clear();
+	valid = false;
+	topName.clear();
+	topRank = 0;
+	topLastPoint = 0;
 }
@@ -2,7 +2,57 @@
 #define mdaReader_H
 
 #include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QFile>
 
 void mdaReader_RegisterPV(QString pvName);
-int mdaReader_gimmeYerData(QString QS_dataFile, QString QS_pvName, float *data, int nx, int ny, int y_cpt);
+
+/**
+ * where a sub-scan (row) of a mda file keeps its detector columns, found without decoding the row
+ */
+struct mdaRowIndex {
+    qint64 offset;                // file offset of the sub-scan
+    int requestedPoints;
+    int lastPoint;
+    QVector<qint16> detectors;    // detector numbers in the order of the columns
+    qint64 detectorsData;         // file offset of the first detector column
+};
+
+/**
+ * follows the mda file of a running scan: only an index of the sub-scans and their detector columns is built;
+ * the column of the requested detector is decoded when asked for. on a new row only the rows appended to the file
+ * are indexed. the file is mapped into memory only while the data are read, the IOC rewrites it for a new scan.
+ * every caScan2D has its own reader.
+ */
+class mdaReader
+{
+public:
+    mdaReader();
+    ~mdaReader();
+
+    int gimmeYerData(QString QS_dataFile, QString QS_pvName, float *data, int nx, int ny, int y_cpt);
+    int rowCount() const { return rows.size(); }
+
+private:
+    int readColumn(int row, int detNum, float *data, int n);
+    bool load(const QString &dataFile, int y_cpt);
+    bool map(const QString &fileName);
+    void unmap();
+    void unload();
+
+    QString savedDataFile;
+    int savedYcpt;
+    QFile file;
+    QByteArray buffer;            // file contents when the file could not be mapped
+    const uchar *mapped;
+    qint64 mappedSize;
+
+    bool valid;                   // outer scan could be read
+    QByteArray topName;
+    int topRank;
+    int topLastPoint;
+    QVector<mdaRowIndex> rows;    // indexed sub-scans
+};
+
 #endif
@@ -43,6 +43,7 @@ public:
 
     QwtPlotCurveNaN(const QString &title = Q_NULLPTR );
     void setSamplesList(const QVector<QPointF>& Samples);
+    const QVector<QPointF>& samplesList() const {return samples;}
     void getLimits(double &ymin, double &ymax);
     void setInterval(curvType type, double interval);
 
@@ -65,6 +66,7 @@ public:
 
     QwtPlotIntervalCurveNaN(const QString &title = Q_NULLPTR );
     void setSamplesList(const QVector<QwtIntervalSample>& Samples);
+    const QVector<QwtIntervalSample>& samplesList() const {return samples;}
     void getLimits(double &ymin, double &ymax);
     void setInterval(curvType type, double interval);
 
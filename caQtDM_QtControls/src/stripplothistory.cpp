@@ -0,0 +1,421 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include <math.h>
+#include "stripplothistory.h"
+
+double stripplotmapping::map(double raw) const
+{
+    double value;
+    if(log) raw = qMax(raw, 1e-20);
+    if(identity) return raw;
+
+    if(log) {
+        value = toMin * pow(toMax / toMin, log10(raw / fromMin) / log10(fromMax / fromMin));
+        return qMax(value, 1e-20);
+    }
+    value = (toMax - toMin) / (fromMax - fromMin) * (raw - fromMin) + toMin;
+    return value;
+}
+
+bool stripplotmapping::same(const stripplotmapping &other) const
+{
+    return log == other.log && identity == other.identity && fromMin == other.fromMin && fromMax == other.fromMax &&
+           toMin == other.toMin && toMax == other.toMax;
+}
+
+stripplothistory::stripplothistory()
+{
+    useFloat = false;
+    curves = 0;
+    capacity = 0;
+    head = -1;
+    count = 0;
+    pushed = 0;
+    changes = 0;
+}
+
+/**
+ * empty history, the columns are only allocated while data comes in
+ */
+void stripplothistory::reset(int nbCurves, int maxSize, bool singlePrecision)
+{
+    useFloat = singlePrecision;
+    curves = nbCurves;
+    capacity = qMax(maxSize, 1);
+    head = -1;
+    count = 0;
+    changes++;
+
+    times.clear();
+    minDouble.clear();
+    maxDouble.clear();
+    minFloat.clear();
+    maxFloat.clear();
+    if(useFloat) {
+        minFloat.resize(curves);
+        maxFloat.resize(curves);
+    } else {
+        minDouble.resize(curves);
+        maxDouble.resize(curves);
+    }
+}
+
+/**
+ * change the number of samples kept, the newest ones are kept and the columns are laid out again
+ */
+void stripplothistory::setCapacity(int maxSize)
+{
+    maxSize = qMax(maxSize, 1);
+    if(maxSize == capacity) return;
+
+    int n = qMin(count, maxSize);
+    QVector<double> newTimes(n);
+    for(int i = 0; i < n; i++) newTimes[n - 1 - i] = times.at(physical(i));
+
+    for(int c = 0; c < curves; c++) {
+        if(useFloat) {
+            QVector<float> newMin(n), newMax(n);
+            for(int i = 0; i < n; i++) {
+                newMin[n - 1 - i] = minFloat.at(c).at(physical(i));
+                newMax[n - 1 - i] = maxFloat.at(c).at(physical(i));
+            }
+            minFloat[c] = newMin;
+            maxFloat[c] = newMax;
+        } else {
+            QVector<double> newMin(n), newMax(n);
+            for(int i = 0; i < n; i++) {
+                newMin[n - 1 - i] = minDouble.at(c).at(physical(i));
+                newMax[n - 1 - i] = maxDouble.at(c).at(physical(i));
+            }
+            minDouble[c] = newMin;
+            maxDouble[c] = newMax;
+        }
+    }
+
+    times = newTimes;
+    capacity = maxSize;
+    count = n;
+    head = n - 1;
+    changes++;
+}
+
+/**
+ * new sample in front, the values are undefined until set; when full the oldest sample is overwritten
+ */
+void stripplothistory::push(double time)
+{
+    if(times.size() < capacity) {
+        times.append(time);
+        for(int c = 0; c < curves; c++) {
+            if(useFloat) {
+                minFloat[c].append(NAN);
+                maxFloat[c].append(NAN);
+            } else {
+                minDouble[c].append(NAN);
+                maxDouble[c].append(NAN);
+            }
+        }
+        head = times.size() - 1;
+    } else {
+        head = (head + 1) % times.size();
+        times[head] = time;
+        for(int c = 0; c < curves; c++) {
+            if(useFloat) {
+                minFloat[c][head] = NAN;
+                maxFloat[c][head] = NAN;
+            } else {
+                minDouble[c][head] = NAN;
+                maxDouble[c][head] = NAN;
+            }
+        }
+    }
+    if(count < times.size()) count++;
+    pushed++;
+}
+
+void stripplothistory::setNewest(int curve, double minValue, double maxValue)
+{
+    if(count < 1 || curve < 0 || curve >= curves) return;
+    if(useFloat) {
+        minFloat[curve][head] = (float) minValue;
+        maxFloat[curve][head] = (float) maxValue;
+    } else {
+        minDouble[curve][head] = minValue;
+        maxDouble[curve][head] = maxValue;
+    }
+}
+
+double stripplothistory::minValue(int curve, int i) const
+{
+    if(useFloat) return (double) minFloat.at(curve).at(physical(i));
+    return minDouble.at(curve).at(physical(i));
+}
+
+double stripplothistory::maxValue(int curve, int i) const
+{
+    if(useFloat) return (double) maxFloat.at(curve).at(physical(i));
+    return maxDouble.at(curve).at(physical(i));
+}
+
+/**
+ * samples of a curve as needed by the plot items, newest first and terminated by an undefined sample;
+ * with relative set the time is given relative to the newest sample (value scale). When the samples
+ * derived the last time are given with what they were derived from, only the samples pushed since then
+ * and the newest one (still changing) are mapped, the values of the others are taken over
+ */
+void stripplothistory::samples(int curve, const stripplotmapping &mapping, bool relative,
+                               QVector<QwtIntervalSample> &range, QVector<QPointF> *fill,
+                               stripplotderived *derived, const QVector<QwtIntervalSample> *previous) const
+{
+    int n = (curve < 0 || curve >= curves) ? 0 : count;
+    range.resize(n + 1);
+    if(fill != (QVector<QPointF> *) 0) fill->resize(n + 1);
+
+    // the samples derived before moved back by the number of samples pushed since
+    int moved = -1, reusable = 0;
+    if(derived != (stripplotderived *) 0 && previous != (const QVector<QwtIntervalSample> *) 0 &&
+       derived->changes == changes && derived->pushed <= pushed && derived->relative == relative && derived->mapping.same(mapping)) {
+        moved = (int) qMin((qint64) n, pushed - derived->pushed);
+        reusable = previous->size() - 1;
+    }
+    int fresh = (moved < 0) ? n : moved + 1;
+
+    double offset = (relative && n > 0) ? time(0) : 0.0;
+    for(int i = 0; i < n; i++) {
+        double x = time(i) - offset;
+        double yMin, yMax;
+        if(i >= fresh && i - moved < reusable) {
+            const QwtInterval &interval = previous->at(i - moved).interval;
+            yMin = interval.minValue();
+            yMax = interval.maxValue();
+        } else {
+            yMin = mapping.map(minValue(curve, i));
+            yMax = mapping.map(maxValue(curve, i));
+        }
+        range[i] = QwtIntervalSample(x, QwtInterval(yMin, yMax));
+        if(fill != (QVector<QPointF> *) 0) (*fill)[i] = QPointF(x, (yMin + yMax) / 2);
+    }
+
+    if(derived != (stripplotderived *) 0) {
+        derived->pushed = pushed;
+        derived->changes = changes;
+        derived->relative = relative;
+        derived->mapping = mapping;
+    }
+    range[n] = QwtIntervalSample(0, QwtInterval(NAN, NAN));
+    if(fill != (QVector<QPointF> *) 0) (*fill)[n] = QPointF(NAN, NAN);
+}
+
+/**
+ * displayed minimum and maximum of the newest n samples, used for the autoscale
+ */
+void stripplothistory::displayRange(int curve, int n, const stripplotmapping &mapping, double &minY, double &maxY) const
+{
+    if(curve < 0 || curve >= curves) return;
+    n = qMin(n, count);
+    for(int i = 0; i < n; i++) {
+        double yMin = mapping.map(minValue(curve, i));
+        double yMax = mapping.map(maxValue(curve, i));
+        if(!qIsNaN(yMax) && yMax > maxY) maxY = yMax;
+        if(!qIsNaN(yMin) && yMin < minY) minY = yMin;
+    }
+}
+
+/**
+ * index of the sample whose time is the last one not later than the given time, -1 when older than all
+ */
+int stripplothistory::find(double t) const
+{
+    int lo = 0, hi = count - 1, found = -1;
+    while(lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if(time(mid) <= t) {
+            found = mid;
+            hi = mid - 1;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return found;
+}
+
+/**
+ * add a minimum and maximum into an existing sample
+ */
+void stripplothistory::merge(int curve, int i, double minValue, double maxValue)
+{
+    if(curve < 0 || curve >= curves || i < 0 || i >= count) return;
+    double oldMin = this->minValue(curve, i);
+    double oldMax = this->maxValue(curve, i);
+    if(!qIsNaN(oldMin) && oldMin < minValue) minValue = oldMin;
+    if(!qIsNaN(oldMax) && oldMax > maxValue) maxValue = oldMax;
+    int p = physical(i);
+    if(useFloat) {
+        minFloat[curve][p] = (float) minValue;
+        maxFloat[curve][p] = (float) maxValue;
+    } else {
+        minDouble[curve][p] = minValue;
+        maxDouble[curve][p] = maxValue;
+    }
+    changes++;
+}
+
+qint64 stripplothistory::memoryUsed() const
+{
+    qint64 bytes = (qint64) times.capacity() * sizeof(double);
+    for(int c = 0; c < minDouble.size(); c++) bytes += (qint64) (minDouble.at(c).capacity() + maxDouble.at(c).capacity()) * sizeof(double);
+    for(int c = 0; c < minFloat.size(); c++) bytes += (qint64) (minFloat.at(c).capacity() + maxFloat.at(c).capacity()) * sizeof(float);
+    return bytes;
+}
+
+stripplotpyramid::stripplotpyramid()
+{
+    reset(0);
+}
+
+void stripplotpyramid::reset(int nbCurves)
+{
+    curves = nbCurves;
+    double width = 0.1;
+    for(int l = 0; l < PYRAMID_LEVELS; l++) {
+        levels[l].width = width;
+        levels[l].head = -1;
+        levels[l].count = 0;
+        levels[l].times.clear();
+        levels[l].minValues.clear();
+        levels[l].maxValues.clear();
+        levels[l].minValues.resize(curves);
+        levels[l].maxValues.resize(curves);
+        width *= 4.0;
+    }
+}
+
+/**
+ * merge the minimum and maximum of all curves at the given time (seconds) into every level,
+ * undefined values (nan or minimum above maximum) are skipped
+ */
+void stripplotpyramid::add(double time, const double *minValues, const double *maxValues)
+{
+    for(int l = 0; l < PYRAMID_LEVELS; l++) {
+        level &lev = levels[l];
+        double bin = floor(time / lev.width) * lev.width;
+
+        if(lev.count == 0 || bin > lev.times.at(lev.head)) {
+            if(lev.times.size() < PYRAMID_BINS) {
+                lev.times.append(bin);
+                for(int c = 0; c < curves; c++) {
+                    lev.minValues[c].append(NAN);
+                    lev.maxValues[c].append(NAN);
+                }
+                lev.head = lev.times.size() - 1;
+            } else {
+                lev.head = (lev.head + 1) % lev.times.size();
+                lev.times[lev.head] = bin;
+                for(int c = 0; c < curves; c++) {
+                    lev.minValues[c][lev.head] = NAN;
+                    lev.maxValues[c][lev.head] = NAN;
+                }
+            }
+            if(lev.count < lev.times.size()) lev.count++;
+        }
+
+        for(int c = 0; c < curves; c++) {
+            if(qIsNaN(minValues[c]) || qIsNaN(maxValues[c]) || minValues[c] > maxValues[c]) continue;
+            double &binMin = lev.minValues[c][lev.head];
+            double &binMax = lev.maxValues[c][lev.head];
+            if(qIsNaN(binMin) || minValues[c] < binMin) binMin = minValues[c];
+            if(qIsNaN(binMax) || maxValues[c] > binMax) binMax = maxValues[c];
+        }
+    }
+}
+
+/**
+ * minimum and maximum of a curve between from and to (seconds), taken from the widest level whose bins
+ * still fit into the span, or from a wider one when that level does not reach back far enough
+ */
+bool stripplotpyramid::range(int curve, double from, double to, double &minY, double &maxY) const
+{
+    if(curve < 0 || curve >= curves) return false;
+
+    int first = 0;
+    for(int l = 0; l < PYRAMID_LEVELS; l++) {
+        if(levels[l].width <= (to - from)) first = l;
+    }
+
+    for(int l = first; l < PYRAMID_LEVELS; l++) {
+        const level &lev = levels[l];
+        if(lev.count == 0) return false;
+        if(lev.times.at(lev.physical(0)) > from && l < PYRAMID_LEVELS - 1) continue;
+
+        // binary search for the first bin ending after from, the bins are in ascending order
+        int lo = 0, hi = lev.count - 1, k = lev.count;
+        while(lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if(lev.times.at(lev.physical(mid)) + lev.width > from) {
+                k = mid;
+                hi = mid - 1;
+            } else {
+                lo = mid + 1;
+            }
+        }
+
+        bool found = false;
+        for(; k < lev.count; k++) {
+            int p = lev.physical(k);
+            if(lev.times.at(p) >= to) break;
+            double binMin = lev.minValues.at(curve).at(p);
+            double binMax = lev.maxValues.at(curve).at(p);
+            if(qIsNaN(binMin) || qIsNaN(binMax)) continue;
+            if(!found || binMin < minY) minY = binMin;
+            if(!found || binMax > maxY) maxY = binMax;
+            found = true;
+        }
+        return found;
+    }
+    return false;
+}
+
+/**
+ * start of the oldest bin still kept, on the widest level
+ */
+double stripplotpyramid::oldestTime() const
+{
+    const level &lev = levels[PYRAMID_LEVELS - 1];
+    if(lev.count == 0) return INFINITY;
+    return lev.times.at(lev.physical(0));
+}
+
+qint64 stripplotpyramid::memoryUsed() const
+{
+    qint64 bytes = 0;
+    for(int l = 0; l < PYRAMID_LEVELS; l++) {
+        bytes += (qint64) levels[l].times.capacity() * sizeof(double);
+        for(int c = 0; c < levels[l].minValues.size(); c++) {
+            bytes += (qint64) (levels[l].minValues.at(c).capacity() + levels[l].maxValues.at(c).capacity()) * sizeof(double);
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,137 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef stripplothistory_H
+#define stripplothistory_H
+
+#include <QVector>
+#include <QPointF>
+#include <qwt_samples.h>
+#include <qtcontrols_global.h>
+
+/**
+ * conversion of the raw values of a curve to the values displayed, linear or logarithmic
+ * from the limits of the curve to the limits of the axis
+ */
+struct stripplotmapping {
+    stripplotmapping() : fromMin(0.0), fromMax(1.0), toMin(0.0), toMax(1.0), log(false), identity(true) {}
+
+    double map(double raw) const;
+    bool same(const stripplotmapping &other) const;
+
+    double fromMin, fromMax, toMin, toMax;
+    bool log, identity;
+};
+
+/**
+ * what the samples of a curve were derived from the last time, so that only the new ones have to be mapped
+ */
+struct stripplotderived {
+    stripplotderived() : pushed(-1), changes(-1), relative(false) {}
+
+    qint64 pushed, changes;
+    stripplotmapping mapping;
+    bool relative;
+};
+
+/**
+ * history of a strip chart, stored by column: one time column shared by all curves and a minimum
+ * and maximum column per curve holding the raw values, optionally as float. The ring grows with
+ * the data kept, index 0 is always the newest sample. The curve samples are derived on demand.
+ */
+class QTCON_EXPORT stripplothistory
+{
+public:
+    stripplothistory();
+
+    void reset(int nbCurves, int maxSize, bool singlePrecision);
+    void setCapacity(int maxSize);
+    void push(double time);
+    void setNewest(int curve, double minValue, double maxValue);
+    void setNewestTime(double time) {if(count > 0) times[head] = time;}
+
+    int size() const {return count;}
+    double time(int i) const {return times.at(physical(i));}
+    double minValue(int curve, int i) const;
+    double maxValue(int curve, int i) const;
+
+    void samples(int curve, const stripplotmapping &mapping, bool relative,
+                 QVector<QwtIntervalSample> &range, QVector<QPointF> *fill,
+                 stripplotderived *derived = 0, const QVector<QwtIntervalSample> *previous = 0) const;
+    void displayRange(int curve, int n, const stripplotmapping &mapping, double &minY, double &maxY) const;
+    int find(double time) const;
+    void merge(int curve, int i, double minValue, double maxValue);
+    qint64 memoryUsed() const;
+
+private:
+    inline int physical(int i) const {int p = head - i; return (p < 0) ? p + times.size() : p;}
+
+    QVector<double> times;
+    QVector< QVector<double> > minDouble, maxDouble;
+    QVector< QVector<float> > minFloat, maxFloat;
+    bool useFloat;
+    int curves;
+    int capacity;
+    int head;
+    int count;
+    // number of samples pushed and of changes of older samples or of the layout, both only increase
+    qint64 pushed;
+    qint64 changes;
+};
+
+/**
+ * minimum and maximum of everything seen since the display was opened, kept on several levels of
+ * bins (0.1 s and then always 4 times wider), every level is a ring of at most PYRAMID_BINS bins;
+ * used to fill the history again when the period of the chart changes
+ */
+#define PYRAMID_LEVELS 8
+#define PYRAMID_BINS 1024
+
+class QTCON_EXPORT stripplotpyramid
+{
+public:
+    stripplotpyramid();
+
+    void reset(int nbCurves);
+    void add(double time, const double *minValues, const double *maxValues);
+    bool range(int curve, double from, double to, double &minY, double &maxY) const;
+    double oldestTime() const;
+    qint64 memoryUsed() const;
+
+private:
+    struct level {
+        double width;
+        int head;
+        int count;
+        QVector<double> times;
+        QVector< QVector<double> > minValues, maxValues;
+        int physical(int k) const {int p = head - (count - 1) + k; return (p < 0) ? p + times.size() : p;}
+    };
+
+    int curves;
+    level levels[PYRAMID_LEVELS];
+};
+
+#endif // stripplothistory_H
@@ -0,0 +1,306 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include <QPainter>
+#include <QElapsedTimer>
+#include <string.h>
+#include <math.h>
+#include "stripplotrenderer.h"
+
+// columns redrawn on the right side in addition to the scrolled ones, the newest sample still changes
+#define INCREMENTAL_MARGIN 3
+
+stripplotpainter::stripplotpainter()
+{
+    cacheXMin = 0.0;
+    fillItem.setPaintAttribute(QwtPlotCurve::ClipPolygons, true);
+    rangeItem.setPaintAttribute(QwtPlotIntervalCurve::ClipPolygons, true);
+}
+
+/**
+ * the grid is drawn every time (a fixed tick scale does not scroll with the data), then the curves
+ */
+void stripplotpainter::paint(QPainter *painter, const stripRenderJob &job)
+{
+    QRectF canvasRect(job.canvasRect);
+
+    if(job.grid) {
+        gridItem.setPen(job.gridPen);
+        gridItem.updateScaleDiv(job.xDiv, job.yDiv);
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing, false);
+        gridItem.draw(painter, job.xMap, job.yMap, canvasRect);
+        painter->restore();
+    }
+
+    if(!job.incremental) {
+        cache = QImage();
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing, true);
+        drawCurves(painter, job, job.xMap, canvasRect, -INFINITY);
+        painter->restore();
+        return;
+    }
+
+    updateCache(job);
+    if(!cache.isNull()) painter->drawImage(job.canvasRect.topLeft(), cache);
+}
+
+/**
+ * same order as on the plot: fill curves (z=i) and then the min/max curves (z=i+10); when fromX is given,
+ * only the newest samples down to fromX are handed to the curves (the newest sample is the first one)
+ */
+void stripplotpainter::drawCurves(QPainter *painter, const stripRenderJob &job, const QwtScaleMap &xMap, const QRectF &rect, double fromX)
+{
+    fillItem.setInterval(job.type, job.interval);
+    for(int c = 0; c < job.curves.size(); c++) {
+        const stripRenderCurve &curve = job.curves.at(c);
+        if(!curve.visible || !curve.fill) continue;
+        int count = curve.fillData.size();
+        if(fromX > -INFINITY) {
+            for(count = 0; count < curve.fillData.size(); count++) {
+                if(curve.fillData.at(count).x() < fromX) break;
+            }
+            count = qMin(count + 2, curve.fillData.size());
+        }
+        QVector<QPointF> samples = (count == curve.fillData.size()) ? curve.fillData : curve.fillData.mid(0, count);
+        fillItem.setPen(curve.fillPen);
+        fillItem.setBrush(curve.fillBrush);
+        fillItem.setSamplesList(samples);
+        fillItem.setSamples(samples);
+        fillItem.draw(painter, xMap, job.yMap, rect);
+    }
+    // the items must not keep the samples, the plot writes into this buffer again two updates later
+    fillItem.setSamplesList(QVector<QPointF>());
+    fillItem.setSamples(QVector<QPointF>());
+
+    rangeItem.setInterval(job.type, job.interval);
+    for(int c = 0; c < job.curves.size(); c++) {
+        const stripRenderCurve &curve = job.curves.at(c);
+        if(!curve.visible) continue;
+        int count = curve.rangeData.size();
+        if(fromX > -INFINITY) {
+            for(count = 0; count < curve.rangeData.size(); count++) {
+                if(curve.rangeData.at(count).value < fromX) break;
+            }
+            count = qMin(count + 2, curve.rangeData.size());
+        }
+        QVector<QwtIntervalSample> samples = (count == curve.rangeData.size()) ? curve.rangeData : curve.rangeData.mid(0, count);
+        rangeItem.setPen(curve.rangePen);
+        rangeItem.setBrush(curve.rangeBrush);
+        rangeItem.setSamplesList(samples);
+        rangeItem.setSamples(samples);
+        rangeItem.draw(painter, xMap, job.yMap, rect);
+    }
+    rangeItem.setSamplesList(QVector<QwtIntervalSample>());
+    rangeItem.setSamples(QVector<QwtIntervalSample>());
+}
+
+/**
+ * a full redraw is needed when anything but the time moved on
+ */
+bool stripplotpainter::sameLayout(const stripRenderJob &job) const
+{
+    if(cache.isNull() || cache.size() != job.canvasRect.size()) return false;
+    if(job.canvasRect.topLeft() != cacheJob.canvasRect.topLeft()) return false;
+    if(job.yType != cacheJob.yType || job.type != cacheJob.type || job.interval != cacheJob.interval) return false;
+    if(job.yMap.s1() != cacheJob.yMap.s1() || job.yMap.s2() != cacheJob.yMap.s2()) return false;
+    if(job.yMap.p1() != cacheJob.yMap.p1() || job.yMap.p2() != cacheJob.yMap.p2()) return false;
+    if(job.xMap.p1() != cacheJob.xMap.p1() || job.xMap.p2() != cacheJob.xMap.p2()) return false;
+    if(qAbs((job.xMap.s2() - job.xMap.s1()) - (cacheJob.xMap.s2() - cacheJob.xMap.s1())) > 1.e-9) return false;
+    if(job.xMap.s1() < cacheXMin) return false;
+    if(job.curves.size() != cacheJob.curves.size()) return false;
+    for(int c = 0; c < job.curves.size(); c++) {
+        const stripRenderCurve &a = job.curves.at(c);
+        const stripRenderCurve &b = cacheJob.curves.at(c);
+        if(a.visible != b.visible || a.fill != b.fill) return false;
+        if(a.rangePen != b.rangePen || a.rangeBrush != b.rangeBrush) return false;
+        if(a.fillPen != b.fillPen || a.fillBrush != b.fillBrush) return false;
+    }
+    return true;
+}
+
+void stripplotpainter::updateCache(const stripRenderJob &job)
+{
+    int width = job.canvasRect.width();
+    int height = job.canvasRect.height();
+    double span = job.xMap.s2() - job.xMap.s1();
+    if(width < 1 || height < 1 || span <= 0.0) {
+        cache = QImage();
+        return;
+    }
+    double pixelsPerUnit = (double) width / span;
+
+    QwtScaleMap xMap = job.xMap;
+    QRectF stripRect(job.canvasRect);
+    double fromX = -INFINITY;
+    int shift = 0;
+
+    if(sameLayout(job)) {
+        // scroll by whole pixels only, the image then stays aligned to its own time base
+        shift = (int) floor((job.xMap.s1() - cacheXMin) * pixelsPerUnit);
+        if(shift >= width - INCREMENTAL_MARGIN) shift = -1;
+    } else {
+        shift = -1;
+    }
+
+    if(shift < 0) {
+        cache = QImage(job.canvasRect.size(), QImage::Format_ARGB32_Premultiplied);
+        cache.fill(0);
+        cacheXMin = job.xMap.s1();
+    } else {
+        cacheXMin += (double) shift / pixelsPerUnit;
+        if(shift > 0) {
+            for(int y = 0; y < height; y++) {
+                uchar *line = cache.scanLine(y);
+                memmove(line, line + shift * 4, (width - shift) * 4);
+            }
+        }
+        int stripWidth = qMin(width, shift + INCREMENTAL_MARGIN);
+        stripRect = QRectF(job.canvasRect.right() + 1 - stripWidth, job.canvasRect.top(), stripWidth, height);
+        fromX = cacheXMin + (double) (width - stripWidth) / pixelsPerUnit;
+    }
+    xMap.setScaleInterval(cacheXMin, cacheXMin + span);
+
+    QPainter painter(&cache);
+    painter.translate(-job.canvasRect.topLeft());
+    if(shift >= 0) {
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.fillRect(stripRect, Qt::transparent);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter.setClipRect(stripRect);
+    }
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    drawCurves(&painter, job, xMap, QRectF(job.canvasRect), fromX);
+    painter.end();
+
+    cacheJob = job;
+    for(int c = 0; c < cacheJob.curves.size(); c++) {
+        cacheJob.curves[c].rangeData.clear();
+        cacheJob.curves[c].fillData.clear();
+    }
+}
+
+stripplotrenderer::stripplotrenderer(QObject *parent) : QThread(parent)
+{
+    hasJob = false;
+    invalidateRequested = false;
+    stopRequested = false;
+    renderFrames = 0;
+    renderNs = 0;
+}
+
+stripplotrenderer::~stripplotrenderer()
+{
+    stop();
+    wait();
+}
+
+void stripplotrenderer::render(const stripRenderJob &job)
+{
+    QMutexLocker locker(&lock);
+    pending = job;
+    hasJob = true;
+    wakeup.wakeOne();
+}
+
+/**
+ * the next job is drawn completely, its painter lives in the render thread
+ */
+void stripplotrenderer::invalidate()
+{
+    QMutexLocker locker(&lock);
+    invalidateRequested = true;
+}
+
+QImage stripplotrenderer::frame()
+{
+    QMutexLocker locker(&lock);
+    return finished;
+}
+
+void stripplotrenderer::stop()
+{
+    QMutexLocker locker(&lock);
+    stopRequested = true;
+    wakeup.wakeOne();
+}
+
+void stripplotrenderer::getRenderTime(int &frames, double &renderUs)
+{
+    QMutexLocker locker(&lock);
+    frames = renderFrames;
+    renderUs = (double) renderNs / 1000.0;
+}
+
+void stripplotrenderer::resetRenderTime()
+{
+    QMutexLocker locker(&lock);
+    renderFrames = 0;
+    renderNs = 0;
+}
+
+void stripplotrenderer::run()
+{
+    // the painter and its plot items belong to this thread only
+    stripplotpainter painterItems;
+
+    forever {
+        stripRenderJob job;
+
+        lock.lock();
+        while(!hasJob && !stopRequested) wakeup.wait(&lock);
+        if(stopRequested) {
+            lock.unlock();
+            break;
+        }
+        job = pending;
+        pending = stripRenderJob();
+        hasJob = false;
+        if(invalidateRequested) painterItems.invalidate();
+        invalidateRequested = false;
+        lock.unlock();
+
+        if(job.canvasRect.width() < 1 || job.canvasRect.height() < 1) continue;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        QImage image(job.canvasRect.size(), QImage::Format_ARGB32_Premultiplied);
+        image.fill(0);
+        QPainter painter(&image);
+        painter.translate(-job.canvasRect.topLeft());
+        painterItems.paint(&painter, job);
+        painter.end();
+
+        lock.lock();
+        finished = image;
+        renderFrames++;
+        renderNs += timer.nsecsElapsed();
+        lock.unlock();
+
+        emit frameReady();
+    }
+}
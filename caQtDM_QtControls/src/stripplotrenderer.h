@@ -0,0 +1,137 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef stripplotrenderer_H
+#define stripplotrenderer_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QImage>
+#include <QVector>
+#include <QPen>
+#include <QBrush>
+#include <qwt_scale_map.h>
+#include <qwt_scale_div.h>
+#include <qwt_samples.h>
+
+#include <qtcontrols_global.h>
+#include <qwt_plot_grid.h>
+#include "qwtplotcurvenan.h"
+
+class QPainter;
+
+/**
+ * everything needed to draw the canvas of a strip chart, the sample vectors are implicitly shared
+ * with the plot items, so taking a snapshot in the gui thread costs nothing; the plot double buffers
+ * them, so that the next update does not have to detach a vector still used here
+ */
+struct stripRenderCurve {
+    bool visible;
+    bool fill;
+    QPen rangePen, fillPen;
+    QBrush rangeBrush, fillBrush;
+    QVector<QwtIntervalSample> rangeData;
+    QVector<QPointF> fillData;
+};
+
+struct stripRenderJob {
+    QRect canvasRect;
+    QwtScaleMap xMap, yMap;
+    int yType;
+    curvType type;
+    double interval;
+    bool incremental;
+    bool grid;
+    QPen gridPen;
+    QwtScaleDiv xDiv, yDiv;
+    QVector<stripRenderCurve> curves;
+};
+
+/**
+ * draws the canvas of a strip chart; in incremental mode the curves are kept in an image that is
+ * scrolled by the elapsed pixels, only the new columns are drawn and a full redraw is done when
+ * the size, the scales or the curve attributes change
+ */
+class QTCON_EXPORT stripplotpainter
+{
+public:
+    stripplotpainter();
+
+    void paint(QPainter *painter, const stripRenderJob &job);
+    void invalidate() {cache = QImage();}
+
+private:
+    void drawCurves(QPainter *painter, const stripRenderJob &job, const QwtScaleMap &xMap, const QRectF &rect, double fromX);
+    void updateCache(const stripRenderJob &job);
+    bool sameLayout(const stripRenderJob &job) const;
+
+    QwtPlotCurveNaN fillItem;
+    QwtPlotIntervalCurveNaN rangeItem;
+    QwtPlotGrid gridItem;
+
+    QImage cache;
+    double cacheXMin;
+    stripRenderJob cacheJob;
+};
+
+/**
+ * renders the curves of a strip chart into an offscreen image, the gui thread only blits the finished frame;
+ * a job arriving while the thread is still busy replaces the one waiting
+ */
+class QTCON_EXPORT stripplotrenderer : public QThread
+{
+    Q_OBJECT
+
+public:
+    stripplotrenderer(QObject *parent=0);
+    ~stripplotrenderer();
+
+    void render(const stripRenderJob &job);
+    void invalidate();
+    QImage frame();
+    void stop();
+    void getRenderTime(int &frames, double &renderUs);
+    void resetRenderTime();
+
+protected:
+    virtual void run();
+
+signals:
+    void frameReady();
+
+private:
+    QMutex lock;
+    QWaitCondition wakeup;
+    stripRenderJob pending;
+    bool hasJob;
+    bool invalidateRequested;
+    bool stopRequested;
+    QImage finished;
+    int renderFrames;
+    qint64 renderNs;
+};
+
+#endif // stripplotrenderer_H
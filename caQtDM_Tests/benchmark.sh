@@ -0,0 +1,26 @@
+#!/bin/sh
+# measures loading, connecting, first paint and updates of a display without a screen
+#   benchmark.sh [display.ui] [seconds] [results.json]
+# a local soft ioc is started with st.cmd (mySimulation.db) when softIoc is found
+
+DISPLAY_FILE=${1:-speedTest.ui}
+SECONDS_RUN=${2:-30}
+RESULTS=${3:-`basename $DISPLAY_FILE .ui`-benchmark.json}
+
+IOC_PID=""
+if which softIoc > /dev/null 2>&1; then
+   softIoc st.cmd < /dev/null > /dev/null 2>&1 &
+   IOC_PID=$!
+   sleep 2
+fi
+
+export EPICS_CA_AUTO_ADDR_LIST=NO
+export EPICS_CA_ADDR_LIST=localhost
+export CAQTDM_DISPLAY_PATH=`pwd`
+
+caQtDM -platform offscreen -noMsg -benchmark $SECONDS_RUN -benchmarkfile $RESULTS $DISPLAY_FILE
+
+if [ -n "$IOC_PID" ]; then
+   kill $IOC_PID
+fi
+cat $RESULTS
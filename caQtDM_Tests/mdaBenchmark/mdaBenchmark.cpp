@@ -0,0 +1,241 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <QString>
+#include <QVector>
+#include <QElapsedTimer>
+#include "mda-load.h"
+#include "mdaReader.h"
+
+/**
+ * writes the xdr encoding of mda_loader.c
+ */
+static void putInt32(FILE *fp, qint32 value)
+{
+    unsigned char b[4] = {(unsigned char) (value >> 24), (unsigned char) (value >> 16), (unsigned char) (value >> 8), (unsigned char) value};
+    fwrite(b, 1, 4, fp);
+}
+
+static void putFloat(FILE *fp, float value)
+{
+    qint32 bits;
+    memcpy(&bits, &value, 4);
+    putInt32(fp, bits);
+}
+
+static void putDouble(FILE *fp, double value)
+{
+    qint64 bits;
+    memcpy(&bits, &value, 8);
+    putInt32(fp, (qint32) (bits >> 32));
+    putInt32(fp, (qint32) bits);
+}
+
+static void putString(FILE *fp, const char *text)
+{
+    qint32 length = (qint32) strlen(text);
+    putInt32(fp, length);
+    if (length == 0) return;
+    putInt32(fp, length);
+    fwrite(text, 1, length, fp);
+    for (int i = length; i % 4; i++) fputc(0, fp);
+}
+
+/**
+ * writes one scan; the sub-scan offsets of the outer scan are written again once known
+ */
+static void putScan(FILE *fp, int rank, int points, int detectors, int row)
+{
+    char text[40];
+    putInt32(fp, rank);
+    putInt32(fp, points);
+    putInt32(fp, points);
+    if (rank > 1) for (int i = 0; i < points; i++) putInt32(fp, 0);
+    putString(fp, rank > 1 ? "bench:scan2" : "bench:scan1");
+    putString(fp, "JAN 01, 2020 00:00:00.000000000");
+    putInt32(fp, 1);
+    putInt32(fp, rank > 1 ? 0 : detectors);
+    putInt32(fp, 0);
+
+    putInt32(fp, 0);
+    putString(fp, rank > 1 ? "bench:m2" : "bench:m1");
+    putString(fp, "motor");
+    putString(fp, "LINEAR");
+    putString(fp, "mm");
+    putString(fp, rank > 1 ? "bench:m2.RBV" : "bench:m1.RBV");
+    putString(fp, "readback");
+    putString(fp, "mm");
+    if (rank == 1) {
+        for (int d = 0; d < detectors; d++) {
+            putInt32(fp, d);
+            sprintf(text, "bench:det%d", d + 1);
+            putString(fp, text);
+            putString(fp, "detector");
+            putString(fp, "counts");
+        }
+    }
+    for (int i = 0; i < points; i++) putDouble(fp, i * 0.1);
+    if (rank == 1) {
+        for (int d = 0; d < detectors; d++) {
+            for (int i = 0; i < points; i++) putFloat(fp, (float) (row * 1000 + d * 10 + i));
+        }
+    }
+}
+
+static bool generate(const char *fileName, int rows, int points, int detectors)
+{
+    FILE *fp = fopen(fileName, "wb");
+    if (fp == NULL) return false;
+
+    putFloat(fp, 1.3f);
+    putInt32(fp, 1);
+    putInt32(fp, 2);
+    putInt32(fp, rows);
+    putInt32(fp, points);
+    putInt32(fp, 1);
+    putInt32(fp, 0);
+    long top = ftell(fp);
+    putScan(fp, 2, rows, detectors, 0);
+
+    QVector<qint32> offsets(rows);
+    for (int i = 0; i < rows; i++) {
+        offsets[i] = (qint32) ftell(fp);
+        putScan(fp, 1, points, detectors, i);
+    }
+    fseek(fp, top + 12, SEEK_SET);
+    for (int i = 0; i < rows; i++) putInt32(fp, offsets[i]);
+    fclose(fp);
+    return true;
+}
+
+/**
+ * what caScan2D did before: decode the whole file and copy one detector
+ */
+static int readWithMdaLoad(const char *fileName, int detNum, float *data, int nx, int ny)
+{
+    FILE *fp = fopen(fileName, "rb");
+    if (fp == NULL) return -1;
+    struct mda_file *mda = mda_load(fp);
+    fclose(fp);
+    if (mda == NULL) return -1;
+
+    struct mda_scan *top = mda->scan;
+    int rows = qMin((int) top->last_point, ny);
+    for (int i = 0; i < rows && top->scan_rank > 1; i++) {
+        struct mda_scan *row = top->sub_scans[i];
+        if (row == NULL) continue;
+        for (int index = 0; index < row->number_detectors; index++) {
+            if (row->detectors[index]->number != detNum) continue;
+            int points = qMin((int) row->last_point, nx);
+            for (int j = 0; j < points; j++) data[i * nx + j] = row->detectors_data[index][j];
+            break;
+        }
+    }
+    mda_unload(mda);
+    return rows;
+}
+
+static int dimensions(const char *fileName, int &nx, int &ny)
+{
+    FILE *fp = fopen(fileName, "rb");
+    if (fp == NULL) return -1;
+    struct mda_header *header = mda_header_load(fp);
+    fclose(fp);
+    if (header == NULL || header->data_rank < 2) return -1;
+    ny = header->dimensions[0];
+    nx = header->dimensions[1];
+    mda_header_unload(header);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc == 6 && !strcmp(argv[1], "-generate")) {
+        if (!generate(argv[2], atoi(argv[3]), atoi(argv[4]), atoi(argv[5]))) {
+            printf("mdaBenchmark: could not write %s\n", argv[2]);
+            return 1;
+        }
+        return 0;
+    }
+    if (argc < 2) {
+        printf("usage: mdaBenchmark file.mda [detector] [repeat]\n");
+        printf("       mdaBenchmark -generate file.mda rows points detectors\n");
+        return 1;
+    }
+
+    const char *fileName = argv[1];
+    int detector = (argc > 2) ? atoi(argv[2]) : 1;
+    int repeat = (argc > 3) ? atoi(argv[3]) : 10;
+    int nx, ny;
+    if (dimensions(fileName, nx, ny) < 0 || detector < 1 || repeat < 1) {
+        printf("mdaBenchmark: %s is not a 2D scan\n", fileName);
+        return 1;
+    }
+
+    char pvName[40];
+    sprintf(pvName, "bench:det%04d", detector);
+    QVector<float> expected(nx * ny, 0.0f);
+    QVector<float> data(nx * ny, 0.0f);
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int i = 0; i < repeat; i++) {
+        if (readWithMdaLoad(fileName, detector - 1, expected.data(), nx, ny) < 0) {
+            printf("mdaBenchmark: mda_load failed for %s\n", fileName);
+            return 1;
+        }
+    }
+    double loadTime = (double) timer.nsecsElapsed() / repeat / 1.0e6;
+
+    // a new reader every pass: map, index and decode one column of every row
+    timer.restart();
+    for (int i = 0; i < repeat; i++) {
+        mdaReader reader;
+        if (reader.gimmeYerData(fileName, pvName, data.data(), nx, ny, ny) < 0) {
+            printf("mdaBenchmark: mdaReader failed for %s\n", fileName);
+            return 1;
+        }
+    }
+    double readerTime = (double) timer.nsecsElapsed() / repeat / 1.0e6;
+
+    // the same reader on every row of a running scan
+    mdaReader reader;
+    timer.restart();
+    for (int y = 1; y <= ny; y++) reader.gimmeYerData(fileName, pvName, data.data(), nx, ny, y);
+    double scanTime = (double) timer.nsecsElapsed() / ny / 1.0e6;
+
+    int differences = 0;
+    for (int i = 0; i < nx * ny; i++) if (data[i] != expected[i]) differences++;
+
+    printf("%s: %d rows of %d points, detector %d, %d passes\n", fileName, ny, nx, detector, repeat);
+    printf("mda_load and copy  %10.3f ms\n", loadTime);
+    printf("mdaReader          %10.3f ms  (%.1f times faster)\n", readerTime, readerTime > 0 ? loadTime / readerTime : 0.0);
+    printf("mdaReader per row  %10.3f ms\n", scanTime);
+    printf("differences        %10d\n", differences);
+    return (differences == 0) ? 0 : 1;
+}
@@ -0,0 +1,23 @@
+# compares the mapped mda reader of caScan2D with mda_load, not part of the build
+#   mdaBenchmark file.mda [detector] [repeat]
+#   mdaBenchmark -generate file.mda rows points detectors
+include(../../caQtDM_Viewer/qtdefs.pri)
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+TARGET = mdaBenchmark
+INCLUDEPATH += ../../caQtDM_QtControls/src
+
+HEADERS += \
+    ../../caQtDM_QtControls/src/mdaReader.h \
+    ../../caQtDM_QtControls/src/mda-load.h
+SOURCES += \
+    mdaBenchmark.cpp \
+    ../../caQtDM_QtControls/src/mdaReader.cpp \
+    ../../caQtDM_QtControls/src/mda_loader.c
+
+XDR_HACK {
+    SOURCES += ../../caQtDM_QtControls/src/xdr_hack.c
+    HEADERS += ../../caQtDM_QtControls/src/xdr_hack.h
+}
@@ -80,13 +80,15 @@ SOURCES +=\
     fileopenwindow.cpp \
     messagebox.cpp \
     configDialog.cpp \
-    pipereader.cpp
+    pipereader.cpp \
+    displaybenchmark.cpp
 
 HEADERS  +=  \
     messagebox.h \
     fileopenwindow.h \
     configDialog.h \
-    pipereader.h
+    pipereader.h \
+    displaybenchmark.h
 
 FORMS += main.ui
 
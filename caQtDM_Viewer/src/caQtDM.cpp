@@ -170,6 +170,9 @@ int main(int argc, char *argv[])
     bool minimize= false;
     bool printscreen = false;
     bool savetoimage = false;
+    int benchmarkSeconds = 0;
+    bool server = false;
+    QString benchmarkFile = "";
     bool resizing = true;
 
     for (numargs = argc, in = 1; in < numargs; in++) {
@@ -184,6 +187,10 @@ int main(int argc, char *argv[])
         } else if ( strcmp (argv[in], "-attach" ) == 0 ) {
             printf("caQtDM -- will attach to another caQtDM instance if running\n");
             attach = true;
+        } else if ( strcmp (argv[in], "-server" ) == 0 ) {
+            printf("caQtDM -- will run as prewarmed server for attaching instances\n");
+            server = true;
+            minimize = true;
         } else if ( strcmp (argv[in], "-noMsg" ) == 0 ) {
             printf("caQtDM -- will minimize its main windows\n");
             minimize = true;
@@ -206,6 +213,7 @@ int main(int argc, char *argv[])
                    "  [-help | -h | -?] describe the options\n"
                    "  [-x] has no effect (MEDM’s execute-only mode)\n"
                    "  [-attach] attach to a running caQtDM instance\n"
+                   "  [-server] run minimized and preload fonts, widgets and the displays in CAQTDM_PREWARM_DISPLAYS for attaching instances\n"
                    "  [-noMsg] iconize the main window\n"
                    "  [-stylefile filename] will replace the default stylesheet with the specified file (works only when not attaching)\n"
                    "  [-macro \"xxx=aaa,yyy=bbb, ...\"] apply macro substitution to replace occurrences of $(xxx) with value aaa\n"
@@ -215,6 +223,8 @@ int main(int argc, char *argv[])
                    "  [-print] will print file and exit\n"
                    "  [-savetoimage] will save image file and exit\n"
                    "  [-noResize] will prevent resizing\n"
+                   "  [-benchmark seconds] will measure loading, connecting, first paint and updates of the display, then exit\n"
+                   "  [-benchmarkfile filename] json file for the benchmark results (default stdout)\n"
                    "  [-cs defaultcontrolsystempluginname] will override the default epics3 datasource\n"
                    "  [-option \"xxx=aaa,yyy=bbb, ...\"] various options,\n"
                    "  \t e.g. -option \"updatetype=direct\" will set the updatetype to Direct\n"
@@ -243,6 +253,14 @@ int main(int argc, char *argv[])
             savetoimage = true;
             minimize = true;
             resizing = false;
+        } else if(!strcmp(argv[in], "-benchmark")) {
+            in++;
+            benchmarkSeconds = atoi(argv[in]);
+            if(benchmarkSeconds <= 0) benchmarkSeconds = 10;
+            resizing = false;
+        } else if(!strcmp(argv[in], "-benchmarkfile")) {
+            in++;
+            benchmarkFile = QString(argv[in]);
         } else if(!strcmp(argv[in], "-noResize")) {
             resizing = false;
         } else if(!strcmp(argv[in], "-httpconfig")) {
@@ -266,7 +284,7 @@ int main(int argc, char *argv[])
             createMap(options, QString(argv[in]));
         } else if (strncmp (argv[in], "-" , 1) == 0) {
             /* unknown application argument */
-            printf("caQtDM -- Argument %d = [%s] is unknown!, possible -attach -macro -noMsg -stylefile -dg -x -print -httpconfig -noResize -option\n",in,argv[in]);
+            printf("caQtDM -- Argument %d = [%s] is unknown!, possible -attach -server -macro -noMsg -stylefile -dg -x -print -httpconfig -noResize -benchmark -benchmarkfile -option\n",in,argv[in]);
         } else {
             printf("caQtDM -- file = <%s>\n", argv[in]);
             fileName = QString(argv[in]);
@@ -353,7 +371,9 @@ int main(int argc, char *argv[])
     FileOpenWindow fileOpenWindow (0, fileName, macroString, attach, minimize, geometry, printscreen, resizing, options);
     fileOpenWindow.setWindowIcon (QIcon(":/caQtDM.ico"));
     if (savetoimage) fileOpenWindow.setProperty("savetoimage", true);
+    if (benchmarkSeconds > 0) fileOpenWindow.startBenchmark(benchmarkSeconds, benchmarkFile);
     fileOpenWindow.show();
+    if (server) fileOpenWindow.prewarm(((QString) qgetenv("CAQTDM_PREWARM_DISPLAYS")).split(","));
 #ifdef CAQTDM_X11
     #if QT_VERSION > QT_VERSION_CHECK(5,0,0)
         if (qApp->platformName()== QLatin1String("xcb")){
@@ -0,0 +1,337 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#include <QApplication>
+#include <QFile>
+#include <QTextStream>
+#include <QEvent>
+#include <QDebug>
+#include <time.h>
+#include <algorithm>
+#ifdef linux
+#include <sys/resource.h>
+#endif
+
+#include "displaybenchmark.h"
+#include "caqtdm_lib.h"
+#include "castripplot.h"
+
+// time allowed for connecting all channels and for the first complete paint
+#define BENCHMARK_CONNECT_TIMEOUT 30000.0
+#define BENCHMARK_PAINT_TIMEOUT 5000.0
+// time allowed for finding and loading the display
+#define BENCHMARK_LOAD_TIMEOUT 60000
+
+DisplayBenchmark::DisplayBenchmark(MutexKnobData *mutexKnobData, int seconds, const QString &outputFile, QObject *parent) : QObject(parent)
+{
+    mutexKnobDataP = mutexKnobData;
+    windowP = (CaQtDM_Lib *) Q_NULLPTR;
+    runSeconds = seconds;
+    outputFileName = outputFile;
+    phase = Waiting;
+
+    timeToWindow = timeToConnected = timeToFirstPaint = -1.0;
+    allConnected = false;
+    channels = 0;
+    frames = framesAtStart = monitorsAtStart = 0;
+    cpuAtStart = runStart = 0.0;
+    for(int i=0; i < 4; i++) locksAtStart[i] = 0;
+
+    pollTimer = new QTimer(this);
+    pollTimer->setInterval(10);
+    connect(pollTimer, SIGNAL(timeout()), this, SLOT(Callback_Poll()));
+
+    // a display that can not be found or loaded ends the benchmark with an error
+    loadTimer = new QTimer(this);
+    loadTimer->setSingleShot(true);
+    connect(loadTimer, SIGNAL(timeout()), this, SLOT(Callback_LoadTimeout()));
+    loadTimer->start(BENCHMARK_LOAD_TIMEOUT);
+}
+
+DisplayBenchmark::~DisplayBenchmark()
+{
+}
+
+/**
+ * called just before the display is built
+ */
+void DisplayBenchmark::loadStarted(const QString &fileName)
+{
+    if(phase != Waiting) return;
+    displayFileName = fileName;
+    clock.start();
+}
+
+/**
+ * called when the display has been built, from now on we look at the connections and paints
+ */
+void DisplayBenchmark::loadFinished(CaQtDM_Lib *window)
+{
+    if(phase != Waiting) return;
+    // a display that failed to load has no widget and deletes itself
+    if(window == (CaQtDM_Lib *) Q_NULLPTR || window->getMyWidget() == (QWidget*) Q_NULLPTR) {
+        Callback_LoadTimeout();
+        return;
+    }
+    loadTimer->stop();
+    windowP = window;
+    timeToWindow = (double) clock.elapsed();
+    windowP->installEventFilter(this);
+    phase = Connecting;
+    pollTimer->start();
+}
+
+/**
+ * every repaint of the window goes through an update request on the top level widget, we count them as frames
+ */
+bool DisplayBenchmark::eventFilter(QObject *obj, QEvent *event)
+{
+    if(obj == windowP && event->type() == QEvent::UpdateRequest) {
+        frames++;
+        if(phase == Painting) {
+            int countPV = 0, countNotConnected = 0, countDisplayed = 0;
+            countChannels(countPV, countNotConnected, countDisplayed);
+            if(countDisplayed >= (countPV - countNotConnected)) {
+                timeToFirstPaint = (double) clock.elapsed();
+                startRunning((double) clock.elapsed());
+            }
+        }
+    }
+    return QObject::eventFilter(obj, event);
+}
+
+/**
+ * the display was not loaded, exit with an error instead of waiting for ever
+ */
+void DisplayBenchmark::Callback_LoadTimeout()
+{
+    if(phase != Waiting) return;
+    phase = Done;
+    loadTimer->stop();
+    if(displayFileName.length() > 0) {
+        printf("caQtDM -- benchmark: display %s could not be loaded\n", qasc(displayFileName));
+    } else {
+        printf("caQtDM -- benchmark: no display loaded within %d seconds\n", BENCHMARK_LOAD_TIMEOUT / 1000);
+    }
+    fflush(stdout);
+    qApp->exit(1);
+}
+
+void DisplayBenchmark::Callback_Poll()
+{
+    int countPV = 0, countNotConnected = 0, countDisplayed = 0;
+    double now = (double) clock.elapsed();
+
+    switch(phase) {
+    case Connecting:
+        countChannels(countPV, countNotConnected, countDisplayed);
+        if(countPV > 0 && countNotConnected == 0) {
+            allConnected = true;
+            timeToConnected = now;
+            phase = Painting;
+        } else if(now > BENCHMARK_CONNECT_TIMEOUT) {
+            qDebug() << "caQtDM -- benchmark:" << countNotConnected << "of" << countPV << "channels not connected, continuing";
+            phase = Painting;
+        }
+        break;
+
+    case Painting:
+        // nothing painted, continue anyway
+        if(now - (timeToConnected > 0.0 ? timeToConnected : BENCHMARK_CONNECT_TIMEOUT) > BENCHMARK_PAINT_TIMEOUT) {
+            qDebug() << "caQtDM -- benchmark: no complete paint detected, continuing";
+            startRunning(now);
+        }
+        break;
+
+    case Running:
+        if(now - runStart >= runSeconds * 1000.0) {
+            phase = Done;
+            pollTimer->stop();
+            finish();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void DisplayBenchmark::countChannels(int &countPV, int &countNotConnected, int &countDisplayed)
+{
+    foreach(int i, mutexKnobDataP->GetMutexKnobDataWindowSlots(windowP->getMyWidget())) {
+        knobData *kPtr = mutexKnobDataP->GetMutexKnobDataPtr(i);
+        if(kPtr->index == -1 || kPtr->soft) continue;
+        if((QWidget*) kPtr->thisW != windowP->getMyWidget()) continue;
+        if(!kPtr->edata.connected) {
+            countNotConnected++;
+        } else {
+            if(kPtr->edata.displayCount > 0) countDisplayed++;
+        }
+        countPV++;
+    }
+    channels = countPV;
+}
+
+qint64 DisplayBenchmark::totalMonitors()
+{
+    qint64 total = 0;
+    for (int i=0; i < mutexKnobDataP->GetMutexKnobDataSize(); i++) {
+        knobStatistics stat;
+        if(mutexKnobDataP->GetMutexKnobStatistics(i, stat)) total += stat.monitorsReceived;
+    }
+    return total;
+}
+
+/**
+ * from now on the counters are taken into account
+ */
+void DisplayBenchmark::startRunning(double now)
+{
+    phase = Running;
+    framesAtStart = frames;
+    monitorsAtStart = totalMonitors();
+    cpuAtStart = cpuTime();
+    mutexKnobDataP->getLockStatistics(locksAtStart[0], locksAtStart[1], locksAtStart[2], locksAtStart[3]);
+    runStart = now;
+    windowP->setUpdateTiming(true);
+
+    QList<caStripPlot *> stripPlots = windowP->findChildren<caStripPlot *>();
+    foreach(caStripPlot *stripPlot, stripPlots) stripPlot->resetFrameTimes();
+}
+
+/**
+ * cpu time used by the process in milliseconds
+ */
+double DisplayBenchmark::cpuTime()
+{
+#ifdef linux
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (double) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+           (double) (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+#else
+    return (double) ::clock() * 1000.0 / (double) CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * write the results and quit
+ */
+void DisplayBenchmark::finish()
+{
+    double duration = ((double) clock.elapsed() - runStart) / 1000.0;
+    if(duration <= 0.0) duration = 1.0;
+    qint64 monitors = totalMonitors() - monitorsAtStart;
+    double cpu = cpuTime() - cpuAtStart;
+
+    // contention on the knob data locks, compare with CAQTDM_KNOBDATA_FIELDACCESS=false
+    qint64 locks[4];
+    mutexKnobDataP->getLockStatistics(locks[0], locks[1], locks[2], locks[3]);
+    for(int i=0; i < 4; i++) locks[i] -= locksAtStart[i];
+
+    QVector<float> timings = windowP->getUpdateTimings();
+    windowP->setUpdateTiming(false);
+    std::sort(timings.begin(), timings.end());
+    double mean = 0.0;
+    for(int i=0; i < timings.size(); i++) mean += timings.at(i);
+    if(timings.size() > 0) mean /= (double) timings.size();
+
+    // cost of finding the update routine of a widget, cast chain against dispatch table
+    double chainNs, tableNs;
+    windowP->benchmarkDispatch(10000, chainNs, tableNs);
+
+    // gui thread time of the strip charts, display timer and canvas paints
+    QList<caStripPlot *> stripPlots = windowP->findChildren<caStripPlot *>();
+    int stripFrames = 0, stripRenderFrames = 0;
+    double stripGuiUs = 0.0, stripRenderUs = 0.0;
+    bool renderThread = false;
+    foreach(caStripPlot *stripPlot, stripPlots) {
+        int nbFrames, nbRenderFrames;
+        double guiUs, renderUs;
+        stripPlot->getFrameTimes(nbFrames, guiUs, nbRenderFrames, renderUs);
+        stripFrames += nbFrames;
+        stripGuiUs += guiUs;
+        stripRenderFrames += nbRenderFrames;
+        stripRenderUs += renderUs;
+        if(stripPlot->getRenderThread()) renderThread = true;
+    }
+
+    QString json;
+    QTextStream out(&json);
+    out << "{\n";
+    out << "  \"display\": \"" << QString(displayFileName).replace("\\", "\\\\").replace("\"", "\\\"") << "\",\n";
+#if QT_VERSION > QT_VERSION_CHECK(5, 0, 0)
+    out << "  \"platform\": \"" << qApp->platformName() << "\",\n";
+#endif
+    out << "  \"qt\": \"" << qVersion() << "\",\n";
+    out << "  \"channels\": " << channels << ",\n";
+    out << "  \"allConnected\": " << (allConnected ? "true" : "false") << ",\n";
+    out << "  \"timeToWindowMs\": " << timeToWindow << ",\n";
+    out << "  \"timeToConnectedMs\": " << timeToConnected << ",\n";
+    out << "  \"timeToFirstPaintMs\": " << timeToFirstPaint << ",\n";
+    out << "  \"durationS\": " << duration << ",\n";
+    out << "  \"monitors\": " << monitors << ",\n";
+    out << "  \"monitorsPerSecond\": " << (double) monitors / duration << ",\n";
+    out << "  \"framesPerSecond\": " << (double) (frames - framesAtStart) / duration << ",\n";
+    out << "  \"cpuMs\": " << cpu << ",\n";
+    out << "  \"cpuUsPerMonitor\": " << (monitors > 0 ? cpu * 1000.0 / (double) monitors : 0.0) << ",\n";
+    out << "  \"updateWidget\": {\"count\": " << timings.size();
+    if(timings.size() > 0) {
+        int n = timings.size() - 1;
+        out << ", \"meanUs\": " << mean
+            << ", \"p50Us\": " << timings.at((int) (0.50 * n))
+            << ", \"p90Us\": " << timings.at((int) (0.90 * n))
+            << ", \"p99Us\": " << timings.at((int) (0.99 * n))
+            << ", \"maxUs\": " << timings.at(n);
+    }
+    out << "},\n";
+    out << "  \"knobLocks\": {\"globalAcquired\": " << locks[0] << ", \"globalContended\": " << locks[1]
+        << ", \"stripeAcquired\": " << locks[2] << ", \"stripeContended\": " << locks[3] << "},\n";
+    out << "  \"dispatch\": {\"chainNs\": " << chainNs << ", \"tableNs\": " << tableNs << "},\n";
+    out << "  \"stripPlots\": {\"count\": " << stripPlots.count()
+        << ", \"renderThread\": " << (renderThread ? "true" : "false")
+        << ", \"frames\": " << stripFrames
+        << ", \"guiUsPerFrame\": " << (stripFrames > 0 ? stripGuiUs / (double) stripFrames : 0.0)
+        << ", \"guiUsPerSecondPerPlot\": " << (stripPlots.count() > 0 ? stripGuiUs / duration / (double) stripPlots.count() : 0.0)
+        << ", \"renderUsPerFrame\": " << (stripRenderFrames > 0 ? stripRenderUs / (double) stripRenderFrames : 0.0) << "}\n";
+    out << "}\n";
+    out.flush();
+
+    if(outputFileName.length() > 0) {
+        QFile file(outputFileName);
+        if(file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(json.toUtf8());
+            file.close();
+            printf("caQtDM -- benchmark results written to %s\n", qasc(outputFileName));
+        } else {
+            printf("caQtDM -- could not write benchmark results to %s\n", qasc(outputFileName));
+        }
+    } else {
+        printf("%s", qasc(json));
+    }
+    fflush(stdout);
+
+    qApp->exit(0);
+}
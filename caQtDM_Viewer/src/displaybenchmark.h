@@ -0,0 +1,93 @@
+/*
+ *  This file is part of the caQtDM Framework, developed at the Paul Scherrer Institut,
+ *  Villigen, Switzerland
+ *
+ *  The caQtDM Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The caQtDM Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with the caQtDM Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Copyright (c) 2010 - 2014
+ *
+ *  Author:
+ *    Anton Mezger
+ *  Contact details:
+ *    anton.mezger@psi.ch
+ */
+
+#ifndef DISPLAYBENCHMARK_H
+#define DISPLAYBENCHMARK_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QString>
+#include "mutexKnobData.h"
+
+class CaQtDM_Lib;
+
+/**
+ * measures the load and update performance of one display and writes the results as json,
+ * used with "caQtDM -platform offscreen -benchmark seconds [-benchmarkfile file] display.ui"
+ */
+class DisplayBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    DisplayBenchmark(MutexKnobData *mutexKnobData, int seconds, const QString &outputFile, QObject *parent = 0);
+    ~DisplayBenchmark();
+
+    void loadStarted(const QString &fileName);
+    void loadFinished(CaQtDM_Lib *window);
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event);
+
+private slots:
+    void Callback_Poll();
+    void Callback_LoadTimeout();
+
+private:
+    enum Phase {Waiting, Connecting, Painting, Running, Done};
+
+    void countChannels(int &countPV, int &countNotConnected, int &countDisplayed);
+    qint64 totalMonitors();
+    double cpuTime();
+    void startRunning(double now);
+    void finish();
+
+    MutexKnobData *mutexKnobDataP;
+    CaQtDM_Lib *windowP;
+    QTimer *pollTimer;
+    QTimer *loadTimer;
+    QElapsedTimer clock;
+    Phase phase;
+    QString outputFileName;
+    QString displayFileName;
+    int runSeconds;
+
+    double timeToWindow;
+    double timeToConnected;
+    double timeToFirstPaint;
+    bool allConnected;
+    int channels;
+
+    qint64 frames;
+    qint64 framesAtStart;
+    qint64 monitorsAtStart;
+    double cpuAtStart;
+    qint64 locksAtStart[4];
+    double runStart;
+};
+
+#endif
@@ -53,6 +53,13 @@ bool HTTPCONFIGURATOR = false;
 #include <QString>
 #include "messagebox.h"
 #include "configDialog.h"
+#include "displaybenchmark.h"
+#include "displaypreloader.h"
+#include "writepipeline.h"
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QBuffer>
+#include <QFontDatabase>
 #include "caQtDM_Lib_global.h"
 
 #ifdef linux
@@ -286,6 +293,7 @@ FileOpenWindow::FileOpenWindow(QMainWindow* parent,  QString filename, QString m
     connect( this->ui.exitAction, SIGNAL( triggered() ), this, SLOT(Callback_ActionExit()) );
     connect( this->ui.reloadAction, SIGNAL( triggered() ), this, SLOT(Callback_ActionReload()) );
     connect( this->ui.unconnectedAction, SIGNAL( triggered() ), this, SLOT(Callback_ActionUnconnected()) );
+    connect( this->ui.statisticsAction, SIGNAL( triggered() ), this, SLOT(Callback_ActionStatistics()) );
     connect( this->ui.timedAction, SIGNAL( triggered() ), this, SLOT(Callback_ActionTimed()) );
     connect( this->ui.directAction, SIGNAL( triggered() ), this, SLOT(Callback_ActionDirect()) );
     connect( this->ui.helpAction, SIGNAL( triggered() ), this, SLOT(Callback_ActionHelp()) );
@@ -341,7 +349,26 @@ FileOpenWindow::FileOpenWindow(QMainWindow* parent,  QString filename, QString m
     qDebug() << "caQtDM -- shared memory key" << uniqueKey;
     sharedMemory.setKey (uniqueKey);
 
-    // in case that one wants to attach to an instance that is actually creating, wait until we can attach
+    // the running instance listens on a local socket, derived from the same key
+    QString attachServerName = QString("caQtDM-") + QString(QCryptographicHash::hash(uniqueKey.toUtf8(), QCryptographicHash::Md5).toHex().left(16));
+    attachServer = (QLocalServer *) Q_NULLPTR;
+
+    QString message(filename);
+    message.append(";");
+    message.append(macroString);
+    message.append(";");
+    message.append(geometry);
+    message.append(";");
+    message.append(lastResizing);
+
+    // hand the request to the running instance, it wakes up immediately
+    if(attach && sendAttachRequest(attachServerName, message)) {
+        qDebug() << "caQtDM -- another instance of caQtDM detected ==> request handed over (" << attachServerName << ")";
+        exit(0);
+    }
+
+    // in case that one wants to attach to an instance that is actually creating or to an older instance without
+    // local socket, wait until we can attach to the shared memory
     if(attach) {
         for(int j=0; j<10; j++) {
             Sleep::msleep(150);
@@ -357,13 +384,6 @@ FileOpenWindow::FileOpenWindow(QMainWindow* parent,  QString filename, QString m
         _isRunning = true;
         if(attach) {
             qDebug() << "caQtDM -- another instance of caQtDM detected with size"  << sharedMemory.size() << "==> attach to it (" << uniqueKey <<")" ;
-            QString message(filename);
-            message.append(";");
-            message.append(macroString);
-            message.append(";");
-            message.append(geometry);
-            message.append(";");
-            message.append(lastResizing);
             qDebug() << "send a message with file, macro and geometry to it and exit "<< message;
             sendMessage(message);
             sharedMemory.detach();
@@ -388,10 +408,32 @@ FileOpenWindow::FileOpenWindow(QMainWindow* parent,  QString filename, QString m
             memcpy(to, from, qMin(sharedMemory.size(), byteArray.size()));
             MSQ_init();
             sharedMemory.unlock();
-            // start checking for messages of other instances.
+            // the shared memory is only polled for instances that do not know the local socket yet
             timer = new QTimer(this);
             connect(timer, SIGNAL(timeout()), this, SLOT(checkForMessage()));
             timer->start(1000);
+
+            // listen for requests of other instances, only the instance owning the shared memory does;
+            // a socket nobody answers on is left over from a crashed instance and is removed first
+            QLocalSocket probe;
+            probe.connectToServer(attachServerName);
+            if(probe.waitForConnected(500)) {
+                probe.disconnectFromServer();
+                qDebug() << "caQtDM -- another instance listens on" << attachServerName << "==> not listening";
+            } else {
+                attachServer = new QLocalServer(this);
+                QLocalServer::removeServer(attachServerName);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+                // only our own user may hand over displays
+                attachServer->setSocketOptions(QLocalServer::UserAccessOption);
+#endif
+                if(attachServer->listen(attachServerName)) {
+                    connect(attachServer, SIGNAL(newConnection()), this, SLOT(Callback_AttachConnection()));
+                    qDebug() << "caQtDM -- listening for other instances on" << attachServer->fullServerName();
+                } else {
+                    qDebug() << "caQtDM -- Unable to listen for other instances:" << attachServer->errorString();
+                }
+            }
         }
     }
 #else
@@ -415,6 +457,9 @@ FileOpenWindow::FileOpenWindow(QMainWindow* parent,  QString filename, QString m
 
     pvWindow = (QMainWindow*) Q_NULLPTR;
     pvTable = (QTableWidget*) Q_NULLPTR;
+    statWindow = (QMainWindow*) Q_NULLPTR;
+    statTable = (QTableWidget*) Q_NULLPTR;
+    benchmark = (DisplayBenchmark*) Q_NULLPTR;
 
 //************************************************************************************************************************************************
     if(HTTPCONFIGURATOR) {
@@ -600,6 +645,18 @@ FileOpenWindow::FileOpenWindow(QMainWindow* parent,  QString filename, QString m
         messageWindow->postMsgEvent(QtInfoMsg, (char*) qasc(displayTimeOut));
     }
 
+    // per PV statistics can be written periodically to a file (json) for external monitoring
+    statisticsFile = (QString) qgetenv("CAQTDM_STATISTICS_FILE");
+    statisticsInterval = 5;
+    if(statisticsFile.length() > 0) {
+        bool ok;
+        int interval = QString(qgetenv("CAQTDM_STATISTICS_INTERVAL")).trimmed().toInt(&ok);
+        if(ok && interval > 0) statisticsInterval = interval;
+        mutexKnobData->setDisplayStatistics(true);
+        QString info = QString("Info: PV statistics will be written to %1 every %2 seconds").arg(statisticsFile).arg(statisticsInterval);
+        messageWindow->postMsgEvent(QtInfoMsg, (char*) qasc(info));
+    }
+
     // available memory in KiB
     long long availableMemory = getAvailableMemory();
 
@@ -819,7 +876,54 @@ void FileOpenWindow::timerEvent(QTimerEvent *event)
         } else {
             strcpy(msg, asc);
         }
+
+        // subscriptions saved for widgets that can not be seen
+        int countSuspended = mutexKnobData->getSuspendedCount();
+        if(countSuspended > 0) {
+            char asc1[80];
+            snprintf(asc1, 80, " - %d PV not visible (suspended)", countSuspended);
+            if(strlen(msg) + strlen(asc1) < MAX_STRING_LENGTH) strcat(msg, asc1);
+        }
+
+        // decisions of the display budget
+        int countThrottled = mutexKnobData->getThrottledCount();
+        int deferred = mutexKnobData->getDeferredPerSecond();
+        if(countThrottled > 0 || deferred > 0) {
+            char asc1[80];
+            snprintf(asc1, 80, " - display budget %.0f%%, %d PV throttled, %d deferred/s",
+                     mutexKnobData->getBudgetUsed() * 100.0, countThrottled, deferred);
+            if(strlen(msg) + strlen(asc1) < MAX_STRING_LENGTH) strcat(msg, asc1);
+        }
+
+        // related displays prepared ahead
+        QString preloadStatistics = DisplayPreloader::instance()->statisticsString();
+        if(!preloadStatistics.isEmpty()) {
+            char asc1[120];
+            snprintf(asc1, 120, " - %s", qasc(preloadStatistics));
+            if(strlen(msg) + strlen(asc1) < MAX_STRING_LENGTH) strcat(msg, asc1);
+        }
+
+        // puts held back and replaced by later ones, round trip of the confirmed puts
+        QString putStatistics = WritePipeline::instance()->statisticsString();
+        if(!putStatistics.isEmpty()) {
+            char asc1[160];
+            snprintf(asc1, 160, " - %s", qasc(putStatistics));
+            if(strlen(msg) + strlen(asc1) < MAX_STRING_LENGTH) strcat(msg, asc1);
+        }
+        if(WritePipeline::instance()->isConfirmed()) statusBar()->setToolTip(WritePipeline::instance()->latencyString());
         statusBar()->showMessage(msg);
+
+        // per PV statistics
+        if((statWindow != (QMainWindow*) Q_NULLPTR) && statWindow->isVisible()) fillStatisticsTable();
+        if(statisticsFile.length() > 0) {
+            static int statisticsCount = 0;
+            if(++statisticsCount >= statisticsInterval) {
+                statisticsCount = 0;
+                if(!mutexKnobData->dumpStatistics(statisticsFile)) {
+                    qDebug() << "caQtDM -- could not write statistics to" << statisticsFile;
+                }
+            }
+        }
     }
     QString filename_save=qgetenv("CAQTDM_SCREENSHOT_NAME");
     // we wanted a print, do it when acquired, then exit
@@ -948,6 +1052,9 @@ QMainWindow *FileOpenWindow::loadMainWindow(const QPoint &position, const QStrin
     if (suppressUpdates.toLower() == "true") {
         mutexKnobData->setSuppressUpdates(true);
     }
+    // benchmark requested from the command line, only the first display is measured
+    if(benchmark != (DisplayBenchmark*) Q_NULLPTR) benchmark->loadStarted(fileS);
+
     QElapsedTimer timer;
     timer.start();
     CaQtDM_Lib *newWindow =  new CaQtDM_Lib(this, fileS, macroS, mutexKnobData, interfaces, messageWindow, willprint, Q_NULLPTR, OptionList);
@@ -1030,6 +1137,8 @@ QMainWindow *FileOpenWindow::loadMainWindow(const QPoint &position, const QStrin
         mainWindow->show();
     }
 
+    if(benchmark != (DisplayBenchmark*) Q_NULLPTR) benchmark->loadFinished(newWindow);
+
     mainWindow->raise();
     mainWindow->setMinimumSize(mainWindow->size()/4);
     mainWindow->setMaximumSize(16777215, 16777215);
@@ -1555,7 +1664,14 @@ void FileOpenWindow::checkForMessage()
         //qDebug() << "queue was empty, so do nothing";
         return;  // no message, quit
     }
-    QString message = QString::fromUtf8(element.blop); // get and split message
+    processAttachMessage(QString::fromUtf8(element.blop));
+}
+
+/**
+ * a request of another instance: file;macro;geometry;resizing
+ */
+void FileOpenWindow::processAttachMessage(const QString &message)
+{
     QStringList vars = message.split(";");
 
     //qDebug() << "received message=" << message;
@@ -1564,6 +1680,121 @@ void FileOpenWindow::checkForMessage()
     if(vars.count() == 4) emit Callback_OpenNewFile(vars.at(0), vars.at(1), vars.at(2), vars.at(3));
 }
 
+#ifndef MOBILE
+/**
+ * send a request to the instance listening on serverName, false when there is none
+ */
+bool FileOpenWindow::sendAttachRequest(const QString &serverName, const QString &message)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverName);
+    if(!socket.waitForConnected(500)) return false;
+
+    QByteArray data = message.toUtf8();
+    data.append('\n');
+    socket.write(data);
+    bool written = socket.waitForBytesWritten(1000);
+    socket.disconnectFromServer();
+    if(socket.state() != QLocalSocket::UnconnectedState) socket.waitForDisconnected(1000);
+    return written;
+}
+#endif
+
+void FileOpenWindow::Callback_AttachConnection()
+{
+#ifndef MOBILE
+    while(attachServer->hasPendingConnections()) {
+        QLocalSocket *socket = attachServer->nextPendingConnection();
+        connect(socket, SIGNAL(readyRead()), this, SLOT(Callback_AttachReadyRead()));
+        connect(socket, SIGNAL(disconnected()), this, SLOT(Callback_AttachReadyRead()));
+        connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
+    }
+#endif
+}
+
+void FileOpenWindow::Callback_AttachReadyRead()
+{
+#ifndef MOBILE
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    if(socket == (QLocalSocket *) Q_NULLPTR) return;
+    while(socket->canReadLine()) {
+        QString message = QString::fromUtf8(socket->readLine());
+        if(message.endsWith("\n")) message.chop(1);
+        // time from the request to the display shown, reported for the prewarmed server
+        QElapsedTimer clock;
+        clock.start();
+        processAttachMessage(message);
+        char asc[MAX_STRING_LENGTH];
+        snprintf(asc, MAX_STRING_LENGTH, "Info: attach request %s served in %d ms", qasc(message.section(";", 0, 0)), (int) clock.elapsed());
+        messageWindow->postMsgEvent(QtInfoMsg, asc);
+    }
+#endif
+}
+
+/**
+ * benchmark requested from the command line, the first display loaded is measured
+ */
+void FileOpenWindow::startBenchmark(int seconds, const QString &outputFile)
+{
+    if(benchmark != (DisplayBenchmark*) Q_NULLPTR) return;
+    benchmark = new DisplayBenchmark(mutexKnobData, seconds, outputFile, this);
+}
+
+/**
+ * server mode: load once what the first display would have to load otherwise, i.e. the fonts,
+ * the designer plugins with our widgets and the templates given in CAQTDM_PREWARM_DISPLAYS.
+ * the templates are built once to load their widget classes and styles, their file contents are kept
+ * in the template cache so that an attach request does not read them again
+ */
+void FileOpenWindow::prewarm(const QStringList &files)
+{
+    char asc[MAX_STRING_LENGTH];
+    QElapsedTimer clock;
+    int nbDisplays = 0;
+    clock.start();
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    QFontDatabase database;
+    int nbFonts = database.families().count();
+#else
+    int nbFonts = QFontDatabase::families().count();
+#endif
+
+    QUiLoader loader;
+    int nbWidgets = loader.availableWidgets().count();
+
+    foreach(QString file, files) {
+        file = file.trimmed();
+        if(file.length() == 0) continue;
+        searchFile *s = new searchFile(file);
+        QString fileNameFound = s->findFile();
+        delete s;
+        if(fileNameFound.isNull()) {
+            snprintf(asc, MAX_STRING_LENGTH, "prewarm: file %s not found", qasc(file));
+            messageWindow->postMsgEvent(QtWarningMsg, asc);
+            continue;
+        }
+        if(!DisplayPreloader::instance()->keepTemplate(fileNameFound)) continue;
+        QFile uiFile(fileNameFound);
+        if(!uiFile.open(QFile::ReadOnly)) continue;
+        QBuffer buffer;
+        buffer.setData(DisplayPreloader::instance()->fileContents(&uiFile));
+        buffer.open(QIODevice::ReadOnly);
+        QWidget *w = loader.load(&buffer, this);
+        uiFile.close();
+        if(w != (QWidget*) Q_NULLPTR) {
+            w->hide();
+            w->ensurePolished();
+            delete w;
+            nbDisplays++;
+        }
+    }
+
+    snprintf(asc, MAX_STRING_LENGTH, "Info: prewarmed %d fonts, %d widget classes and %d displays in %d ms",
+             nbFonts, nbWidgets, nbDisplays, (int) clock.elapsed());
+    messageWindow->postMsgEvent(QtInfoMsg, asc);
+}
+
 bool FileOpenWindow::isRunning()
 {
     return _isRunning;
@@ -1693,6 +1924,108 @@ void FileOpenWindow::fillPVtable(int &countPV, int &countNotConnected, int &coun
     }
 }
 
+/**
+ * display the per PV statistics (top talkers, latencies), sortable by column
+ */
+void FileOpenWindow::Callback_ActionStatistics()
+{
+    mutexKnobData->setDisplayStatistics(true);
+    if(statWindow != (QMainWindow*) Q_NULLPTR) {
+        fillStatisticsTable();
+        statWindow->show();
+        return;
+    }
+    statWindow = new QMainWindow();
+    statWindow->setWindowTitle(QString::fromUtf8("PV statistics"));
+    statWindow->setWindowFlags(Qt::CustomizeWindowHint | Qt::WindowMinMaxButtonsHint | Qt::WindowCloseButtonHint);
+    // closed through its title bar the statistics must be switched off too
+    statWindow->installEventFilter(this);
+
+    QVBoxLayout *l = new QVBoxLayout();
+
+    statWindow->resize(900, 400);
+
+    statTable = new QTableWidget();
+    statTable->setColumnCount(10);
+    statTable->setSizePolicy(QSizePolicy::Expanding,QSizePolicy::Expanding);
+    statTable->setHorizontalHeaderLabels(QString("PV;object;plugin;monitors/s;displays/s;monitors;displays;coalesced;latency avg [ms];latency max [ms]").split(";"));
+    statTable->setAlternatingRowColors(true);
+    statTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    statTable->sortByColumn(3, Qt::DescendingOrder);
+
+    QPushButton *pushbutton = new QPushButton("close");
+    connect(pushbutton, SIGNAL(clicked()), this, SLOT(Callback_StatisticsWindowExit()));
+
+    l->addWidget(statTable);
+    l->addWidget(pushbutton);
+
+    QWidget* widg = new QWidget();
+    widg->setLayout(l);
+
+    fillStatisticsTable();
+    statTable->resizeColumnsToContents();
+    statTable->horizontalHeader()->setStretchLastSection(true);
+
+    statWindow->setCentralWidget(widg);
+    statWindow->show();
+}
+
+void FileOpenWindow::Callback_StatisticsWindowExit()
+{
+    statWindow->hide();
+    if(statisticsFile.length() == 0) mutexKnobData->setDisplayStatistics(false);
+}
+
+void FileOpenWindow::fillStatisticsTable()
+{
+    if(statTable == (QTableWidget*) Q_NULLPTR) return;
+    if(mutexKnobData == (MutexKnobData *) Q_NULLPTR) return;
+
+    // sorting has to be disabled while filling, otherwise the rows move during insertion
+    statTable->setSortingEnabled(false);
+    statTable->setRowCount(0);
+
+    int count = 0;
+    for (int i=0; i < mutexKnobData->GetMutexKnobDataSize(); i++) {
+        knobData *kPtr = mutexKnobData->GetMutexKnobDataPtr(i);
+        knobStatistics stat;
+        if(kPtr->index == -1) continue;
+        if(!mutexKnobData->GetMutexKnobStatistics(i, stat)) continue;
+        double latencyAvg = (stat.latencyCount > 0) ? stat.latencySum / (double) stat.latencyCount : 0.0;
+
+        statTable->insertRow(count);
+        statTable->setItem(count, 0, new QTableWidgetItem(kPtr->pv));
+        statTable->setItem(count, 1, new QTableWidgetItem(kPtr->dispName));
+        statTable->setItem(count, 2, new QTableWidgetItem(kPtr->pluginName));
+
+        // numeric items, in order to get a numeric sort
+        QTableWidgetItem *item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, (double) stat.monitorsPerSecond);
+        statTable->setItem(count, 3, item);
+        item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, (double) stat.displaysPerSecond);
+        statTable->setItem(count, 4, item);
+        item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, stat.monitorsReceived);
+        statTable->setItem(count, 5, item);
+        item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, stat.displaysDone);
+        statTable->setItem(count, 6, item);
+        item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, stat.coalesced);
+        statTable->setItem(count, 7, item);
+        item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, latencyAvg);
+        statTable->setItem(count, 8, item);
+        item = new QTableWidgetItem();
+        item->setData(Qt::DisplayRole, stat.latencyMax);
+        statTable->setItem(count, 9, item);
+        count++;
+    }
+
+    statTable->setSortingEnabled(true);
+}
+
 /**
  *   in medm geometry is passed through XParseGeometry:
  *    XParseGeometry parses strings of the form
@@ -1880,7 +2213,9 @@ bool FileOpenWindow::event(QEvent *e)
 
 bool FileOpenWindow::eventFilter(QObject *obj, QEvent *event)
 {
-    Q_UNUSED(obj);
     if (event->type() == QEvent::MouseMove) caQtDM_TimeLeft = caQtDM_TimeOut;
+    if (event->type() == QEvent::Close && obj == statWindow) {
+        if(statisticsFile.length() == 0) mutexKnobData->setDisplayStatistics(false);
+    }
     return false;
 }
@@ -37,6 +37,10 @@
 
 #include <QMainWindow>
 #include <QSharedMemory>
+#ifndef MOBILE
+#include <QLocalServer>
+#include <QLocalSocket>
+#endif
 #include <QTableWidget>
 #include <QScrollBar>
 #include <QFile>
@@ -62,6 +66,8 @@
     int setenv(const char *name, const char *value, int overwrite);
 #endif
 
+class DisplayBenchmark;
+
 #define RingSize 50
 #define BlopSize 4096
     struct _blop {
@@ -104,7 +110,10 @@
                                          const bool &printexit, const bool &moveit, const bool &centerwindow);
      bool isRunning();
      bool sendMessage(const QString &message);
+     void prewarm(const QStringList &files);
+     void startBenchmark(int seconds, const QString &outputFile);
      void fillPVtable(int &countPV, int &countnotConnected, int &countDisplayed);
+     void fillStatisticsTable();
      int ReadInteger(char *string, char **NextString);
      int parseGeometry(const char* string, int* x, int* y, int* width, int* height);
      void parse_and_set_Geometry(QMainWindow *w, QString parsestring);
@@ -233,6 +242,10 @@
      void checkForMessage();
      void onReloadTimeout();
      void Callback_PVwindowExit();
+     void Callback_ActionStatistics();
+     void Callback_StatisticsWindowExit();
+     void Callback_AttachConnection();
+     void Callback_AttachReadyRead();
 
 #if QT_VERSION > 0x050000
      void onApplicationStateChange(Qt::ApplicationState state);
@@ -272,6 +285,11 @@ private:
      void TerminateAllInterfaces();
      void reload(QWidget *w);
      long long getAvailableMemory();
+     void processAttachMessage(const QString &message);
+#ifndef MOBILE
+     bool sendAttachRequest(const QString &serverName, const QString &message);
+     QLocalServer *attachServer;
+#endif
 
      QMainWindow *lastWindow;
      QString lastMacro, lastFile, lastGeometry, lastResizing;
@@ -284,6 +302,11 @@ private:
 
      QMainWindow *pvWindow;
      QTableWidget* pvTable;
+     QMainWindow *statWindow;
+     QTableWidget* statTable;
+     QString statisticsFile;
+     int statisticsInterval;
+     DisplayBenchmark *benchmark;
      QTimer *timer;
 
      bool mustOpenFile;